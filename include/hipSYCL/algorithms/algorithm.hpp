@@ -30,6 +30,8 @@
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
 #include "hipSYCL/algorithms/sort/bitonic_sort.hpp"
+#include "hipSYCL/algorithms/sort/merge_sort.hpp"
+#include "hipSYCL/algorithms/sort/radix_sort.hpp"
 #include "hipSYCL/algorithms/merge/merge.hpp"
 #include "hipSYCL/algorithms/scan/scan.hpp"
 
@@ -1222,6 +1224,9 @@ sycl::event equal(sycl::queue &q,
   });
 }
 
+/// Sorts using bitonic sort, which does not require scratch memory.
+/// Only used if no scratch allocations are passed; the overloads taking
+/// them dispatch to radix or merge sort instead.
 template <class RandomIt, class Compare>
 sycl::event sort(sycl::queue &q, RandomIt first, RandomIt last,
                  Compare comp = std::less<>{},
@@ -1233,6 +1238,68 @@ sycl::event sort(sycl::queue &q, RandomIt first, RandomIt last,
   return sorting::bitonic_sort(q, first, last, comp, deps);
 }
 
+namespace detail {
+
+// Below this size, the fixed number of passes of radix sort
+// does not pay off compared to merge sort.
+constexpr std::size_t radix_sort_min_problem_size = 1 << 16;
+
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event sort_by_key_impl(sycl::queue &q,
+                             util::allocation_group &scratch_allocations,
+                             KeyIt keys_first, KeyIt keys_last,
+                             ValueIt values_first, Compare comp,
+                             const std::vector<sycl::event> &deps) {
+  using KeyT = typename std::iterator_traits<KeyIt>::value_type;
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  if constexpr(sorting::is_radix_sortable<KeyT, Compare>()) {
+    if (problem_size >= radix_sort_min_problem_size &&
+        problem_size <= std::numeric_limits<uint32_t>::max())
+      return sorting::radix_sort(q, scratch_allocations, keys_first, keys_last,
+                                 values_first, comp, deps);
+  }
+  return sorting::merge_sort(q, scratch_allocations, keys_first, keys_last,
+                             values_first, comp, deps);
+}
+
+}
+
+/// Sorts using radix sort for arithmetic types with std::less or std::greater
+/// comparators, and merge sort otherwise. Unlike the overload without
+/// scratch allocations, the runtime is O(n log n) or better for all inputs.
+/// The sort is stable.
+template <class RandomIt, class Compare = std::less<>>
+sycl::event sort(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 RandomIt first, RandomIt last, Compare comp = {},
+                 const std::vector<sycl::event> &deps = {}) {
+  return detail::sort_by_key_impl(q, scratch_allocations, first, last,
+                                  sorting::no_values{}, comp, deps);
+}
+
+template <class RandomIt, class Compare = std::less<>>
+sycl::event stable_sort(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        RandomIt first, RandomIt last, Compare comp = {},
+                        const std::vector<sycl::event> &deps = {}) {
+  return detail::sort_by_key_impl(q, scratch_allocations, first, last,
+                                  sorting::no_values{}, comp, deps);
+}
+
+/// Stably sorts the keys in [keys_first, keys_last), and reorders the
+/// values starting at values_first in the same way.
+template <class KeyIt, class ValueIt, class Compare = std::less<>>
+sycl::event sort_by_key(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                        Compare comp = {},
+                        const std::vector<sycl::event> &deps = {}) {
+  return detail::sort_by_key_impl(q, scratch_allocations, keys_first, keys_last,
+                                  values_first, comp, deps);
+}
+
 template <class ForwardIt>
 sycl::event is_sorted(sycl::queue &q, ForwardIt first, ForwardIt last,
                       detail::early_exit_flag_t* out,
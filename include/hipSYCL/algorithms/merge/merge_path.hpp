@@ -54,6 +54,36 @@ public:
     return (num_diags + segment_chunk_size - 1) / segment_chunk_size;
   }
 
+  /// Finds where the diagonal \c diag_index crosses the merge path of a
+  /// stable merge, i.e. a merge that prefers elements from the first input
+  /// if elements compare equal. Afterwards, the first \c diag_index elements
+  /// of the merged output consist of the first \c array1_pos_out elements
+  /// of input 1 and the first \c array2_pos_out elements of input 2.
+  ///
+  /// In contrast to \c nth_independent_merge_begin(), empty inputs are
+  /// allowed, and any diagonal in [0, size1 + size2] may be queried.
+  template <class RandomIt1, class RandomIt2, class Compare, class Size>
+  static void stable_diag_split(RandomIt1 first1, Size size1,
+                                RandomIt2 first2, Size size2, Compare comp,
+                                Size diag_index, Size &array1_pos_out,
+                                Size &array2_pos_out) {
+    Size low = diag_index > size2 ? diag_index - size2 : Size{0};
+    Size high = diag_index < size1 ? diag_index : size1;
+
+    // Find the first position in input 1 whose element comes after
+    // the element of input 2 on the other side of the diagonal.
+    while(low < high) {
+      Size i = low + (high - low) / 2;
+      if(comp(load(first2, diag_index - i - 1), load(first1, i)))
+        high = i;
+      else
+        low = i + 1;
+    }
+
+    array1_pos_out = low;
+    array2_pos_out = diag_index - low;
+  }
+
 private:
   template<class ForwardIt, class Size>
   static auto load(ForwardIt first, Size idx) {
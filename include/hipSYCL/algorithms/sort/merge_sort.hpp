@@ -0,0 +1,339 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_MERGE_SORT
+#define ACPP_ALGORITHMS_MERGE_SORT
+
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/merge/merge_path.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+/// Used as value iterator type to sort keys only
+struct no_values {};
+
+namespace detail {
+
+template<class It, class Size>
+auto load(It first, Size i) {
+  std::advance(first, i);
+  return *first;
+}
+
+template<class It, class Size, class T>
+void store(It first, Size i, const T& v) {
+  std::advance(first, i);
+  *first = v;
+}
+
+template <class ValueIt>
+constexpr bool has_values() {
+  return !std::is_same_v<ValueIt, no_values>;
+}
+
+/// Type of the values, or no_values if only keys are sorted
+template <class ValueIt> struct value_type {
+  using type = typename std::iterator_traits<ValueIt>::value_type;
+};
+
+template <> struct value_type<no_values> { using type = no_values; };
+
+/// Stable insertion sort of the keys (and associated values) in [begin, end)
+template <class KeyIt, class ValueIt, class Compare>
+void insertion_sort(KeyIt keys, ValueIt values, std::size_t begin,
+                    std::size_t end, Compare comp) {
+  for(std::size_t i = begin + 1; i < end; ++i) {
+    auto key = load(keys, i);
+    std::size_t j = i;
+    if constexpr(has_values<ValueIt>()) {
+      auto value = load(values, i);
+      for(; j > begin && comp(key, load(keys, j - 1)); --j) {
+        store(keys, j, load(keys, j - 1));
+        store(values, j, load(values, j - 1));
+      }
+      store(values, j, value);
+    } else {
+      for(; j > begin && comp(key, load(keys, j - 1)); --j)
+        store(keys, j, load(keys, j - 1));
+    }
+    store(keys, j, key);
+  }
+}
+
+/// Produces the output elements [out_begin, out_begin + chunk_size) of
+/// a merge pass in which pairs of sorted runs of length \c run_size
+/// are merged stably.
+template <class KeyIt1, class ValueIt1, class KeyIt2, class ValueIt2,
+          class Compare>
+void merge_runs_chunk(KeyIt1 src_keys, ValueIt1 src_values, KeyIt2 dst_keys,
+                      ValueIt2 dst_values, std::size_t problem_size,
+                      std::size_t run_size, std::size_t out_begin,
+                      std::size_t chunk_size, Compare comp) {
+  std::size_t pair_begin = out_begin - out_begin % (2 * run_size);
+  std::size_t size1 = std::min(run_size, problem_size - pair_begin);
+  std::size_t begin2 = pair_begin + size1;
+  std::size_t size2 = std::min(run_size, problem_size - begin2);
+
+  auto first1 = src_keys;
+  auto first2 = src_keys;
+  std::advance(first1, pair_begin);
+  std::advance(first2, begin2);
+
+  std::size_t diag_begin = out_begin - pair_begin;
+  std::size_t diag_end = std::min(diag_begin + chunk_size, size1 + size2);
+
+  std::size_t i = 0, j = 0, i_end = 0, j_end = 0;
+  merging::merge_path::stable_diag_split(first1, size1, first2, size2, comp,
+                                         diag_begin, i, j);
+  merging::merge_path::stable_diag_split(first1, size1, first2, size2, comp,
+                                         diag_end, i_end, j_end);
+
+  std::size_t out = out_begin;
+  auto take = [&](std::size_t src_pos) {
+    store(dst_keys, out, load(src_keys, src_pos));
+    if constexpr(has_values<ValueIt1>())
+      store(dst_values, out, load(src_values, src_pos));
+    ++out;
+  };
+
+  while(i < i_end && j < j_end) {
+    // Prefer elements from the first run if equal to retain stability
+    if(comp(load(first2, j), load(first1, i))) {
+      take(begin2 + j);
+      ++j;
+    } else {
+      take(pair_begin + i);
+      ++i;
+    }
+  }
+  for(; i < i_end; ++i)
+    take(pair_begin + i);
+  for(; j < j_end; ++j)
+    take(begin2 + j);
+}
+
+inline std::size_t select_merge_sort_block_size(sycl::queue& q) {
+  if(q.get_device().get_backend() == sycl::backend::omp)
+    return 64;
+  return 16;
+}
+
+/// Number of work items of the work groups that sort tiles of the input
+/// in local memory before the global merge passes, or 0 if blocks are
+/// only sorted by independent work items. The latter is the case on the
+/// host, where work groups gain nothing from local memory.
+template <class KeyT, class ValueT>
+std::size_t select_merge_sort_group_size(sycl::queue &q,
+                                         std::size_t block_size) {
+  if constexpr (!std::is_trivially_copyable_v<KeyT> ||
+                !std::is_trivially_copyable_v<ValueT>) {
+    return 0;
+  } else {
+    if(q.get_device().get_backend() == sycl::backend::omp)
+      return 0;
+
+    std::size_t max_group_size =
+        q.get_device().get_info<sycl::info::device::max_work_group_size>();
+    std::size_t local_mem_size =
+        q.get_device().get_info<sycl::info::device::local_mem_size>();
+    // Tiles are ping-ponged between two buffers. Use at most half of the
+    // local memory, so that multiple work groups can be resident.
+    for(std::size_t group_size = 128; group_size >= 32; group_size /= 2) {
+      std::size_t tile_size = group_size * block_size;
+      if(group_size <= max_group_size &&
+         2 * tile_size * (sizeof(KeyT) + sizeof(ValueT)) <= local_mem_size / 2)
+        return group_size;
+    }
+    return 0;
+  }
+}
+
+} // detail
+
+/// Stable merge sort. Blocks of the input are first sorted with insertion
+/// sort, and then merged in log2(problem_size/block_size) passes. Each merge
+/// pass is decomposed into independent chunks using the merge path.
+///
+/// On devices, work groups first sort tiles of many blocks in local memory,
+/// merging the blocks of a tile cooperatively in the same way. Only runs
+/// longer than a tile are merged in global memory.
+///
+/// If \c ValueIt is not \c no_values, the values are reordered alongside their
+/// keys.
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event merge_sort(sycl::queue &q, util::allocation_group &scratch,
+                       KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                       Compare comp,
+                       const std::vector<sycl::event> &deps = {}) {
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  using KeyT = typename std::iterator_traits<KeyIt>::value_type;
+  constexpr bool has_values = detail::has_values<ValueIt>();
+
+  // Merge chunks must not cross run boundaries, so
+  // the chunk size must divide the block size.
+  std::size_t block_size = detail::select_merge_sort_block_size(q);
+  std::size_t chunk_size = block_size;
+
+  sycl::event most_recent_event;
+  bool is_first_kernel = true;
+  auto launch = [&](std::size_t range, auto kernel) {
+    if(is_first_kernel || q.is_in_order())
+      most_recent_event = q.parallel_for(sycl::range{range}, deps, kernel);
+    else
+      most_recent_event =
+          q.parallel_for(sycl::range{range}, most_recent_event, kernel);
+    is_first_kernel = false;
+  };
+
+  using LocalValueT = typename detail::value_type<ValueIt>::type;
+  std::size_t group_size =
+      detail::select_merge_sort_group_size<KeyT, LocalValueT>(q, block_size);
+  // Length of the sorted runs after the first kernel
+  std::size_t run_size = block_size;
+
+  if(group_size > 0) {
+    std::size_t tile_size = group_size * block_size;
+    std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+    std::vector<sycl::event> kernel_deps = deps;
+    most_recent_event = q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(kernel_deps);
+      sycl::local_accessor<KeyT, 1> local_keys{2 * tile_size, cgh};
+      sycl::local_accessor<LocalValueT, 1> local_values{
+          has_values ? 2 * tile_size : 1, cgh};
+
+      cgh.parallel_for(
+          sycl::nd_range<1>{num_tiles * group_size, group_size},
+          [=](sycl::nd_item<1> idx) {
+            std::size_t lid = idx.get_local_linear_id();
+            std::size_t tile_begin = idx.get_group_linear_id() * tile_size;
+            std::size_t n = std::min(tile_size, problem_size - tile_begin);
+
+            KeyT *keys[2] = {&(local_keys[0]), &(local_keys[0]) + tile_size};
+            LocalValueT *values[2] = {&(local_values[0]),
+                                      &(local_values[0]) + tile_size};
+            auto get_values = [&](int buffer) {
+              if constexpr (has_values)
+                return values[buffer];
+              else
+                return no_values{};
+            };
+
+            for(std::size_t i = lid; i < n; i += group_size) {
+              keys[0][i] = detail::load(keys_first, tile_begin + i);
+              if constexpr(has_values)
+                values[0][i] = detail::load(values_first, tile_begin + i);
+            }
+            sycl::group_barrier(idx.get_group());
+
+            std::size_t block_begin = lid * block_size;
+            if(block_begin < n)
+              detail::insertion_sort(keys[0], get_values(0), block_begin,
+                                     std::min(block_begin + block_size, n),
+                                     comp);
+            sycl::group_barrier(idx.get_group());
+
+            // n is uniform across the work group, so all work items
+            // reach the barriers.
+            int current = 0;
+            for(std::size_t run = block_size; run < n; run *= 2) {
+              if(block_begin < n)
+                detail::merge_runs_chunk(keys[current], get_values(current),
+                                         keys[1 - current],
+                                         get_values(1 - current), n, run,
+                                         block_begin, block_size, comp);
+              current = 1 - current;
+              sycl::group_barrier(idx.get_group());
+            }
+
+            for(std::size_t i = lid; i < n; i += group_size) {
+              detail::store(keys_first, tile_begin + i, keys[current][i]);
+              if constexpr(has_values)
+                detail::store(values_first, tile_begin + i, values[current][i]);
+            }
+          });
+    });
+    is_first_kernel = false;
+    run_size = tile_size;
+  } else {
+    std::size_t num_blocks = (problem_size + block_size - 1) / block_size;
+    launch(num_blocks, [=](sycl::id<1> idx) {
+      std::size_t begin = idx.get(0) * block_size;
+      std::size_t end = std::min(begin + block_size, problem_size);
+      detail::insertion_sort(keys_first, values_first, begin, end, comp);
+    });
+  }
+
+  if(problem_size <= run_size)
+    return most_recent_event;
+
+  KeyT* scratch_keys = scratch.obtain<KeyT>(problem_size);
+  auto* scratch_values = [&]() {
+    if constexpr(has_values) {
+      using ValueT = typename std::iterator_traits<ValueIt>::value_type;
+      return scratch.obtain<ValueT>(problem_size);
+    } else {
+      return static_cast<no_values*>(nullptr);
+    }
+  }();
+  auto get_scratch_values = [=]() {
+    if constexpr (has_values)
+      return scratch_values;
+    else
+      return no_values{};
+  };
+
+  std::size_t num_chunks = (problem_size + chunk_size - 1) / chunk_size;
+  auto launch_merge_pass = [&](auto src_keys, auto src_values, auto dst_keys,
+                               auto dst_values, std::size_t run_size) {
+    launch(num_chunks, [=](sycl::id<1> idx) {
+      detail::merge_runs_chunk(src_keys, src_values, dst_keys, dst_values,
+                               problem_size, run_size, idx.get(0) * chunk_size,
+                               chunk_size, comp);
+    });
+  };
+
+  bool is_result_in_scratch = false;
+  for(; run_size < problem_size; run_size *= 2) {
+    if(is_result_in_scratch)
+      launch_merge_pass(scratch_keys, get_scratch_values(), keys_first,
+                        values_first, run_size);
+    else
+      launch_merge_pass(keys_first, values_first, scratch_keys,
+                        get_scratch_values(), run_size);
+    is_result_in_scratch = !is_result_in_scratch;
+  }
+
+  if(is_result_in_scratch) {
+    auto values = get_scratch_values();
+    launch(problem_size, [=](sycl::id<1> idx) {
+      detail::store(keys_first, idx.get(0), scratch_keys[idx.get(0)]);
+      if constexpr(has_values)
+        detail::store(values_first, idx.get(0), values[idx.get(0)]);
+    });
+  }
+
+  return most_recent_event;
+}
+
+}
+
+#endif
@@ -0,0 +1,372 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_RADIX_SORT
+#define ACPP_ALGORITHMS_RADIX_SORT
+
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_ref.hpp"
+#include "hipSYCL/sycl/libkernel/bit_cast.hpp"
+#include "hipSYCL/sycl/libkernel/builtins.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/scan/scan.hpp"
+#include "merge_sort.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace detail {
+
+template<std::size_t Size>
+struct radix_bits {};
+
+template<> struct radix_bits<1> { using type = uint8_t; };
+template<> struct radix_bits<2> { using type = uint16_t; };
+template<> struct radix_bits<4> { using type = uint32_t; };
+template<> struct radix_bits<8> { using type = uint64_t; };
+
+template<class T>
+using radix_bits_t = typename radix_bits<sizeof(T)>::type;
+
+template <class T, class Compare> struct radix_order {
+  static constexpr bool is_supported = false;
+  static constexpr bool is_descending = false;
+};
+
+#define ACPP_ALGORITHMS_DECLARE_RADIX_ORDER(Comparator, Descending)            \
+  template <class T> struct radix_order<T, Comparator> {                       \
+    static constexpr bool is_supported = true;                                 \
+    static constexpr bool is_descending = Descending;                          \
+  };
+
+ACPP_ALGORITHMS_DECLARE_RADIX_ORDER(std::less<>, false)
+ACPP_ALGORITHMS_DECLARE_RADIX_ORDER(std::less<T>, false)
+ACPP_ALGORITHMS_DECLARE_RADIX_ORDER(std::greater<>, true)
+ACPP_ALGORITHMS_DECLARE_RADIX_ORDER(std::greater<T>, true)
+
+#undef ACPP_ALGORITHMS_DECLARE_RADIX_ORDER
+
+/// Maps a key to an unsigned integer such that the order of the
+/// integers corresponds to the order of the keys as defined by \c Compare.
+template <class Compare, class T>
+radix_bits_t<T> to_radix_bits(T key) {
+  using bits_t = radix_bits_t<T>;
+  constexpr bits_t sign_bit = bits_t{1} << (sizeof(bits_t) * 8 - 1);
+
+  bits_t bits;
+  if constexpr(std::is_floating_point_v<T>) {
+    // -0.0 and 0.0 compare equal, so they must be mapped to
+    // the same value.
+    if(key == T{0})
+      key = T{0};
+    bits = sycl::bit_cast<bits_t>(key);
+    bits = (bits & sign_bit) ? static_cast<bits_t>(~bits)
+                             : static_cast<bits_t>(bits | sign_bit);
+  } else if constexpr(std::is_signed_v<T>) {
+    bits = static_cast<bits_t>(static_cast<bits_t>(key) ^ sign_bit);
+  } else {
+    bits = static_cast<bits_t>(key);
+  }
+
+  if constexpr(radix_order<T, Compare>::is_descending)
+    bits = static_cast<bits_t>(~bits);
+  return bits;
+}
+
+// Digits of 8 bits, so that the histograms of a work group
+// fit into local memory.
+constexpr int radix_digit_bits = 8;
+constexpr std::size_t radix_num_buckets = std::size_t{1} << radix_digit_bits;
+
+// Work-group size of the cooperative kernels; each work item
+// owns one bucket of the work-group histogram.
+constexpr std::size_t radix_sort_group_size = radix_num_buckets;
+constexpr std::size_t radix_sort_items_per_work_item = 16;
+// Words of the bit masks that record which work items hold a digit
+constexpr std::size_t radix_sort_mask_words = radix_sort_group_size / 32;
+
+// On the host, each work item sorts a tile serially, which avoids the
+// barriers that work-group cooperation would require there.
+inline bool use_cooperative_radix_sort(sycl::queue& q) {
+  if(q.get_device().get_backend() == sycl::backend::omp)
+    return false;
+  return q.get_device().get_info<sycl::info::device::max_work_group_size>() >=
+         radix_sort_group_size;
+}
+
+inline std::size_t select_radix_sort_tile_size(sycl::queue& q) {
+  if(use_cooperative_radix_sort(q))
+    return radix_sort_group_size * radix_sort_items_per_work_item;
+  return 1024;
+}
+
+} // detail
+
+/// Whether \c radix_sort() can sort keys of type \c T ordered by \c Compare.
+template <class T, class Compare>
+constexpr bool is_radix_sortable() {
+  return std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+         (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+          sizeof(T) == 8) &&
+         detail::radix_order<T, Compare>::is_supported;
+}
+
+/// Stable LSD radix sort for arithmetic keys ordered by \c std::less
+/// or \c std::greater. Each pass processes one 8-bit digit in three steps:
+/// 1. The digits of each tile of the input are counted.
+/// 2. An exclusive scan over the counts, ordered by digit and then by tile,
+///    yields the output position of the first element of each digit in
+///    each tile.
+/// 3. The elements of each tile are scattered in order.
+///
+/// On devices, a work group processes each tile cooperatively: Counts are
+/// accumulated in local memory, and the scatter step ranks the elements
+/// of a tile in rounds of one element per work item, using bit masks in
+/// local memory that record which work items hold each digit. On the host,
+/// each work item processes a tile serially.
+///
+/// If the number of passes is odd, the result is copied back from scratch
+/// memory at the end. The problem size must not exceed the range of
+/// \c uint32_t.
+///
+/// If \c ValueIt is not \c no_values, the values are reordered alongside their
+/// keys.
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event radix_sort(sycl::queue &q, util::allocation_group &scratch,
+                       KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                       Compare comp,
+                       const std::vector<sycl::event> &deps = {}) {
+  using KeyT = typename std::iterator_traits<KeyIt>::value_type;
+  static_assert(is_radix_sortable<KeyT, Compare>(),
+                "Key type or comparator not supported by radix sort");
+  constexpr bool has_values = detail::has_values<ValueIt>();
+  constexpr int radix_bits = detail::radix_digit_bits;
+  constexpr std::size_t num_buckets = detail::radix_num_buckets;
+  constexpr int num_passes = sizeof(KeyT) * 8 / radix_bits;
+
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size <= 1)
+    return sycl::event{};
+
+  const bool is_cooperative = detail::use_cooperative_radix_sort(q);
+  std::size_t tile_size = detail::select_radix_sort_tile_size(q);
+  std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+  std::size_t num_counts = num_buckets * num_tiles;
+
+  KeyT* scratch_keys = scratch.obtain<KeyT>(problem_size);
+  auto* scratch_values = [&]() {
+    if constexpr(has_values) {
+      using ValueT = typename std::iterator_traits<ValueIt>::value_type;
+      return scratch.obtain<ValueT>(problem_size);
+    } else {
+      return static_cast<no_values*>(nullptr);
+    }
+  }();
+  auto get_scratch_values = [=]() {
+    if constexpr (has_values)
+      return scratch_values;
+    else
+      return no_values{};
+  };
+  uint32_t* counts = scratch.obtain<uint32_t>(num_counts);
+  uint32_t* offsets = scratch.obtain<uint32_t>(num_counts);
+
+  sycl::event most_recent_event;
+  bool is_first_kernel = true;
+  auto get_deps = [&]() -> std::vector<sycl::event> {
+    if(is_first_kernel || q.is_in_order())
+      return deps;
+    return {most_recent_event};
+  };
+  auto launch = [&](std::size_t range, auto kernel) {
+    most_recent_event = q.parallel_for(sycl::range{range}, get_deps(), kernel);
+    is_first_kernel = false;
+  };
+
+  // Launches a cooperative kernel with one work group per tile, and
+  // the given number of local memory words
+  auto launch_cooperative = [&](std::size_t num_local_words, auto kernel) {
+    constexpr std::size_t group_size = detail::radix_sort_group_size;
+    std::vector<sycl::event> kernel_deps = get_deps();
+    most_recent_event = q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(kernel_deps);
+      sycl::local_accessor<uint32_t, 1> local_mem{num_local_words, cgh};
+      cgh.parallel_for(
+          sycl::nd_range<1>{num_tiles * group_size, group_size},
+          [=](sycl::nd_item<1> idx) { kernel(idx, &(local_mem[0])); });
+    });
+    is_first_kernel = false;
+  };
+
+  auto launch_pass = [&](auto src_keys, auto src_values, auto dst_keys,
+                         auto dst_values, int shift) {
+    auto get_digit = [=](KeyT key) -> std::size_t {
+      return (detail::to_radix_bits<Compare>(key) >> shift) &
+             (num_buckets - 1);
+    };
+
+    if(is_cooperative) {
+      constexpr std::size_t group_size = detail::radix_sort_group_size;
+      constexpr std::size_t mask_words = detail::radix_sort_mask_words;
+      using local_atomic_ref =
+          sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                           sycl::memory_scope::work_group,
+                           sycl::access::address_space::local_space>;
+
+      launch_cooperative(num_buckets, [=](sycl::nd_item<1> idx,
+                                          uint32_t *histogram) {
+        std::size_t lid = idx.get_local_linear_id();
+        std::size_t tile = idx.get_group_linear_id();
+        histogram[lid] = 0;
+        sycl::group_barrier(idx.get_group());
+
+        for(std::size_t i = tile * tile_size + lid;
+            i < std::min((tile + 1) * tile_size, problem_size);
+            i += group_size)
+          local_atomic_ref{histogram[get_digit(detail::load(src_keys, i))]}
+              .fetch_add(1);
+
+        sycl::group_barrier(idx.get_group());
+        counts[lid * num_tiles + tile] = histogram[lid];
+      });
+
+      most_recent_event = scanning::scan<false>(
+          q, scratch, counts, counts + num_counts, offsets, std::plus<>{},
+          uint32_t{0}, get_deps());
+
+      launch_cooperative(
+          num_buckets * (1 + mask_words),
+          [=](sycl::nd_item<1> idx, uint32_t *local_mem) {
+            std::size_t lid = idx.get_local_linear_id();
+            std::size_t tile = idx.get_group_linear_id();
+            // Output position of the next element of each digit
+            uint32_t *next_pos = local_mem;
+            // For each digit, the work items that hold it in this round
+            uint32_t *masks = local_mem + num_buckets;
+
+            next_pos[lid] = offsets[lid * num_tiles + tile];
+            for(std::size_t w = 0; w < mask_words; ++w)
+              masks[lid * mask_words + w] = 0;
+            sycl::group_barrier(idx.get_group());
+
+            const std::size_t word = lid / 32;
+            const uint32_t bit = uint32_t{1} << (lid % 32);
+            // The number of rounds is uniform across the work group,
+            // so that all work items reach the barriers.
+            for(std::size_t round_begin = tile * tile_size;
+                round_begin < std::min((tile + 1) * tile_size, problem_size);
+                round_begin += group_size) {
+              std::size_t i = round_begin + lid;
+              bool is_valid = i < problem_size;
+              KeyT key{};
+              std::size_t digit = 0;
+              if(is_valid) {
+                key = detail::load(src_keys, i);
+                digit = get_digit(key);
+                local_atomic_ref{masks[digit * mask_words + word]}.fetch_or(
+                    bit);
+              }
+              sycl::group_barrier(idx.get_group());
+
+              if(is_valid) {
+                // Elements of the same digit in preceding work items
+                // precede this one in the output
+                const uint32_t *digit_masks = masks + digit * mask_words;
+                uint32_t rank = sycl::popcount(digit_masks[word] & (bit - 1));
+                for(std::size_t w = 0; w < word; ++w)
+                  rank += sycl::popcount(digit_masks[w]);
+
+                uint32_t pos = next_pos[digit] + rank;
+                detail::store(dst_keys, pos, key);
+                if constexpr(has_values)
+                  detail::store(dst_values, pos, detail::load(src_values, i));
+              }
+              sycl::group_barrier(idx.get_group());
+
+              uint32_t num_elements = 0;
+              for(std::size_t w = 0; w < mask_words; ++w) {
+                num_elements += sycl::popcount(masks[lid * mask_words + w]);
+                masks[lid * mask_words + w] = 0;
+              }
+              next_pos[lid] += num_elements;
+              sycl::group_barrier(idx.get_group());
+            }
+          });
+      return;
+    }
+
+    launch(num_tiles, [=](sycl::id<1> idx) {
+      std::size_t tile = idx.get(0);
+      std::size_t begin = tile * tile_size;
+      std::size_t end = std::min(begin + tile_size, problem_size);
+
+      uint32_t local_counts[num_buckets] = {};
+      for(std::size_t i = begin; i < end; ++i)
+        ++local_counts[get_digit(detail::load(src_keys, i))];
+      for(std::size_t b = 0; b < num_buckets; ++b)
+        counts[b * num_tiles + tile] = local_counts[b];
+    });
+
+    most_recent_event =
+        scanning::scan<false>(q, scratch, counts, counts + num_counts, offsets,
+                              std::plus<>{}, uint32_t{0}, get_deps());
+
+    launch(num_tiles, [=](sycl::id<1> idx) {
+      std::size_t tile = idx.get(0);
+      std::size_t begin = tile * tile_size;
+      std::size_t end = std::min(begin + tile_size, problem_size);
+
+      uint32_t local_offsets[num_buckets];
+      for(std::size_t b = 0; b < num_buckets; ++b)
+        local_offsets[b] = offsets[b * num_tiles + tile];
+      for(std::size_t i = begin; i < end; ++i) {
+        auto key = detail::load(src_keys, i);
+        uint32_t pos = local_offsets[get_digit(key)]++;
+        detail::store(dst_keys, pos, key);
+        if constexpr(has_values)
+          detail::store(dst_values, pos, detail::load(src_values, i));
+      }
+    });
+  };
+
+  for(int pass = 0; pass < num_passes; ++pass) {
+    int shift = pass * radix_bits;
+    if(pass % 2 == 0)
+      launch_pass(keys_first, values_first, scratch_keys, get_scratch_values(),
+                  shift);
+    else
+      launch_pass(scratch_keys, get_scratch_values(), keys_first, values_first,
+                  shift);
+  }
+
+  if(num_passes % 2 != 0) {
+    auto values = get_scratch_values();
+    launch(problem_size, [=](sycl::id<1> idx) {
+      detail::store(keys_first, idx.get(0), scratch_keys[idx.get(0)]);
+      if constexpr(has_values)
+        detail::store(values_first, idx.get(0), values[idx.get(0)]);
+    });
+  }
+
+  return most_recent_event;
+}
+
+}
+
+#endif
@@ -81,11 +81,13 @@ struct kernel_entry {
 };
 
 struct binary_entry {
-  std::string jit_cache_filename;
+  // content_version of the appdb when the binary was last used; determines
+  // which binaries are evicted first from the persistent kernel cache.
+  uint64_t last_used = 0;
 
   template<class T>
   void pack(T &pack) {
-    pack(jit_cache_filename);
+    pack(last_used);
   }
 
   ACPP_COMMON_EXPORT void dump(std::ostream& ostr, int indentation_level=0) const;
@@ -102,8 +104,25 @@ struct scheduling_object_entry {
   ACPP_COMMON_EXPORT void dump(std::ostream& ostr, int indentation_level=0) const;
 };
 
+// Measured properties of data transfers between two devices
+struct transfer_link_entry {
+  uint64_t latency_ns = 0;
+  uint64_t bytes_per_sec = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(latency_ns);
+    pack(bytes_per_sec);
+  }
+
+  ACPP_COMMON_EXPORT void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
 struct appdb_data {
   std::size_t content_version = 0;
+  // Id of the journal whose records are already contained in this data;
+  // see appdb.
+  uint64_t compacted_journal_id = 0;
 
   std::unordered_map<rt::kernel_configuration::id_type, kernel_entry,
                      rt::kernel_id_hash>
@@ -114,28 +133,43 @@ struct appdb_data {
   std::unordered_map<rt::kernel_configuration::id_type, scheduling_object_entry,
                      rt::kernel_id_hash>
       scheduling_objects;
+  // Indexed by "<source device>-><destination device>"
+  std::unordered_map<std::string, transfer_link_entry> transfer_links;
 
   template<class T>
   void pack(T &pack) {
     pack(kernels);
     pack(binaries);
     pack(scheduling_objects);
+    pack(transfer_links);
     pack(content_version);
+    pack(compacted_journal_id);
   }
 
   ACPP_COMMON_EXPORT void dump(std::ostream& ostr, int indentation_level=0) const;
 };
 
 
+/// The app db is shared by all processes running the same application,
+/// which may run concurrently (e.g. MPI ranks). It consists of a snapshot
+/// file at db_path and an append-only journal next to it. On destruction,
+/// a process appends the changes it has made relative to the state that it
+/// has loaded to the journal instead of overwriting the snapshot, so that
+/// no process loses the statistics gathered by another. Journal records
+/// are merged into the snapshot once the journal has grown large enough.
+/// All file accesses are serialized using a lock file.
 class ACPP_COMMON_EXPORT appdb  {
 public:
   // DO NOT FORGET TO INCREMENT THIS WHEN ADDING/REMOVING
   // FIELDS OR OTHERWISE CHANGING THE DATA LAYOUT!
-  static const uint64_t format_version = 5;
+  static const uint64_t format_version = 8;
 
   appdb(const std::string& db_path);
   ~appdb();
 
+  /// Removes the app db at the given path including its journal.
+  static bool clear(const std::string& db_path);
+
   template<class F>
   auto read_access(F&& handler) const{
     read_lock lock {_lock};
@@ -195,6 +229,8 @@ private:
   std::string _db_path;
 
   appdb_data _data;
+  // State as loaded from disk, used to determine the changes of this process
+  appdb_data _loaded_data;
 };
 
 
@@ -56,6 +56,30 @@ ACPP_COMMON_EXPORT bool atomic_write(const std::string& filename, const std::str
 /// Removes a file, returns true if successful.
 ACPP_COMMON_EXPORT bool remove(const std::string &filename);
 
+/// Exclusive lock on a file that is shared between processes. The file
+/// is created if it does not exist. The constructor blocks until the lock
+/// is acquired; the lock is released on destruction.
+class ACPP_COMMON_EXPORT file_lock {
+public:
+  file_lock(const std::string& filename);
+  ~file_lock();
+
+  file_lock(const file_lock&) = delete;
+  file_lock& operator=(const file_lock&) = delete;
+
+  /// False if the lock file could not be opened or locked
+  bool is_locked() const {
+    return _is_locked;
+  }
+private:
+#ifndef _WIN32
+  int _fd = -1;
+#else
+  void* _handle = nullptr;
+#endif
+  bool _is_locked = false;
+};
+
 class ACPP_COMMON_EXPORT persistent_storage {
 public:
   static persistent_storage& get();
@@ -12,9 +12,15 @@
 #define HIPSYCL_HCF_CONTAINER_HPP
 
 #include "debug.hpp"
+#include <charconv>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <sstream>
@@ -34,6 +40,10 @@ public:
     std::string node_id;
 
     const node* get_subnode(const std::string& name) const {
+      if(is_index_valid(_subnode_index, _num_indexed_subnodes, subnodes.size())) {
+        auto it = _subnode_index.find(name);
+        return it != _subnode_index.end() ? &(subnodes[it->second]) : nullptr;
+      }
       for(int i = 0; i < subnodes.size(); ++i) {
         if(subnodes[i].node_id == name)
           return &(subnodes[i]);
@@ -42,14 +52,15 @@ public:
     }
 
     node* get_subnode(const std::string& name) {
-      for(int i = 0; i < subnodes.size(); ++i) {
-        if(subnodes[i].node_id == name)
-          return &(subnodes[i]);
-      }
-      return nullptr;
+      return const_cast<node*>(static_cast<const node*>(this)->get_subnode(name));
     }
 
     const std::string* get_value(const std::string& key) const {
+      if(is_index_valid(_value_index, _num_indexed_values, key_value_pairs.size())) {
+        auto it = _value_index.find(key);
+        return it != _value_index.end() ? &(key_value_pairs[it->second].second)
+                                        : nullptr;
+      }
       for(int i = 0; i < key_value_pairs.size(); ++i) {
         if(key_value_pairs[i].first == key) {
           return &(key_value_pairs[i].second);
@@ -68,6 +79,7 @@ public:
 
     std::vector<std::string> get_subnodes() const {
       std::vector<std::string> result;
+      result.reserve(subnodes.size());
       for(const auto& s : subnodes) {
         result.push_back(s.node_id);
       }
@@ -83,22 +95,22 @@ public:
     }
 
     node* add_subnode(const std::string& unique_name) {
-      for(int i = 0; i < subnodes.size(); ++i) {
-        if(subnodes[i].node_id == unique_name) {
-          HIPSYCL_DEBUG_ERROR << "hcf: Subnode already exists with name "
-                              << unique_name << "\n";
-          return nullptr;
-        }
+      if(has_subnode(unique_name)) {
+        HIPSYCL_DEBUG_ERROR << "hcf: Subnode already exists with name "
+                            << unique_name << "\n";
+        return nullptr;
       }
 
       node new_node;
       new_node.node_id = unique_name;
-      subnodes.push_back(new_node);
+      subnodes.push_back(std::move(new_node));
+      update_subnode_index();
       return &subnodes.back();
     }
 
     void set(const std::string& key, const std::string& value) {
       key_value_pairs.push_back(std::make_pair(key, value));
+      update_value_index();
     }
 
     // Note: This is a convenience feature. It just creates additional subnodes for list entries.
@@ -119,24 +131,90 @@ public:
         return {};
       return get_subnode(key)->get_subnodes();
     }
+
+    // (Re)builds the lookup indices of this node and all its subnodes.
+    // This is only required if key_value_pairs or subnodes were
+    // modified directly; lookups fall back to linear search otherwise.
+    // Lookups never modify the indices, so that nodes can be
+    // queried concurrently.
+    void build_index() {
+      _num_indexed_subnodes = 0;
+      _num_indexed_values = 0;
+      _subnode_index.clear();
+      _value_index.clear();
+      update_subnode_index();
+      update_value_index();
+      for(auto& s : subnodes)
+        s.build_index();
+    }
+  private:
+    // Nodes with few entries are searched linearly, which is
+    // faster than hashing and saves memory.
+    static constexpr std::size_t index_threshold = 8;
+
+    using index_t = std::unordered_map<std::string, std::size_t>;
+
+    static bool is_index_valid(const index_t &index, std::size_t num_indexed,
+                               std::size_t num_entries) {
+      return !index.empty() && num_indexed == num_entries;
+    }
+
+    // Entries are indexed incrementally; in case of duplicate names,
+    // the first entry wins, consistent with linear search.
+    template<class Container, class KeyGetter>
+    static void update_index(const Container &entries, index_t &index,
+                             std::size_t &num_indexed, KeyGetter &&get_key) {
+      if(entries.size() < index_threshold)
+        return;
+      if(!is_index_valid(index, num_indexed, entries.size() - 1)) {
+        index.clear();
+        num_indexed = 0;
+      }
+      for(; num_indexed < entries.size(); ++num_indexed)
+        index.emplace(get_key(entries[num_indexed]), num_indexed);
+    }
+
+    void update_subnode_index() {
+      update_index(subnodes, _subnode_index, _num_indexed_subnodes,
+                   [](const node &n) -> const std::string & { return n.node_id; });
+    }
+
+    void update_value_index() {
+      update_index(key_value_pairs, _value_index, _num_indexed_values,
+                   [](const std::pair<std::string, std::string> &kv)
+                       -> const std::string & { return kv.first; });
+    }
+
+    index_t _subnode_index;
+    index_t _value_index;
+    std::size_t _num_indexed_subnodes = 0;
+    std::size_t _num_indexed_values = 0;
   };
 
   hcf_container() {
     _root_node.node_id = "root";
   }
 
+  // Parses an HCF container in either binary or text format.
+  // Binary attachments are copied into the container. If the input
+  // is malformed, the container is empty.
   hcf_container(const std::string& container) {
-    std::string appendix_id {_binary_appendix_id};
-
-    std::size_t appendix_begin = container.find(appendix_id);
-    if(appendix_begin != std::string::npos) {
-      _binary_appendix = container.substr(appendix_begin + appendix_id.length());
-    }
-
-    std::string parseable_data = container;
-    parseable_data.erase(appendix_begin);
+    auto data = std::make_shared<std::string>(container);
+    if(load(*data))
+      _owned_appendix = std::move(data);
+    else
+      _binary_appendix = std::string_view{};
+  }
 
-    parse(parseable_data);
+  // Creates a container that references binary attachments directly in \c data
+  // instead of copying them. \c data must remain valid for the lifetime of the
+  // returned container and all copies of it, e.g. because it is embedded
+  // in the executable.
+  static hcf_container create_non_owning(const char* data, std::size_t size) {
+    hcf_container result;
+    if(!result.load(std::string_view{data, size}))
+      result._binary_appendix = std::string_view{};
+    return result;
   }
 
   const node* root_node() const {
@@ -147,10 +225,9 @@ public:
     return &_root_node;
   }
 
-  bool get_binary_attachment(const node* n, std::string& out) const {
-    std::size_t start = 0;
-    std::size_t size = 0;
-
+  // Provides a view of the binary attachment. The view remains valid
+  // as long as this container is alive and no binary content is attached.
+  bool get_binary_attachment(const node* n, std::string_view& out) const {
     if(!n)
       return false;
 
@@ -180,10 +257,15 @@ public:
       return false;
     }
 
-    start = std::stoull(*start_entry);
-    size = std::stoull(*size_entry);
+    std::size_t start = 0;
+    std::size_t size = 0;
+    if(!parse_size(*start_entry, start) || !parse_size(*size_entry, size)) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Invalid binary content address\n";
+      return false;
+    }
 
-    if(start + size > _binary_appendix.size()) {
+    if(start > _binary_appendix.size() ||
+       size > _binary_appendix.size() - start) {
       HIPSYCL_DEBUG_ERROR << "hcf: Binary content address is out-of-bounds\n";
       return false;
     }
@@ -193,6 +275,14 @@ public:
     return true;
   }
 
+  bool get_binary_attachment(const node* n, std::string& out) const {
+    std::string_view data;
+    if(!get_binary_attachment(n, data))
+      return false;
+    out = std::string{data};
+    return true;
+  }
+
   bool attach_binary_content(node* n, const std::string& binary_content) {
     
     node* binary_node = n->add_subnode(_binary_marker);
@@ -202,7 +292,15 @@ public:
     std::size_t start = _binary_appendix.size();
     std::size_t length = binary_content.size();
 
-    _binary_appendix += binary_content;
+    // The appendix might be shared with copies of this container,
+    // or reference external data; in this case, detach first.
+    if (!_owned_appendix || _owned_appendix.use_count() != 1 ||
+        _owned_appendix->data() != _binary_appendix.data() ||
+        _owned_appendix->size() != _binary_appendix.size()) {
+      _owned_appendix = std::make_shared<std::string>(_binary_appendix);
+    }
+    *_owned_appendix += binary_content;
+    _binary_appendix = *_owned_appendix;
 
     binary_node->set("start", std::to_string(start));
     binary_node->set("size", std::to_string(length));
@@ -210,14 +308,171 @@ public:
     return true;
   }
 
+  // Serializes to the binary format
   std::string serialize() const {
+    std::string result{_binary_format_magic, sizeof(_binary_format_magic) - 1};
+    write_int<uint32_t>(result, _binary_format_version);
+    serialize_node_binary(_root_node, result);
+    write_int<uint64_t>(result, _binary_appendix.size());
+    result.append(_binary_appendix.data(), _binary_appendix.size());
+    return result;
+  }
+
+  // Serializes to the legacy, human-readable text format
+  std::string serialize_text() const {
     std::stringstream sstr;
     serialize_node(_root_node, sstr);
     sstr << _binary_appendix_id;
 
-    return sstr.str() + _binary_appendix;
+    return sstr.str() + std::string{_binary_appendix};
   }
 private:
+  // Binary format, all integers are little endian:
+  //   magic, u32 version, root node, u64 appendix size, appendix
+  // where a node is encoded as
+  //   u32 #key-value pairs, (string key, string value)...,
+  //   u32 #subnodes, (string node id, node)...
+  // and a string as u32 length followed by the characters.
+  template<class Int>
+  static void write_int(std::string& out, Int value) {
+    for(std::size_t i = 0; i < sizeof(Int); ++i)
+      out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+
+  static void write_string(std::string& out, const std::string& str) {
+    write_int<uint32_t>(out, static_cast<uint32_t>(str.size()));
+    out += str;
+  }
+
+  void serialize_node_binary(const node& n, std::string& out) const {
+    write_int<uint32_t>(out, static_cast<uint32_t>(n.key_value_pairs.size()));
+    for(const auto& p : n.key_value_pairs) {
+      write_string(out, p.first);
+      write_string(out, p.second);
+    }
+    write_int<uint32_t>(out, static_cast<uint32_t>(n.subnodes.size()));
+    for(const auto& s : n.subnodes) {
+      write_string(out, s.node_id);
+      serialize_node_binary(s, out);
+    }
+  }
+
+  class binary_reader {
+  public:
+    binary_reader(std::string_view data)
+    : _data{data}, _pos{0} {}
+
+    template<class Int>
+    bool read_int(Int& out) {
+      if(_data.size() - _pos < sizeof(Int))
+        return false;
+      out = 0;
+      for(std::size_t i = 0; i < sizeof(Int); ++i)
+        out |= static_cast<Int>(static_cast<unsigned char>(_data[_pos + i]))
+               << (8 * i);
+      _pos += sizeof(Int);
+      return true;
+    }
+
+    bool read_view(std::size_t size, std::string_view& out) {
+      if(_data.size() - _pos < size)
+        return false;
+      out = _data.substr(_pos, size);
+      _pos += size;
+      return true;
+    }
+
+    bool read_string(std::string& out) {
+      uint32_t size = 0;
+      std::string_view str;
+      if(!read_int(size) || !read_view(size, str))
+        return false;
+      out.assign(str.data(), str.size());
+      return true;
+    }
+
+    std::size_t remaining() const {
+      return _data.size() - _pos;
+    }
+  private:
+    std::string_view _data;
+    std::size_t _pos;
+  };
+
+  bool parse_node_binary(binary_reader& reader, node& current_node) const {
+    uint32_t num_values = 0;
+    // Each key-value pair occupies at least two string lengths
+    if(!reader.read_int(num_values) ||
+       num_values > reader.remaining() / (2 * sizeof(uint32_t)))
+      return false;
+    current_node.key_value_pairs.resize(num_values);
+    for(auto& kv : current_node.key_value_pairs) {
+      if(!reader.read_string(kv.first) || !reader.read_string(kv.second))
+        return false;
+    }
+
+    uint32_t num_subnodes = 0;
+    // Each subnode occupies at least its id length and two entry counts
+    if(!reader.read_int(num_subnodes) ||
+       num_subnodes > reader.remaining() / (3 * sizeof(uint32_t)))
+      return false;
+    current_node.subnodes.resize(num_subnodes);
+    for(auto& s : current_node.subnodes) {
+      if(!reader.read_string(s.node_id) || !parse_node_binary(reader, s))
+        return false;
+    }
+    return true;
+  }
+
+  bool parse_binary(std::string_view data) {
+    binary_reader reader{data.substr(sizeof(_binary_format_magic) - 1)};
+
+    uint32_t version = 0;
+    if(!reader.read_int(version) || version > _binary_format_version) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Unsupported binary format version\n";
+      return false;
+    }
+    _root_node.node_id = "root";
+    uint64_t appendix_size = 0;
+    if (!parse_node_binary(reader, _root_node) ||
+        !reader.read_int(appendix_size) ||
+        !reader.read_view(appendix_size, _binary_appendix)) {
+      HIPSYCL_DEBUG_ERROR << "hcf: Binary container is truncated or corrupted\n";
+      return false;
+    }
+    return true;
+  }
+
+  // Parses the container and points the binary appendix into data.
+  bool load(std::string_view data) {
+    bool success = false;
+    std::string_view magic{_binary_format_magic, sizeof(_binary_format_magic) - 1};
+    if(data.substr(0, magic.size()) == magic) {
+      success = parse_binary(data);
+    } else {
+      std::string_view appendix_id {_binary_appendix_id};
+
+      std::size_t appendix_begin = data.find(appendix_id);
+      if(appendix_begin != std::string_view::npos) {
+        _binary_appendix = data.substr(appendix_begin + appendix_id.length());
+      }
+
+      success = parse(std::string{data.substr(0, appendix_begin)});
+    }
+    // Do not expose partially parsed nodes
+    if(!success) {
+      _root_node = node{};
+      _root_node.node_id = "root";
+    }
+    _root_node.build_index();
+    return success;
+  }
+
+  static bool parse_size(const std::string& str, std::size_t& out) {
+    const char* end = str.data() + str.size();
+    auto result = std::from_chars(str.data(), end, out);
+    return result.ec == std::errc{} && result.ptr == end;
+  }
 
   void serialize_node(const node& n, std::ostream& out) const {
     for(const auto& p : n.key_value_pairs){
@@ -348,9 +603,14 @@ private:
   static constexpr char _node_start_id [] = "{.";
   static constexpr char _node_end_id [] = "}.";
   static constexpr char _binary_marker [] = "__binary";
+  static constexpr char _binary_format_magic [] = "ACPPHCFB";
+  static constexpr uint32_t _binary_format_version = 1;
 
   node _root_node;
-  std::string _binary_appendix;
+  // Either references the data the container was loaded from,
+  // or the owned appendix.
+  std::string_view _binary_appendix;
+  std::shared_ptr<std::string> _owned_appendix;
 };
 
 }
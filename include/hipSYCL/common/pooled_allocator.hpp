@@ -0,0 +1,187 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_COMMON_POOLED_ALLOCATOR_HPP
+#define HIPSYCL_COMMON_POOLED_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+#include "spin_lock.hpp"
+
+namespace hipsycl {
+namespace common {
+
+/// Recycles memory blocks of a fixed size. Freed blocks are cached
+/// per thread; threads exchange blocks in batches with a global free list,
+/// such that blocks freed by one thread can be reused by another one.
+/// Memory is never returned to the system.
+template<std::size_t BlockSize>
+class block_pool {
+public:
+  static void* allocate() {
+    return get_thread_cache().pop();
+  }
+
+  static void deallocate(void* ptr) {
+    get_thread_cache().push(static_cast<free_block *>(ptr));
+  }
+private:
+  struct free_block {
+    free_block* next;
+    // Only used by the first block of a batch in the global list
+    free_block* next_batch;
+    std::size_t batch_length;
+  };
+
+  static constexpr std::size_t block_size =
+      BlockSize > sizeof(free_block) ? BlockSize : sizeof(free_block);
+  static constexpr std::size_t batch_size = 64;
+
+  struct global_list {
+    spin_lock lock;
+    free_block* batches = nullptr;
+
+    void push_batch(free_block* batch, std::size_t length) {
+      batch->batch_length = length;
+      spin_lock_guard guard{lock};
+      batch->next_batch = batches;
+      batches = batch;
+    }
+
+    free_block* pop_batch() {
+      spin_lock_guard guard{lock};
+      free_block* batch = batches;
+      if(batch)
+        batches = batch->next_batch;
+      return batch;
+    }
+  };
+
+  static global_list& get_global_list() {
+    // Intentionally leaked: Blocks might still be freed
+    // during static destruction.
+    static global_list* l = new global_list{};
+    return *l;
+  }
+
+  // Trivially destructible, so that it remains usable while other
+  // thread-local or static objects are destroyed.
+  struct thread_cache {
+    free_block* head;
+    std::size_t num_blocks;
+    // Set once the thread has returned its cached blocks;
+    // blocks are then exchanged with the global list directly.
+    bool is_detached;
+
+    void* pop() {
+      if(!head) {
+        head = get_global_list().pop_batch();
+        num_blocks = head ? head->batch_length : 0;
+      }
+      if(!head)
+        return ::operator new(block_size);
+
+      free_block* b = head;
+      head = b->next;
+      --num_blocks;
+
+      if(is_detached)
+        flush();
+      return b;
+    }
+
+    void push(free_block* b) {
+      b->next = head;
+      head = b;
+      ++num_blocks;
+
+      if(is_detached) {
+        flush();
+      } else if(num_blocks >= 2 * batch_size) {
+        // Hand the oldest blocks over to other threads
+        free_block* last_retained = head;
+        for(std::size_t i = 1; i < batch_size; ++i)
+          last_retained = last_retained->next;
+        free_block* batch = last_retained->next;
+        last_retained->next = nullptr;
+        get_global_list().push_batch(batch, num_blocks - batch_size);
+        num_blocks = batch_size;
+      }
+    }
+
+    void flush() {
+      if(head)
+        get_global_list().push_batch(head, num_blocks);
+      head = nullptr;
+      num_blocks = 0;
+    }
+  };
+
+  struct thread_cache_release {
+    ~thread_cache_release() {
+      thread_cache& c = get_thread_cache();
+      c.flush();
+      c.is_detached = true;
+    }
+  };
+
+  static thread_cache& get_thread_cache() {
+    static thread_local thread_cache c{nullptr, 0, false};
+    static thread_local thread_cache_release r;
+    return c;
+  }
+};
+
+/// Allocator serving single-object allocations from a block_pool.
+/// This is in particular useful with std::allocate_shared(), which
+/// allocates object and reference counts in a single block.
+template<class T>
+class pooled_allocator {
+public:
+  using value_type = T;
+
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "pooled_allocator does not support over-aligned types");
+
+  pooled_allocator() noexcept = default;
+  template<class U>
+  pooled_allocator(const pooled_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    if(n != 1)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    return static_cast<T *>(block_pool<sizeof(T)>::allocate());
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    if(n != 1)
+      ::operator delete(ptr);
+    else
+      block_pool<sizeof(T)>::deallocate(ptr);
+  }
+
+  template<class U>
+  friend bool operator==(const pooled_allocator&,
+                         const pooled_allocator<U>&) noexcept {
+    return true;
+  }
+
+  template<class U>
+  friend bool operator!=(const pooled_allocator&,
+                         const pooled_allocator<U>&) noexcept {
+    return false;
+  }
+};
+
+}
+}
+
+#endif
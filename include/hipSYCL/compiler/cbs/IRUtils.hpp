@@ -63,6 +63,8 @@ static constexpr const char SscpDynamicLocalMemoryPtrName[] = "__acpp_cbs_sscp_d
 static constexpr const char SscpInternalLocalMemoryPtrName[] = "__acpp_cbs_sscp_internal_local_memory";
 
 static constexpr const char CbsKernelDimensionName[] = "acpp_cbs_kernel_dimension";
+// Lists SSCP kernels with barriers that not all work items may reach
+static constexpr const char DivergentBarrierKernelsName[] = "acpp.cbs.divergent_barrier_kernels";
 } // namespace cbs
 
 static constexpr const char SscpAnnotationsName[] = "hipsycl.sscp.annotations";
@@ -35,10 +35,15 @@ public:
 class LoopsParallelMarkerPass : public llvm::PassInfoMixin<LoopsParallelMarkerPass> {
 
 public:
-  explicit LoopsParallelMarkerPass() {}
+  // If VectorWidth is non-zero, innermost work-item loops are requested
+  // to be vectorized with exactly this width.
+  explicit LoopsParallelMarkerPass(unsigned VectorWidth = 0) : VectorWidth{VectorWidth} {}
 
   llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
   static bool isRequired() { return false; }
+
+private:
+  unsigned VectorWidth;
 };
 } // namespace compiler
 } // namespace hipsycl
@@ -26,7 +26,9 @@ using OptLevel = llvm::OptimizationLevel;
 // build the CBS pipeline for the legacy PM
 void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM);
 
-// build the CBS pipeline for the new PM
-void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp);
+// build the CBS pipeline for the new PM.
+// WorkItemLoopVectorWidth: if non-zero, the vectorization width to request for work-item loops
+void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp,
+                         unsigned WorkItemLoopVectorWidth = 0);
 } // namespace hipsycl::compiler
 #endif // HIPSYCL_PIPELINEBUILDER_HPP
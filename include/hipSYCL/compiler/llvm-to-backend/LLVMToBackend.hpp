@@ -22,6 +22,7 @@
 // LLVM code into the hipSYCL runtime.
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -129,8 +130,10 @@ public:
     using SymbolsToModuleIdMapperType =
         std::function<std::vector<LLVMModuleId>(const SymbolListType &SymbolList)>;
     // BitcodeStringRetriever will return the IR bitcode string as well as the imported symbols,
-    // given a unique LLVM module id.
-    using BitcodeStringRetrieverType = std::function<std::string (LLVMModuleId, SymbolListType&)>;
+    // given a unique LLVM module id. The translator does not copy the returned bitcode, so the
+    // retriever must keep it valid while the translator is in use.
+    using BitcodeStringRetrieverType =
+        std::function<std::string_view(LLVMModuleId, SymbolListType &)>;
 
     ExternalSymbolResolver() = default;
     ExternalSymbolResolver(const SymbolsToModuleIdMapperType &SymbolMapper,
@@ -177,15 +180,21 @@ protected:
 
   // Link against bitcode contained in file or string. If ForcedTriple/ForcedDataLayout are non-empty,
   // sets triple and data layout in contained bitcode to the provided values.
+  // The bitcode is loaded lazily, so that only the functions that are actually linked
+  // are parsed.
   
   bool linkBitcodeFile(llvm::Module &M, const std::string &BitcodeFile,
                        const std::string &ForcedTriple = "",
                        const std::string &ForcedDataLayout = "",
                        bool LinkOnlyNeeded = true);
-  bool linkBitcodeString(llvm::Module &M, const std::string &Bitcode,
+  bool linkBitcodeString(llvm::Module &M, std::string_view Bitcode,
                          const std::string &ForcedTriple = "",
                          const std::string &ForcedDataLayout = "",
                          bool LinkOnlyNeeded = true);
+  // Returns the content of a bitcode file. Files are read only once per process
+  // and then kept in memory, since the same builtin libraries are linked
+  // by every JIT invocation.
+  bool readBitcodeFile(const std::string &BitcodeFile, std::string_view &Out);
   // If backend needs to set IR constants, it should do so here.
   virtual bool prepareBackendFlavor(llvm::Module& M) = 0;
   // Transform LLVM IR as much as required to backend-specific flavor
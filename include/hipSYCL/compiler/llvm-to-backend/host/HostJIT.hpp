@@ -0,0 +1,43 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_LLVM_TO_HOST_JIT_HPP
+#define HIPSYCL_LLVM_TO_HOST_JIT_HPP
+
+#include <memory>
+#include <string>
+#include "../LLVMToBackend.hpp"
+
+namespace hipsycl {
+namespace compiler {
+
+/// Kernel code that was linked into the running process by the in-process
+/// host JIT. The code is unloaded when this object is destroyed.
+class HostJITDylib {
+public:
+  virtual ~HostJITDylib() = default;
+  /// Returns nullptr if the symbol does not exist
+  virtual void *getSymbol(const std::string &Name) const = 0;
+};
+
+/// Whether \c Image is a relocatable object file as produced by
+/// the in-process LLVMToHost compilation path, as opposed to a
+/// shared library produced by invoking the external linker.
+ACPP_BACKEND_API_EXPORT bool isHostRelocatableObject(const std::string &Image);
+
+/// Links a relocatable object file into the process.
+/// Returns nullptr and sets \c ErrorOut on failure.
+ACPP_BACKEND_API_EXPORT std::unique_ptr<HostJITDylib>
+loadHostRelocatableObject(const std::string &Image, std::string &ErrorOut);
+
+}
+}
+
+#endif
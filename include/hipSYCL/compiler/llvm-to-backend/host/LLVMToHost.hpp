@@ -28,23 +28,36 @@ enum class host_vector_math_library {
   libmvec = 4
 };
 
+/// Registers the native target with LLVM; safe to call multiple times.
+void initializeHostTarget();
+
 class LLVMToHostTranslator : public LLVMToBackendTranslator{
 public:
   LLVMToHostTranslator(const std::vector<std::string>& KernelNames);
 
   virtual ~LLVMToHostTranslator() {}
 
-  virtual bool prepareBackendFlavor(llvm::Module& M) override {return true;}
+  virtual bool prepareBackendFlavor(llvm::Module& M) override;
   virtual bool toBackendFlavor(llvm::Module &M, PassHandler& PH) override;
   virtual bool translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) override;
 protected:
+  virtual bool applyBuildFlag(const std::string &Flag) override;
   virtual bool applyBuildOption(const std::string &Option, const std::string &Value) override;
   virtual bool isKernelAfterFlavoring(llvm::Function& F) override;
   virtual AddressSpaceMap getAddressSpaceMap() const override;
   virtual void migrateKernelProperties(llvm::Function* From, llvm::Function* To) override;
 private:
+  // Optimizes and compiles the module to a relocatable object within the
+  // current process instead of invoking opt, llc and lld.
+  bool translateInProcess(llvm::Module &FlavoredModule, std::string &out);
+  // Invokes opt, llc and lld to create a shared library
+  bool translateWithExternalTools(llvm::Module &FlavoredModule, std::string &out);
+
   std::vector<std::string> KernelNames;
   host_vector_math_library VectorMathLibary = host_vector_math_library::DEFAULT_VEC_MATH_LIB;
+  // Whether sub-groups should span multiple work items in the vectorized work-item loop
+  bool UseSimdSubgroups = false;
+  int SimdSubgroupSize = 1;
 };
 
 }
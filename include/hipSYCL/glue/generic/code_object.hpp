@@ -32,8 +32,8 @@
   public:                                                                      \
     __acpp_hcf_registration##hcf_obj() {                                       \
       this->_id = ::hipsycl::rt::hcf_cache::get().register_hcf_object(         \
-          ::hipsycl::common::hcf_container{std::string{                        \
-              reinterpret_cast<const char *>(hcf_string), hcf_size}});         \
+          ::hipsycl::common::hcf_container::create_non_owning(                 \
+              reinterpret_cast<const char *>(hcf_string), hcf_size));          \
     }                                                                          \
     ~__acpp_hcf_registration##hcf_obj() {                                      \
       ::hipsycl::rt::hcf_cache::get().unregister_hcf_object(this->_id);        \
@@ -11,6 +11,8 @@
 #ifndef HIPSYCL_ITERATE_RANGE_HPP
 #define HIPSYCL_ITERATE_RANGE_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 
 #include "hipSYCL/sycl/libkernel/range.hpp"
@@ -272,6 +274,179 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
   }
 }
 
+/// Order in which iterate_range_tiled_omp_for visits tiles
+enum class tile_order {
+  row_major,
+  // Groups of neighboring tiles are visited in Morton (Z-curve) order,
+  // so that consecutive tiles - which are typically processed by the
+  // same thread - also neighbor each other in the outer dimensions.
+  morton
+};
+
+// Selects a tile shape such that a tile covers approximately
+// target_num_items items. The innermost dimension is kept long, so that
+// accesses remain contiguous and vectorizable; the remaining items
+// are distributed evenly across the outer dimensions.
+template <int Dim>
+sycl::range<Dim> select_tile_size(const sycl::range<Dim> r,
+                                  std::size_t target_num_items) noexcept {
+  constexpr std::size_t max_inner_extent = 128;
+
+  sycl::range<Dim> tile = r;
+  if constexpr (Dim > 1) {
+    tile[Dim - 1] = std::min(r[Dim - 1], max_inner_extent);
+    std::size_t outer_num_items =
+        std::max(std::size_t{1}, target_num_items / tile[Dim - 1]);
+
+    if constexpr (Dim == 2) {
+      tile[0] = std::clamp(outer_num_items, std::size_t{1}, r[0]);
+    } else {
+      auto extent = static_cast<std::size_t>(
+          std::sqrt(static_cast<double>(outer_num_items)));
+      tile[1] = std::clamp(extent, std::size_t{1}, r[1]);
+      tile[0] = std::clamp(outer_num_items / tile[1], std::size_t{1}, r[0]);
+    }
+  }
+  return tile;
+}
+
+template <int Dim>
+std::size_t get_num_tiles(const sycl::range<Dim> r,
+                          const sycl::range<Dim> tile_size) noexcept {
+  std::size_t num_tiles = 1;
+  for (int i = 0; i < Dim; ++i)
+    num_tiles *= (r[i] + tile_size[i] - 1) / tile_size[i];
+  return num_tiles;
+}
+
+// Distributes the tiles of the range [offset, offset+r) across the
+// threads of the enclosing OpenMP parallel region, and iterates each tile
+// in row-major order. Unlike iterate_range_omp_for, items that are
+// adjacent in outer dimensions are processed close in time, which improves
+// cache reuse of stencil- or transpose-like access patterns.
+template <int Dim, class Function>
+void iterate_range_tiled_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
+                                 sycl::range<Dim> tile_size, tile_order order,
+                                 Function f) noexcept {
+  static_assert(Dim == 2 || Dim == 3,
+                "Tiled iteration is only supported for dimensions 2 and 3");
+
+  sycl::range<Dim> num_tiles;
+  for (int i = 0; i < Dim; ++i)
+    num_tiles[i] = (r[i] + tile_size[i] - 1) / tile_size[i];
+
+  // In Morton order, tiles are grouped into blocks of 64 tiles which are
+  // visited in row-major order. Blocks at the border of the range may
+  // be partially outside of it. Only tiles inside the range are
+  // distributed, such that threads receive similar amounts of work.
+  const bool is_morton = order == tile_order::morton;
+  constexpr int bits_per_dim = (Dim == 2) ? 3 : 2;
+  const std::size_t block_extent = is_morton ? (1u << bits_per_dim) : 1;
+  const std::size_t tiles_per_block =
+      is_morton ? (std::size_t{1} << (bits_per_dim * Dim)) : 1;
+
+  sycl::range<Dim> num_blocks;
+  for (int i = 0; i < Dim; ++i)
+    num_blocks[i] = (num_tiles[i] + block_extent - 1) / block_extent;
+
+  auto get_num_tiles_in_block = [&](std::size_t block) {
+    std::size_t n = 1;
+    for (int i = Dim - 1; i >= 0; --i) {
+      std::size_t first_tile = (block % num_blocks[i]) * block_extent;
+      block /= num_blocks[i];
+      n *= std::min(block_extent, num_tiles[i] - first_tile);
+    }
+    return n;
+  };
+
+  // Returns false if the tile at the given position of the block
+  // is outside of the range.
+  auto get_tile = [&](std::size_t block, std::size_t code,
+                      sycl::id<Dim> &tile_id) {
+    bool is_in_range = true;
+    for (int i = Dim - 1; i >= 0; --i) {
+      std::size_t block_coord = block % num_blocks[i];
+      block /= num_blocks[i];
+
+      // The innermost dimension receives the lowest bit of
+      // each group of interleaved bits.
+      std::size_t coord_in_block = 0;
+      if (is_morton)
+        for (int b = 0; b < bits_per_dim; ++b)
+          coord_in_block |= ((code >> (b * Dim + (Dim - 1 - i))) & 1) << b;
+
+      tile_id[i] = block_coord * block_extent + coord_in_block;
+      if (tile_id[i] >= num_tiles[i])
+        is_in_range = false;
+    }
+    return is_in_range;
+  };
+
+  const std::size_t total_num_tiles = num_tiles.size();
+  // Position of the tile that this thread processes next, if it
+  // continues with the tile following the previous one.
+  std::size_t next_tile = total_num_tiles;
+  std::size_t block = 0;
+  std::size_t code = 0;
+
+#ifdef _OPENMP
+  #pragma omp for schedule(static)
+#endif
+  for (std::size_t tile = 0; tile < total_num_tiles; ++tile) {
+    sycl::id<Dim> tile_id;
+    if (tile == next_tile) {
+      do {
+        if (++code == tiles_per_block) {
+          ++block;
+          code = 0;
+        }
+      } while (!get_tile(block, code, tile_id));
+    } else {
+      // Static scheduling hands each thread a contiguous range of tiles,
+      // so the position only needs to be searched for its first tile.
+      std::size_t remaining = tile;
+      block = 0;
+      if (is_morton) {
+        for (std::size_t n = get_num_tiles_in_block(block); remaining >= n;
+             n = get_num_tiles_in_block(block)) {
+          remaining -= n;
+          ++block;
+        }
+      } else {
+        block = tile;
+        remaining = 0;
+      }
+      for (code = 0;; ++code)
+        if (get_tile(block, code, tile_id) && remaining-- == 0)
+          break;
+    }
+    next_tile = tile + 1;
+
+    sycl::id<Dim> begin;
+    sycl::id<Dim> end;
+    for (int i = 0; i < Dim; ++i) {
+      begin[i] = offset[i] + tile_id[i] * tile_size[i];
+      end[i] = offset[i] + std::min(r[i], (tile_id[i] + 1) * tile_size[i]);
+    }
+
+    if constexpr (Dim == 2) {
+      for (std::size_t i = begin[0]; i < end[0]; ++i) {
+        for (std::size_t j = begin[1]; j < end[1]; ++j) {
+          f(sycl::id<Dim>{i, j});
+        }
+      }
+    } else {
+      for (std::size_t i = begin[0]; i < end[0]; ++i) {
+        for (std::size_t j = begin[1]; j < end[1]; ++j) {
+          for (std::size_t k = begin[2]; k < end[2]; ++k) {
+            f(sycl::id<Dim>{i, j, k});
+          }
+        }
+      }
+    }
+  }
+}
+
 }
 }
 } // namespace hipsycl
@@ -23,10 +23,12 @@
 #include "hipSYCL/runtime/application.hpp"
 #include "jit-reflection/reflection_map.hpp"
 #include <cstddef>
+#include <deque>
 #include <vector>
 #include <atomic>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <algorithm>
 
 namespace hipsycl {
@@ -202,7 +204,8 @@ private:
     return ir_modules_to_link;
   }
 
-  std::string retrieve_bitcode(llvm_module_id id, symbol_list_t& imported_symbols) const {
+  std::string_view retrieve_bitcode(llvm_module_id id,
+                                    symbol_list_t &imported_symbols) {
 
     const auto* hcf_image_node = reinterpret_cast<common::hcf_container::node*>(id);
 
@@ -214,10 +217,20 @@ private:
       return {};
     
     rt::hcf_object_id hcf_id = v->second;
+    // The HCF object might have been unregistered since symbol lookup
+    const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_id);
+    if(!hcf) {
+      HIPSYCL_DEBUG_WARNING << "jit::setup_linking: HCF object " << hcf_id
+                            << " is no longer registered, cannot link image @"
+                            << hcf_image_node << "\n";
+      return {};
+    }
     imported_symbols = hcf_image_node->get_as_list("imported-symbols");
 
-    std::string bitcode;
-    rt::hcf_cache::get().get_hcf(hcf_id)->get_binary_attachment(hcf_image_node, bitcode);
+    // HCF objects can be unregistered at any time, so the bitcode is copied
+    // into storage that lives as long as the translator uses it.
+    std::string& bitcode = _retrieved_bitcode.emplace_back();
+    hcf->get_binary_attachment(hcf_image_node, bitcode);
 
     return bitcode;
   }
@@ -225,6 +238,9 @@ private:
   // This is used to map images to the owning HCF object ids.
   common::small_map<const common::hcf_container::node *, rt::hcf_object_id>
         _image_node_to_hcf_map;
+  // Owns the bitcode handed to the translator. std::deque does not
+  // move its elements when growing, so returned views remain valid.
+  std::deque<std::string> _retrieved_bitcode;
 
 };
 
@@ -12,6 +12,7 @@
 #define HIPSYCL_OPENMP_KERNEL_LAUNCHER_HPP
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
+#include <algorithm>
 #include <cassert>
 #include <tuple>
 #ifdef _OPENMP
@@ -19,9 +20,12 @@
 #endif
 
 #include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
 #include "hipSYCL/runtime/omp/omp_queue.hpp"
 #include "hipSYCL/sycl/libkernel/backend.hpp"
 #include "hipSYCL/sycl/exception.hpp"
@@ -125,12 +129,69 @@ void single_task_kernel(Function f) noexcept
   f();
 }
 
+/// Decides whether a 2D or 3D basic parallel_for over execution_range is
+/// iterated in tiles, and if so, selects tile size and order. Tiles have
+/// the size of preferred_tile_size if it is non-empty, and are otherwise
+/// sized such that the data touched by a tile fits into the L2 cache.
+template <int Dim>
+bool select_parallel_for_tiling(const sycl::range<Dim> execution_range,
+                                const sycl::range<Dim> preferred_tile_size,
+                                sycl::range<Dim> &tile_size,
+                                host::tile_order &order) noexcept {
+  // Kernels are assumed to touch a few words of memory per work item
+  constexpr std::size_t assumed_bytes_per_work_item = 32;
+
+  rt::omp_parallel_for_tiling mode =
+      rt::application::get_settings()
+          .get<rt::setting::omp_parallel_for_tiling>();
+  if (mode == rt::omp_parallel_for_tiling::none ||
+      execution_range.size() == 0)
+    return false;
+
+  order = (mode == rt::omp_parallel_for_tiling::morton)
+              ? host::tile_order::morton
+              : host::tile_order::row_major;
+
+  if (preferred_tile_size.size() != 0) {
+    for (int i = 0; i < Dim; ++i)
+      tile_size[i] = std::clamp(preferred_tile_size[i], std::size_t{1},
+                                execution_range[i]);
+  } else {
+    tile_size = host::select_tile_size(
+        execution_range, rt::get_host_cache_size() / assumed_bytes_per_work_item);
+  }
+  // Tiling only pays off if there are enough tiles to keep all
+  // threads busy; otherwise, distribute individual items.
+  return host::get_num_tiles(execution_range, tile_size) >=
+         4 * static_cast<std::size_t>(get_max_num_threads());
+}
+
 template <int Dim, class Function>
 inline void parallel_for_kernel(Function f,
-                                const sycl::range<Dim> execution_range) noexcept
+                                const sycl::range<Dim> execution_range,
+                                const sycl::range<Dim> preferred_tile_size) noexcept
 {
   static_assert(Dim > 0 && Dim <= 3, "Only dimensions 1,2,3 are supported");
 
+  if constexpr (Dim > 1) {
+    sycl::range<Dim> tile_size;
+    host::tile_order order;
+    if (select_parallel_for_tiling(execution_range, preferred_tile_size,
+                                   tile_size, order)) {
+      parallel_invocation([=](){
+        host::iterate_range_tiled_omp_for(
+            sycl::id<Dim>{}, execution_range, tile_size, order,
+            [&](sycl::id<Dim> idx) {
+              auto this_item =
+                sycl::detail::make_item<Dim>(idx, execution_range);
+
+              f(this_item);
+            });
+      });
+      return;
+    }
+  }
+
   parallel_invocation([=](){
     host::iterate_range_omp_for(execution_range, [&](sycl::id<Dim> idx) {
       auto this_item =
@@ -144,9 +205,28 @@ inline void parallel_for_kernel(Function f,
 template <int Dim, class Function>
 inline void parallel_for_kernel_offset(Function f,
                                        const sycl::range<Dim> execution_range,
-                                       const sycl::id<Dim> offset) noexcept {
+                                       const sycl::id<Dim> offset,
+                                       const sycl::range<Dim> preferred_tile_size) noexcept {
   static_assert(Dim > 0 && Dim <= 3, "Only dimensions 1,2,3 are supported");
 
+  if constexpr (Dim > 1) {
+    sycl::range<Dim> tile_size;
+    host::tile_order order;
+    if (select_parallel_for_tiling(execution_range, preferred_tile_size,
+                                   tile_size, order)) {
+      parallel_invocation([=](){
+        host::iterate_range_tiled_omp_for(
+            offset, execution_range, tile_size, order,
+            [&](sycl::id<Dim> idx) {
+              auto this_item =
+                sycl::detail::make_item<Dim>(idx, execution_range, offset);
+
+              f(this_item);
+            });
+      });
+      return;
+    }
+  }
 
   parallel_invocation([=](){
     host::iterate_range_omp_for(offset, execution_range, [&](sycl::id<Dim> idx) {
@@ -370,9 +450,10 @@ public:
       } else if constexpr (type == rt::kernel_type::basic_parallel_for) {
 
         if(!is_with_offset) {
-          omp_dispatch::parallel_for_kernel(k, global_range);
+          omp_dispatch::parallel_for_kernel(k, global_range, local_range);
         } else {
-          omp_dispatch::parallel_for_kernel_offset(k, global_range, offset);
+          omp_dispatch::parallel_for_kernel_offset(k, global_range, offset,
+                                                   local_range);
         }
 
       } else if constexpr (type == rt::kernel_type::ndrange_parallel_for) {
@@ -11,6 +11,10 @@
 #ifndef HIPSYCL_ADAPTIVITY_ENGINE_HPP
 #define HIPSYCL_ADAPTIVITY_ENGINE_HPP
 
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
@@ -37,6 +41,88 @@ public:
   kernel_configuration::id_type
   finalize_binary_configuration(kernel_configuration &config);
 
+  /// Returns a self-contained JIT compiler for \c config and \c binary_id,
+  /// with signature bool(std::string&) as expected by \c kernel_cache.
+  /// It lowers the kernels selected by \c select_image_and_kernels() using
+  /// the translator returned by \c create_translator, which has signature
+  /// std::unique_ptr<compiler::LLVMToBackendTranslator>(const std::vector<std::string>&).
+  /// Dead argument elimination is applied if \c enable_dead_arg_elimination
+  /// is set and only a single kernel is compiled.
+  template<class TranslatorFactory>
+  auto make_jit_compiler(const kernel_configuration &config,
+                         kernel_configuration::id_type binary_id,
+                         const glue::jit::reflection_map &refl_map,
+                         TranslatorFactory create_translator,
+                         bool enable_dead_arg_elimination = true) {
+    std::vector<std::string> kernel_names;
+    std::string image_name = select_image_and_kernels(&kernel_names);
+    enable_dead_arg_elimination =
+        enable_dead_arg_elimination && kernel_names.size() == 1;
+
+    return [hcf = _hcf, image_name = std::move(image_name),
+            kernel_names = std::move(kernel_names), config, binary_id,
+            refl_map, create_translator,
+            enable_dead_arg_elimination](std::string &compiled_image) -> bool {
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+          create_translator(kernel_names);
+
+      rt::result err = glue::jit::compile_and_store_stats(
+          translator.get(), hcf, image_name, config, binary_id, refl_map,
+          compiled_image, enable_dead_arg_elimination);
+
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      return true;
+    };
+  }
+
+  /// If background compilation of IADS specializations is enabled and
+  /// \c finalize_binary_configuration() has specialized kernel arguments
+  /// for which no binary is available yet, this hands the specialized
+  /// configuration over to the background JIT compiler of \c cache and reverts
+  /// \c config to the configuration without these specializations - provided
+  /// that a binary for the latter already exists.
+  ///
+  /// The background JIT compiler is constructed using \c make_jit_compiler()
+  /// with the remaining arguments.
+  ///
+  /// \return The id of the binary configuration that should be launched.
+  template<class TranslatorFactory>
+  kernel_configuration::id_type
+  defer_specialization(kernel_configuration &config,
+                       kernel_configuration::id_type binary_configuration_id,
+                       kernel_cache &cache,
+                       const glue::jit::reflection_map &refl_map,
+                       TranslatorFactory create_translator,
+                       bool enable_dead_arg_elimination = true) {
+    if(!_unspecialized_config.has_value())
+      return binary_configuration_id;
+    if(cache.is_jit_binary_available(binary_configuration_id))
+      return binary_configuration_id;
+
+    auto unspecialized_id = _unspecialized_config->generate_id();
+    // If we need to JIT anyway, we might as well directly compile the
+    // specialized kernel.
+    if(!cache.is_jit_binary_available(unspecialized_id))
+      return binary_configuration_id;
+
+    if(!cache.is_background_jit_queued(binary_configuration_id)) {
+      HIPSYCL_DEBUG_INFO
+          << "adaptivity_engine: Deferring specialized binary "
+          << kernel_configuration::to_string(binary_configuration_id)
+          << " to background JIT compilation" << std::endl;
+      cache.background_jit_compile(
+          binary_configuration_id,
+          make_jit_compiler(config, binary_configuration_id, refl_map,
+                            create_translator, enable_dead_arg_elimination));
+    }
+
+    config = *_unspecialized_config;
+    return unspecialized_id;
+  }
+
   std::string select_image_and_kernels(std::vector<std::string>* kernel_names_out);
 private:
   hcf_object_id _hcf;
@@ -51,6 +137,10 @@ private:
   std::size_t _local_mem_size;
 
   int _adaptivity_level;
+  bool _is_background_compilation_enabled;
+  // Configuration prior to invariant argument specialization; only set if
+  // background compilation is enabled and arguments were specialized.
+  std::optional<kernel_configuration> _unspecialized_config;
 };
 
 }
@@ -0,0 +1,111 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_RUNTIME_ALLOCATION_POOL_HPP
+#define HIPSYCL_RUNTIME_ALLOCATION_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "allocator.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Caches memory that was freed by users of a backend_allocator, such that
+/// subsequent allocations of similar size can be served without going
+/// through the backend.
+///
+/// * Requested sizes are rounded up to size classes (four per power of two),
+///   and each backend_allocator (i.e. each device) maintains its own free
+///   lists per allocation kind and size class.
+/// * Freed memory can be reused immediately, so reuse is already stream
+///   ordered: All callers of rt::deallocate() free memory only once all DAG
+///   nodes accessing it have completed. data_region lifetime is bound to
+///   the nodes using it, USM memory must not be freed while in use, and
+///   scratch allocations are only released when their owner is destroyed.
+///   Deferring reuse until pending nodes complete would require a free
+///   that is enqueued into the DAG, which the runtime does not have.
+/// * The number of bytes cached per backend_allocator is limited by
+///   ACPP_RT_ALLOCATION_POOL_MAX_CACHED_SIZE. Freed memory that does not
+///   fit is returned to the backend.
+/// * If the backend fails to allocate memory, all memory cached for the
+///   backend_allocator is released and the allocation is retried.
+class allocation_pool {
+public:
+  enum class allocation_kind { device = 0, host = 1, shared = 2 };
+
+  static allocation_pool& get();
+
+  /// Constructs a pool that caches up to \c max_cached_bytes per
+  /// backend_allocator. Most code should use the global pool from \c get()
+  /// instead, which is configured by ACPP_RT_ALLOCATION_POOL_MAX_CACHED_SIZE.
+  explicit allocation_pool(std::size_t max_cached_bytes);
+
+  allocation_pool(const allocation_pool&) = delete;
+  allocation_pool& operator=(const allocation_pool&) = delete;
+  ~allocation_pool();
+
+  /// Returns nullptr if the allocation has failed.
+  void *allocate(backend_allocator *alloc, allocation_kind kind,
+                 std::size_t min_alignment, std::size_t size_bytes,
+                 const allocation_hints &hints);
+  /// Frees memory obtained from \c allocate(). Memory not allocated through
+  /// the pool is passed on to the backend.
+  void free(backend_allocator *alloc, void *mem);
+
+  /// Returns all cached memory of the given allocator to the backend.
+  void release(backend_allocator* alloc);
+  /// Returns all cached memory to the backends, and forgets about
+  /// the allocators. Must be called before backend_allocators are
+  /// destroyed.
+  void release_all();
+
+  std::size_t get_num_cached_bytes(backend_allocator* alloc) const;
+private:
+  allocation_pool();
+
+  struct block_info {
+    std::size_t size_class;
+    allocation_kind kind;
+  };
+
+  struct allocator_state {
+    backend_allocator* allocator;
+
+    mutable std::mutex mutex;
+    // Free lists indexed by size class for each allocation kind
+    std::unordered_map<std::size_t, std::vector<void *>> free_blocks[3];
+    // Memory handed out by the pool that is currently in use
+    std::unordered_map<void*, block_info> used_blocks;
+    std::size_t num_cached_bytes = 0;
+  };
+
+  allocator_state* get_state(backend_allocator* alloc);
+  // Returns nullptr if the allocator is not known to the pool
+  allocator_state* find_state(backend_allocator* alloc) const;
+  // Returns the block to the free lists of the given state if it has been
+  // handed out from there. Returns false if the state does not own it.
+  bool try_free(allocator_state& state, void* mem);
+  // Needs to be called with state.mutex locked
+  void release(allocator_state& state);
+
+  mutable std::mutex _mutex;
+  std::vector<std::unique_ptr<allocator_state>> _allocators;
+  std::size_t _max_cached_bytes;
+};
+
+}
+}
+
+#endif
@@ -11,7 +11,10 @@
 #ifndef HIPSYCL_RUNTIME_BACKEND_HPP
 #define HIPSYCL_RUNTIME_BACKEND_HPP
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -61,30 +64,70 @@ public:
   create_inorder_executor(device_id dev, int priority) = 0;
 };
 
+/// Owns the backends. Except for the CPU backend, which is always needed,
+/// backends are created on first use: \c get() creates only the requested
+/// backend, while \c for_each_backend() creates all remaining backends
+/// in parallel. \c for_each_backend_if() only creates the backends
+/// accepted by its filter.
 class backend_manager
 {
 public:
-  using backend_list_type =
-      std::vector<std::unique_ptr<backend>>;
-
   backend_manager();
   ~backend_manager();
   
   backend* get(backend_id) const;
+  /// Whether the backend has been created. Does not create it.
+  bool is_created(backend_id) const;
   hw_model& hardware_model();
   const hw_model& hardware_model() const;
 
   template<class F>
   void for_each_backend(F f)
   {
-    for(auto& b : _backends){
-      f(b.get());
+    initialize_all_backends();
+    for(auto& slot : _backends){
+      if(slot->instance)
+        f(slot->instance.get());
+    }
+  }
+
+  /// Invokes \c f for each backend for which \c filter returns true
+  /// for its backend_id. Backends of plugins whose backend_id is unknown
+  /// until they are loaded are always created.
+  template<class Filter, class F>
+  void for_each_backend_if(Filter filter, F f)
+  {
+    std::vector<backend_slot*> slots;
+    for(auto& slot : _backends) {
+      if(!slot->id || filter(*slot->id))
+        slots.push_back(slot.get());
+    }
+    initialize(slots);
+    for(backend_slot* slot : slots) {
+      if(slot->instance && filter(slot->instance->get_backend_descriptor().id))
+        f(slot->instance.get());
     }
   }
 
 private:
-  backend_loader _loader;
-  backend_list_type _backends;
+  struct backend_slot {
+    std::size_t loader_index;
+    // Derived from the plugin name; empty for unknown plugins
+    std::optional<backend_id> id;
+    std::once_flag init_flag;
+    std::atomic<bool> is_initialized = false;
+    std::unique_ptr<backend> instance;
+  };
+
+  void initialize(backend_slot& slot) const;
+  // Initializes the slots in parallel
+  void initialize(const std::vector<backend_slot*>& slots) const;
+  void initialize_all_backends() const;
+
+  // Plugins are loaded once their backend is created
+  mutable backend_loader _loader;
+  std::vector<std::unique_ptr<backend_slot>> _backends;
+  mutable std::atomic<bool> _all_backends_initialized;
 
   std::unique_ptr<hw_model> _hw_model;
   std::shared_ptr<kernel_cache> _kernel_cache;
@@ -12,10 +12,13 @@
 #define HIPSYCL_BACKEND_LOADER_HPP
 
 
+#include <optional>
 #include <string>
 #include <vector>
 #include <utility>
 
+#include "device_id.hpp"
+
 namespace hipsycl::rt {
 class backend;
 }
@@ -40,18 +43,32 @@ class backend_loader {
 public:
   ~backend_loader();
 
+  /// Discovers backend plugins. Plugins whose backend name can be
+  /// derived from their file name are not loaded until \c create()
+  /// is called for them.
   void query_backends();
   
   std::size_t get_num_backends() const;
   std::string get_backend_name(std::size_t index) const;
   bool has_backend(const std::string &name) const;
 
-  backend *create(std::size_t index) const;
-  backend *create(const std::string &name) const;
+  /// Loads the plugin if needed and creates its backend. May be called
+  /// concurrently for different indices.
+  backend *create(std::size_t index);
+  backend *create(const std::string &name);
 
+  static std::optional<backend_id>
+  get_backend_id(const std::string &backend_name);
 private:
   using handle_t = void*;
-  std::vector<std::pair<std::string, handle_t>> _handles;
+
+  struct plugin {
+    std::string backend_name;
+    std::string path;
+    // nullptr until the plugin is loaded
+    handle_t handle;
+  };
+  std::vector<plugin> _plugins;
 };
 
 }
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <atomic>
+#include <type_traits>
 
 #include "hints.hpp"
 #include "event.hpp"
@@ -37,9 +38,11 @@ using weak_node_list_t = common::small_vector<std::weak_ptr<dag_node>, 8>;
 class dag_node
 {
 public:
+  /// The operation may be shared with other nodes, e.g. when
+  /// replaying recorded graphs.
   dag_node(const execution_hints& hints,
           const node_list_t& requirements,
-          std::unique_ptr<operation> op,
+          std::shared_ptr<operation> op,
           runtime* rt);
 
   ~dag_node();
@@ -87,6 +90,7 @@ public:
   // Add requirement if not already present
   void add_requirement(dag_node_ptr requirement);
   operation* get_operation() const;
+  std::shared_ptr<operation> get_shared_operation() const;
   const weak_node_list_t& get_requirements() const;
 
   // Wait until the associated event has completed.
@@ -124,7 +128,7 @@ private:
   std::size_t _assigned_execution_index;
 
   std::shared_ptr<dag_node_event> _event;
-  std::unique_ptr<operation> _operation;
+  std::shared_ptr<operation> _operation;
   /// This is a temporary solution to access operations
   /// executed for requirements; we should move to an
   /// API consisting of subnodes to properly handle
@@ -140,6 +144,25 @@ private:
 
 };
 
+/// Creates a dag_node. Nodes and the reference counts of their operations
+/// are allocated from recycled memory, which should be preferred over
+/// std::make_shared() on submission paths.
+dag_node_ptr make_dag_node(const execution_hints &hints,
+                           const node_list_t &requirements,
+                           std::unique_ptr<operation> op, runtime *rt);
+
+dag_node_ptr make_dag_node(const execution_hints &hints,
+                           const node_list_t &requirements,
+                           std::shared_ptr<operation> op, runtime *rt);
+
+template <class Op, std::enable_if_t<!std::is_same_v<Op, operation>, int> = 0>
+dag_node_ptr make_dag_node(const execution_hints &hints,
+                           const node_list_t &requirements,
+                           std::unique_ptr<Op> op, runtime *rt) {
+  return make_dag_node(hints, requirements,
+                       std::unique_ptr<operation>{std::move(op)}, rt);
+}
+
 }
 }
 
@@ -11,7 +11,12 @@
 #ifndef HIPSYCL_DAG_SUBMITTED_OPS_HPP
 #define HIPSYCL_DAG_SUBMITTED_OPS_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "dag_node.hpp"
@@ -21,7 +26,14 @@
 namespace hipsycl {
 namespace rt {
 
-
+/// Keeps track of submitted nodes that might not have completed yet.
+///
+/// Nodes are indexed by the execution lane they were submitted to, and
+/// by their node group. Since execution lanes are in-order queues, a
+/// node completing implies that all nodes submitted to the same lane
+/// before it have completed as well. Waiting for all nodes therefore only
+/// requires waiting for the most recent node of each lane, and
+/// completed nodes can be retired in bulk.
 class dag_submitted_ops
 {
 public:
@@ -40,15 +52,58 @@ public:
 
   ~dag_submitted_ops();
 private:
+  struct lane_ops;
+
+  struct entry {
+    dag_node_ptr node;
+    // Position of the node in the order of registration
+    std::uint64_t submission_id;
+    // Position of the node in its execution lane, as
+    // assigned by the executor
+    std::size_t execution_index;
+    // Shared, since group entries can outlive the lane's registration
+    std::shared_ptr<lane_ops> lane;
+  };
+
+  struct lane_ops {
+    // Nodes in execution order. Nodes are not necessarily registered
+    // in the order in which they were submitted to the lane, e.g.
+    // data transfers are registered after the kernels requiring them.
+    std::deque<entry> ops;
+    // All nodes of the lane up to this execution index have completed.
+    // Only advanced for in-order lanes.
+    std::atomic<std::size_t> completed_index = 0;
+    bool is_in_order = true;
+  };
+
+  static bool is_retired(const entry& e);
+  // The following need to be called with _lock locked
+  void mark_completed(const entry& e);
+  void retire_lane_front(lane_ops& lane);
+  // Retires completed nodes of the lane, and removes the lane if it
+  // no longer contains any nodes. Returns the iterator to the next lane.
+  template<class LaneIterator>
+  LaneIterator retire_lane(LaneIterator it);
+  void retire_group_front(std::deque<entry>& group);
   void purge_known_completed();
-  void copy_node_list(std::vector<dag_node_ptr>& out) const;
 
-  std::vector<dag_node_ptr> _ops;
+  // Keyed by execution lane; nodes without lane are collected under
+  // nullptr and not assumed to complete in order.
+  // Lanes are removed once they are empty: Lane ids are addresses of
+  // in-order queues, which may be reused by a new queue once the executor
+  // owning the queue has been destroyed. The new queue starts counting
+  // execution indices from scratch, so it must not inherit the
+  // completed_index of the old lane. Since nodes keep their executor
+  // alive, a lane is always empty when its queue is destroyed.
+  std::unordered_map<const void*, std::shared_ptr<lane_ops>> _lanes;
+  std::unordered_map<std::size_t, std::deque<entry>> _groups;
+  std::uint64_t _next_submission_id = 1;
+  std::size_t _num_nodes = 0;
+
   mutable std::mutex _lock;
   worker_thread _updater_thread;
 };
 
-
 }
 }
 
@@ -11,6 +11,10 @@
 #ifndef HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 #define HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "dag_node.hpp"
 #include "dag_direct_scheduler.hpp"
 
@@ -19,13 +23,67 @@ namespace rt {
 
 class runtime;
 
+/// Scheduler for DAG nodes that are not bound to a particular device.
+/// Each node is placed on the eligible device that minimizes its estimated
+/// completion time, taking into account
+/// * work that is still outstanding on the device,
+/// * the amount of data that would need to be migrated to the device, and
+/// * runtimes of the same kernel measured on the device, if
+///   instrumentation results are available.
+///
+/// Not thread-safe; the dag_manager serializes submissions.
 class dag_unbound_scheduler {
 public:
   dag_unbound_scheduler(runtime* rt);
 
   void submit(dag_node_ptr node);
+
+  /// Selects the device from \c eligible_devices on which \c node is
+  /// estimated to complete first, and accounts for the node as outstanding
+  /// work there. \c eligible_devices must not be empty.
+  device_id place(const dag_node_ptr& node,
+                  const std::vector<device_id>& eligible_devices);
 private:
-  std::vector<device_id> _devices;
+  struct runtime_estimate {
+    // Exponential moving average of measured runtimes in seconds
+    double average = 0.0;
+    std::size_t num_samples = 0;
+  };
+
+  struct outstanding_node {
+    // Only weakly referenced, so that completed nodes and the kernel
+    // arguments they capture are not kept alive by idle devices.
+    // Nodes that no longer exist are complete.
+    std::weak_ptr<dag_node> node;
+    // Global kernel name, or nullptr for operations other than kernels
+    const char* kernel_name;
+  };
+
+  struct device_state {
+    device_id dev;
+    // Nodes submitted to this device that have not yet been observed
+    // to be complete
+    std::vector<outstanding_node> outstanding_nodes;
+    // Measured runtimes by kernel. Kernel names are static strings,
+    // so they are identified by their address.
+    std::unordered_map<const char*, runtime_estimate> kernel_runtimes;
+  };
+
+  device_state* get_device_state(const device_id& dev);
+  // Removes completed nodes from the outstanding nodes of the device,
+  // and updates kernel runtime statistics from their instrumentations.
+  // Nodes that have been destroyed before are removed without contributing
+  // measurements.
+  void update_device_state(device_state& state);
+  double estimate_runtime(const char* kernel_name,
+                          const device_state& state) const;
+  double estimate_completion_time(const dag_node_ptr& node,
+                                  const device_state& state) const;
+
+  std::vector<device_state> _devices;
+  // Whether _devices contains the devices of all backends,
+  // and not only those that nodes were bound to
+  bool _all_devices_known = false;
   rt::dag_direct_scheduler _direct_scheduler;
   runtime* _rt;
 };
@@ -11,59 +11,279 @@
 #ifndef HIPSYCL_EVENT_POOL_HPP
 #define HIPSYCL_EVENT_POOL_HPP
 
-#include <vector>
-#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
 #include "error.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/spin_lock.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 // BackendEventFactory must satisfy the concept:
-// - define event_type for native backend type
+// - define event_type for native backend type. event_type must be trivially
+//   copyable, and a value-initialized event_type must not be a valid event
+//   (e.g. a null handle).
 // - define method to construct event: result create(event_type&)
 // - define method to destroy event: result destroy(event_type)
+//
+// Events are cached in magazines, of which each thread mostly uses its own,
+// and in a global lock-free depot that magazines exchange events with
+// when they run empty or full. Magazines and depot together hold at most
+// max_size unused events; events that do not fit are destroyed. A max_size
+// of 0 disables pooling.
 template<class BackendEventFactory>
 class event_pool {
 public:
   using event_type = typename BackendEventFactory::event_type;
 
-  event_pool(const BackendEventFactory& event_factory)
-      : _event_factory{event_factory} {}
+  static_assert(std::is_trivially_copyable_v<event_type>,
+                "event_pool: event_type must be trivially copyable");
+
+  struct statistics {
+    // Events obtained from the magazine of the calling thread
+    std::size_t magazine_hits = 0;
+    // Events obtained from the global depot
+    std::size_t depot_hits = 0;
+    // Events that had to be created
+    std::size_t misses = 0;
+    // Returned events that were destroyed because the pool was full
+    std::size_t num_discarded = 0;
+  };
+
+  event_pool(const BackendEventFactory& event_factory,
+             std::size_t max_size = 1024)
+      : _event_factory{event_factory},
+        _num_magazines{get_num_magazines()},
+        _magazines{new magazine[_num_magazines]},
+        _magazine_capacity{get_magazine_capacity(max_size, _num_magazines)},
+        _depot_capacity{max_size - _num_magazines * _magazine_capacity},
+        _depot{new std::atomic<event_type>[_depot_capacity]} {
+    for(std::size_t i = 0; i < _depot_capacity; ++i)
+      _depot[i].store(event_type{}, std::memory_order_relaxed);
+  }
 
   ~event_pool() {
-    for(event_type& evt : _available_events) {
+    auto destroy = [this](event_type evt) {
       auto err = _event_factory.destroy(evt);
       if(!err.is_success()) {
         register_error(err);
       }
+    };
+    for(std::size_t i = 0; i < _num_magazines; ++i)
+      for(std::size_t j = 0; j < _magazines[i].size; ++j)
+        destroy(_magazines[i].events[j]);
+    for(std::size_t i = 0; i < _depot_capacity; ++i) {
+      event_type evt = _depot[i].load(std::memory_order_relaxed);
+      if(evt != event_type{})
+        destroy(evt);
     }
+
+    statistics stats = get_statistics();
+    HIPSYCL_DEBUG_INFO << "event_pool: " << stats.magazine_hits
+                       << " magazine hits, " << stats.depot_hits
+                       << " depot hits, " << stats.misses << " misses, "
+                       << stats.num_discarded << " discarded events"
+                       << std::endl;
   }
 
   // Obtain event from pool. Obtained event
   // must be returned to the pool using release_event()
   // when it is no longer needed.
   result obtain_event(event_type& out) {
-    std::lock_guard<std::mutex> lock {_mutex};
-    if(!_available_events.empty()) {
-      out = _available_events.back();
-      _available_events.pop_back();
-      return make_success();
+    if(_magazine_capacity == 0) {
+      if(pop_from_depot(out)) {
+        _depot_hits.fetch_add(1, std::memory_order_relaxed);
+        return make_success();
+      }
+      _misses.fetch_add(1, std::memory_order_relaxed);
+      return _event_factory.create(out);
+    }
+
+    magazine& m = get_magazine();
+    {
+      common::spin_lock_guard lock{m.lock};
+      if(m.size > 0) {
+        out = m.events[--m.size];
+        _magazine_hits.fetch_add(1, std::memory_order_relaxed);
+        return make_success();
+      }
+      // Refill half of the magazine, so that subsequent releases
+      // do not immediately overflow it.
+      event_type evt;
+      while(m.size < _magazine_capacity / 2 && pop_from_depot(evt))
+        m.events[m.size++] = evt;
+      if(m.size > 0) {
+        out = m.events[--m.size];
+        _depot_hits.fetch_add(1, std::memory_order_relaxed);
+        return make_success();
+      }
     }
+    _misses.fetch_add(1, std::memory_order_relaxed);
     return _event_factory.create(out);
   }
 
   // Return event to pool.
   void release_event(event_type evt) {
-    std::lock_guard<std::mutex> lock {_mutex};
-    _available_events.push_back(evt);
+    if(_magazine_capacity == 0) {
+      if(!push_to_depot(evt))
+        discard(evt);
+      return;
+    }
+
+    // Destroying events can be slow, so this happens after unlocking
+    event_type overflow[max_magazine_capacity / 2];
+    std::size_t num_overflow = 0;
+    {
+      magazine& m = get_magazine();
+      common::spin_lock_guard lock{m.lock};
+      if(m.size == _magazine_capacity) {
+        // Move the older half of the magazine to the depot
+        std::size_t num_moved = _magazine_capacity / 2;
+        for(std::size_t i = 0; i < num_moved; ++i) {
+          if(!push_to_depot(m.events[i]))
+            overflow[num_overflow++] = m.events[i];
+        }
+        std::copy(m.events + num_moved, m.events + m.size, m.events);
+        m.size -= num_moved;
+      }
+      m.events[m.size++] = evt;
+    }
+    for(std::size_t i = 0; i < num_overflow; ++i)
+      discard(overflow[i]);
+  }
+
+  // Creates events ahead of time, such that the next num_events
+  // requests can be served without creating events. This is bounded
+  // by the capacity of the pool.
+  result preallocate(std::size_t num_events) {
+    for(std::size_t i = 0; i < num_events; ++i) {
+      event_type evt;
+      auto err = _event_factory.create(evt);
+      if(!err.is_success())
+        return err;
+      if(!push_to_depot(evt)) {
+        err = _event_factory.destroy(evt);
+        return err;
+      }
+    }
+    return make_success();
+  }
+
+  statistics get_statistics() const {
+    statistics stats;
+    stats.magazine_hits = _magazine_hits.load(std::memory_order_relaxed);
+    stats.depot_hits = _depot_hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.num_discarded = _num_discarded.load(std::memory_order_relaxed);
+    return stats;
   }
 
 private:
+  static constexpr std::size_t max_magazine_capacity = 32;
+
+  struct magazine {
+    common::spin_lock lock;
+    std::size_t size = 0;
+    event_type events[max_magazine_capacity];
+  };
+
+  static std::size_t get_num_magazines() {
+    std::size_t n = std::thread::hardware_concurrency();
+    return std::clamp(n, std::size_t{1}, std::size_t{64});
+  }
+
+  // Threads are assigned to magazines round-robin. Magazines are only
+  // shared if there are more threads than magazines.
+  static std::size_t get_thread_index() {
+    static std::atomic<std::size_t> num_threads = 0;
+    static thread_local std::size_t index =
+        num_threads.fetch_add(1, std::memory_order_relaxed);
+    return index;
+  }
+
+  // Magazines get at most half of the pool, such that events can still
+  // move between threads through the depot. Magazines are bypassed if
+  // they would be too small to be useful.
+  static std::size_t get_magazine_capacity(std::size_t max_size,
+                                           std::size_t num_magazines) {
+    std::size_t capacity =
+        std::min(max_magazine_capacity, max_size / (2 * num_magazines));
+    return capacity < 2 ? 0 : capacity;
+  }
+
+  magazine& get_magazine() {
+    return _magazines[get_thread_index() % _num_magazines];
+  }
+
+  bool push_to_depot(event_type evt) {
+    // Reserve before publishing the event, so that concurrent pops
+    // can never decrement the size below zero.
+    if(_depot_size.fetch_add(1, std::memory_order_relaxed) >= _depot_capacity) {
+      _depot_size.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+    std::size_t start = get_thread_index();
+    for(std::size_t i = 0; i < _depot_capacity; ++i) {
+      auto& slot = _depot[(start + i) % _depot_capacity];
+      event_type expected = event_type{};
+      if(slot.load(std::memory_order_relaxed) == expected &&
+         slot.compare_exchange_strong(expected, evt, std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    _depot_size.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  bool pop_from_depot(event_type& out) {
+    // The size is only a hint, but allows us to avoid scanning
+    // an empty depot.
+    if(_depot_size.load(std::memory_order_relaxed) == 0)
+      return false;
+    std::size_t start = get_thread_index();
+    for(std::size_t i = 0; i < _depot_capacity; ++i) {
+      auto& slot = _depot[(start + i) % _depot_capacity];
+      if(slot.load(std::memory_order_relaxed) == event_type{})
+        continue;
+      event_type evt = slot.exchange(event_type{}, std::memory_order_acquire);
+      if(evt != event_type{}) {
+        _depot_size.fetch_sub(1, std::memory_order_relaxed);
+        out = evt;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void discard(event_type evt) {
+    _num_discarded.fetch_add(1, std::memory_order_relaxed);
+    auto err = _event_factory.destroy(evt);
+    if(!err.is_success()) {
+      register_error(err);
+    }
+  }
+
   BackendEventFactory _event_factory;
-  std::vector<event_type> _available_events;
-  std::mutex _mutex;
-};
 
+  std::size_t _num_magazines;
+  std::unique_ptr<magazine[]> _magazines;
+  std::size_t _magazine_capacity;
+
+  std::size_t _depot_capacity;
+  std::unique_ptr<std::atomic<event_type>[]> _depot;
+  std::atomic<std::size_t> _depot_size = 0;
+
+  std::atomic<std::size_t> _magazine_hits = 0;
+  std::atomic<std::size_t> _depot_hits = 0;
+  std::atomic<std::size_t> _misses = 0;
+  std::atomic<std::size_t> _num_discarded = 0;
+};
 }
 }
 
@@ -14,15 +14,112 @@
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
 #include <functional>
+#include <new>
 #include <queue>
+#include <type_traits>
+#include <utility>
 
+#include "mpsc_queue.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+/// Type-erased, move-only nullary callable. Callables up to
+/// \c inline_storage_size bytes are stored inline, avoiding the heap
+/// allocation that \c std::function would perform for most lambdas.
+class async_task {
+public:
+  static constexpr std::size_t inline_storage_size = 104;
+
+  async_task() = default;
+
+  template <class F, std::enable_if_t<
+                         !std::is_same_v<std::decay_t<F>, async_task>, int> = 0>
+  async_task(F &&f) {
+    using callable = std::decay_t<F>;
+    if constexpr (sizeof(callable) <= inline_storage_size &&
+                  alignof(callable) <= alignof(std::max_align_t) &&
+                  std::is_nothrow_move_constructible_v<callable>) {
+      new (&_storage) callable(std::forward<F>(f));
+      _invoke = [](void *storage) {
+        (*std::launder(reinterpret_cast<callable *>(storage)))();
+      };
+      _manage = [](manage_op op, void *storage, void *other) {
+        auto *obj = std::launder(reinterpret_cast<callable *>(storage));
+        if (op == manage_op::move_to)
+          new (other) callable(std::move(*obj));
+        obj->~callable();
+      };
+    } else {
+      *reinterpret_cast<callable **>(&_storage) =
+          new callable(std::forward<F>(f));
+      _invoke = [](void *storage) {
+        (**reinterpret_cast<callable **>(storage))();
+      };
+      _manage = [](manage_op op, void *storage, void *other) {
+        auto **obj = reinterpret_cast<callable **>(storage);
+        if (op == manage_op::move_to)
+          *reinterpret_cast<callable **>(other) = *obj;
+        else
+          delete *obj;
+      };
+    }
+  }
+
+  async_task(async_task &&other) noexcept { take(other); }
+
+  async_task &operator=(async_task &&other) noexcept {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  async_task(const async_task &) = delete;
+  async_task &operator=(const async_task &) = delete;
+
+  ~async_task() { reset(); }
+
+  void operator()() { _invoke(&_storage); }
+
+  explicit operator bool() const { return _invoke != nullptr; }
+
+  void reset() {
+    if (_manage)
+      _manage(manage_op::destroy, &_storage, nullptr);
+    _invoke = nullptr;
+    _manage = nullptr;
+  }
+private:
+  enum class manage_op { move_to, destroy };
+
+  void take(async_task &other) {
+    if (other._manage)
+      other._manage(manage_op::move_to, &other._storage, &_storage);
+    _invoke = other._invoke;
+    _manage = other._manage;
+    other._invoke = nullptr;
+    other._manage = nullptr;
+  }
+
+  alignas(std::max_align_t) unsigned char _storage[inline_storage_size];
+  void (*_invoke)(void *) = nullptr;
+  // Moves the callable to other storage (destroying the source),
+  // or destroys it.
+  void (*_manage)(manage_op, void *, void *) = nullptr;
+};
+
 /// A worker thread that processes a queue in the background.
+///
+/// Tasks are passed to the worker thread through a lock-free ring buffer.
+/// Only if the ring buffer is full, tasks are added to a mutex-protected
+/// overflow queue. When idle, the worker thread spins for a while before
+/// going to sleep; the spin duration adapts to how often new work
+/// arrives while spinning.
 class worker_thread
 {
 public:
@@ -42,7 +139,10 @@ public:
   /// Enqueues a user-specified function for asynchronous
   /// execution in the worker thread.
   /// \param f The function to enqueue for execution
-  void operator()(async_function f);
+  template<class F>
+  void operator()(F&& f) {
+    enqueue(async_task{std::forward<F>(f)});
+  }
 
   /// \return The number of enqueued operations
   std::size_t queue_size() const;
@@ -50,20 +150,37 @@ public:
   /// Stop the worker thread
   void halt();
 private:
+  static constexpr std::size_t ring_capacity = 256;
+
+  void enqueue(async_task&& f);
 
   /// Starts the worker thread, which will execute the supplied
   /// tasks. If no tasks are available, waits until a new task is
   /// supplied.
   void work();
 
+  bool try_dequeue(async_task& out);
+
   std::thread _worker_thread;
 
   std::atomic<bool> _continue;
 
-  std::condition_variable _condition_wait;
-  mutable std::mutex _mutex;
+  // Number of tasks that have been enqueued but not yet completed
+  std::atomic<std::size_t> _num_pending_operations;
+
+  bounded_mpsc_queue<async_task, ring_capacity> _enqueued_operations;
+
+  // Only used when the ring buffer is full
+  std::atomic<std::size_t> _num_overflow_operations;
+  std::mutex _overflow_mutex;
+  std::queue<async_task> _overflow_operations;
 
-  std::queue<async_function> _enqueued_operations;
+  // Used to put the worker thread and waiting threads to sleep.
+  std::atomic<bool> _is_worker_sleeping;
+  std::atomic<int> _num_sleeping_waiters;
+  std::condition_variable _worker_wakeup;
+  std::condition_variable _waiter_wakeup;
+  std::mutex _sleep_mutex;
 };
 
 }
@@ -0,0 +1,102 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_MPSC_QUEUE_HPP
+#define HIPSYCL_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace hipsycl {
+namespace rt {
+
+/// A bounded, lock-free queue that supports multiple concurrent producers
+/// and a single consumer. Elements are stored in a ring buffer in which each
+/// cell carries a sequence number that indicates whether it is ready to be
+/// written by producers or read by the consumer.
+///
+/// \tparam T Must be default-constructible and move-assignable.
+/// \tparam Capacity Must be a power of two.
+template <class T, std::size_t Capacity> class bounded_mpsc_queue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+public:
+  bounded_mpsc_queue()
+  : _cells{std::make_unique<cell[]>(Capacity)} {
+    for(std::size_t i = 0; i < Capacity; ++i)
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  bounded_mpsc_queue(const bounded_mpsc_queue&) = delete;
+  bounded_mpsc_queue& operator=(const bounded_mpsc_queue&) = delete;
+
+  /// May be called concurrently from multiple threads.
+  /// \return false if the queue is full, in which case \c v is not modified.
+  bool try_push(T &&v) {
+    cell* c = nullptr;
+    std::size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for(;;) {
+      c = &_cells[pos & mask];
+      std::size_t seq = c->sequence.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if(diff == 0) {
+        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed))
+          break;
+      } else if(diff < 0) {
+        return false;
+      } else {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    c->data = std::move(v);
+    c->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Must only be called from the consumer thread.
+  /// \return false if no element is available.
+  bool try_pop(T &out) {
+    cell* c = &_cells[_dequeue_pos & mask];
+    std::size_t seq = c->sequence.load(std::memory_order_acquire);
+    if(seq != _dequeue_pos + 1)
+      return false;
+
+    out = std::move(c->data);
+    // Release resources held by the moved-from element now instead of
+    // when the cell is reused
+    c->data = T{};
+    c->sequence.store(_dequeue_pos + Capacity, std::memory_order_release);
+    ++_dequeue_pos;
+    return true;
+  }
+private:
+  static constexpr std::size_t mask = Capacity - 1;
+  // Avoid false sharing between producers and consumer
+  static constexpr std::size_t cache_line_size = 64;
+
+  struct cell {
+    std::atomic<std::size_t> sequence;
+    T data;
+  };
+
+  std::unique_ptr<cell[]> _cells;
+  alignas(cache_line_size) std::atomic<std::size_t> _enqueue_pos{0};
+  alignas(cache_line_size) std::size_t _dequeue_pos = 0;
+};
+
+}
+}
+
+#endif
@@ -33,18 +33,9 @@ class operation;
 
 namespace hints {
 
-class execution_hint {
-public:
-  void make_present() {
-    _is_present = true;
-  }
-
-  bool is_present() const {
-    return _is_present;
-  }
-private:
-  bool _is_present = false;
-};
+// Whether a hint is present is tracked by execution_hints, so that
+// hints without data do not need any storage.
+class execution_hint {};
 
 class bind_to_device : public execution_hint
 {
@@ -66,14 +57,20 @@ class bind_to_device_group : public execution_hint
 public:
   bind_to_device_group() = default;
   bind_to_device_group(const std::vector<device_id> &devs)
-      : _devs{devs} {
+      : _devs{std::make_shared<const std::vector<device_id>>(devs)} {
   }
 
   const std::vector<device_id>& get_devices() const {
-    return _devs;
+    if(!_devs) {
+      static const std::vector<device_id> no_devices;
+      return no_devices;
+    }
+    return *_devs;
   }
 private:
-  std::vector<device_id> _devs;
+  // Never modified after construction, so that copies of the hint
+  // (e.g. in the hints of each submitted node) can share it.
+  std::shared_ptr<const std::vector<device_id>> _devs;
 };
 
 
@@ -133,40 +130,80 @@ class request_instrumentation_submission_timestamp : public execution_hint {};
 class request_instrumentation_start_timestamp : public execution_hint {};
 class request_instrumentation_finish_timestamp : public execution_hint {};
 
+template<class... Hints>
+struct hint_list {
+  static constexpr std::size_t size = sizeof...(Hints);
+
+  template<class T>
+  static constexpr std::size_t index_of() {
+    constexpr bool is_match[] = {std::is_same_v<T, Hints>...};
+    for(std::size_t i = 0; i < size; ++i)
+      if(is_match[i])
+        return i;
+    return size;
+  }
+};
+
+using all_hints = hint_list<
+    bind_to_device, bind_to_device_group, prefer_execution_lane, node_group,
+    coarse_grained_synchronization, prefer_executor, instant_execution,
+    request_instrumentation_submission_timestamp,
+    request_instrumentation_start_timestamp,
+    request_instrumentation_finish_timestamp>;
+
 } // hints
 
 
+/// Hints are stored compactly: Presence of each hint is a bit in a mask,
+/// and only hints carrying data have storage. Copying hints therefore
+/// never allocates.
 class execution_hints
 {
 public:
   execution_hints() = default;
 
   
-  template <class HintT,
+  template <class Hint,
+            class HintT = std::decay_t<Hint>,
             std::enable_if_t<std::is_base_of_v<hints::execution_hint, HintT>,
                              int> = 0>
-  void set_hint(HintT&& hint) {
-    HintT& entry = get_entry<HintT>();
-    entry = hint;
-    entry.make_present();
+  void set_hint(Hint&& hint) {
+    if constexpr(!std::is_empty_v<HintT>)
+      get_entry<HintT>() = std::forward<Hint>(hint);
+    _present |= get_bit<HintT>();
   }
 
   template <class HintT,
             std::enable_if_t<std::is_base_of_v<hints::execution_hint, HintT>,
                              int> = 0>
   const HintT *get_hint() const {
-    const HintT& entry = get_entry<HintT>();
-    if(entry.is_present())
-      return &entry;
-    return nullptr;
+    if(!has_hint<HintT>())
+      return nullptr;
+    if constexpr(std::is_empty_v<HintT>) {
+      static const HintT instance{};
+      return &instance;
+    } else {
+      return &get_entry<HintT>();
+    }
   }
 
   template <class HintT> bool has_hint() const {
-    const HintT& entry = get_entry<HintT>();
-    return entry.is_present();
+    return (_present & get_bit<HintT>()) != 0;
   }
 
 private:
+  using presence_mask = std::uint32_t;
+
+  template<class T>
+  static constexpr presence_mask get_bit() {
+    constexpr std::size_t index = hints::all_hints::index_of<T>();
+    static_assert(index < hints::all_hints::size,
+                  "Hint type is not registered in hints::all_hints");
+    return presence_mask{1} << index;
+  }
+
+  static_assert(hints::all_hints::size <= sizeof(presence_mask) * 8,
+                "Too many hint types for presence mask");
 
   template<class T>
   T& get_entry();
@@ -174,6 +211,7 @@ private:
   template<class T>
   const T& get_entry() const;
 
+  presence_mask _present = 0;
 
   hints::bind_to_device _bind_to_device;
   hints::bind_to_device_group _bind_to_device_group;
@@ -182,18 +220,7 @@ private:
   
   hints::node_group _node_group;
   
-  hints::coarse_grained_synchronization _coarse_grained_synchronization;
-  
   hints::prefer_executor _prefer_executor;
-
-  hints::request_instrumentation_submission_timestamp
-      _request_instrumentation_submission_timestamp;
-  hints::request_instrumentation_start_timestamp
-      _request_instrumentation_start_timestamp;
-  hints::request_instrumentation_finish_timestamp
-      _request_instrumentation_finish_timestamp;
-
-  hints::instant_execution _instant_execution;
 };
 
 #define HIPSYCL_RT_HINTS_MAP_GETTER(name, member)                              \
@@ -209,17 +236,7 @@ HIPSYCL_RT_HINTS_MAP_GETTER(bind_to_device, _bind_to_device);
 HIPSYCL_RT_HINTS_MAP_GETTER(bind_to_device_group, _bind_to_device_group);
 HIPSYCL_RT_HINTS_MAP_GETTER(prefer_execution_lane, _prefer_execution_lane);
 HIPSYCL_RT_HINTS_MAP_GETTER(node_group, _node_group);
-HIPSYCL_RT_HINTS_MAP_GETTER(coarse_grained_synchronization,
-                            _coarse_grained_synchronization);
 HIPSYCL_RT_HINTS_MAP_GETTER(prefer_executor, _prefer_executor);
-HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_submission_timestamp,
-                            _request_instrumentation_submission_timestamp);
-HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_start_timestamp,
-                            _request_instrumentation_start_timestamp);
-HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_finish_timestamp,
-                            _request_instrumentation_finish_timestamp);
-HIPSYCL_RT_HINTS_MAP_GETTER(instant_execution,
-                            _instant_execution);
 
 struct allocation_hints {
   std::optional<const std::vector<size_t>> AdaptiveCpp_target_numa_node;
@@ -12,6 +12,10 @@
 #define HIPSYCL_MEMCPY_HPP
 
 #include <vector>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "../operations.hpp"
 #include "../util.hpp"
 
@@ -19,11 +23,19 @@ namespace hipsycl {
 namespace rt {
 
 class backend_manager;
+class runtime;
 
+/// Models data transfers between devices. Costs are estimated
+/// runtimes in seconds, based on the latency and bandwidth of the link
+/// between two devices. These are either estimated from the types of the
+/// devices, or measured and stored in the app db if calibration is enabled
+/// (see ACPP_RT_MEMCPY_CALIBRATION).
+///
+/// This class is thread-safe.
 class memcpy_model
 {
 public:
-  memcpy_model(backend_manager* mgr){}
+  memcpy_model(backend_manager* mgr);
 
   cost_type estimate_runtime_cost(const memory_location &source,
                                   const memory_location &dest,
@@ -33,8 +45,56 @@ public:
   choose_source(const std::vector<memory_location> &candidate_sources,
                 const memory_location &target, range<3> num_elements) const;
 
-};
+  /// Whether backends cannot copy directly from source to dest, such that
+  /// data has to be staged through host memory.
+  bool requires_host_staging(device_id source, device_id dest) const;
+
+  struct transfer_part {
+    std::size_t source_index;
+    id<3> offset;
+    range<3> extent;
+  };
+
+  /// Distributes the transfer of a region to target across the candidate
+  /// sources, each of which holds the entire region, such that the
+  /// estimated time until all parts have completed is minimal.
+  /// Parts are split along the outermost dimension of the region.
+  /// Links that have not yet been measured are calibrated first if enabled,
+  /// which requires submitting transfers using rt.
+  std::vector<transfer_part>
+  split_transfer(runtime *rt, const std::vector<device_id> &candidate_sources,
+                 device_id target, id<3> offset, range<3> extent,
+                 std::size_t element_size);
 
+private:
+  struct link_properties {
+    // in seconds
+    double latency;
+    // in bytes per second
+    double bandwidth;
+  };
+
+  static link_properties get_default_link(device_id source, device_id dest);
+  // Requires _mutex to be locked
+  bool lookup_link(const std::string &link_id, link_properties &out) const;
+  link_properties get_link(device_id source, device_id dest) const;
+  double estimate_transfer_time(device_id source, device_id dest,
+                                std::size_t num_bytes) const;
+  void ensure_calibrated(runtime *rt, device_id source, device_id dest);
+  bool measure_link(runtime *rt, device_id source, device_id dest,
+                    link_properties &out) const;
+
+  backend_manager* _backends;
+  mutable std::mutex _mutex;
+  // Contains measured links. Links that were measured by a previous
+  // application run are loaded lazily from the app db.
+  mutable std::unordered_map<std::string, link_properties> _links;
+  // Links that are known to have no entry in the app db, such that cost
+  // estimates do not need to access the app db again.
+  mutable std::unordered_set<std::string> _unknown_links;
+  // Links that are currently being measured by some thread
+  std::unordered_set<std::string> _links_in_calibration;
+};
 
 }
 }
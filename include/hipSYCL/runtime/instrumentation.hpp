@@ -142,6 +142,15 @@ public:
   virtual ~execution_finish_timestamp() = default;
 };
 
+/// Achieved bandwidth of a data transfer or fill operation.
+/// Only provided by backends that measure it.
+class transfer_bandwidth : public instrumentation {
+public:
+  virtual std::size_t get_num_bytes() const = 0;
+  virtual double get_bytes_per_second() const = 0;
+  virtual ~transfer_bandwidth() = default;
+};
+
 }
 
 class simple_submission_timestamp : public instrumentations::submission_timestamp {
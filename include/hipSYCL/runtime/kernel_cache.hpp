@@ -12,10 +12,14 @@
 #define HIPSYCL_RT_KERNEL_CACHE_HPP
 
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 
@@ -23,6 +27,8 @@
 #include "hipSYCL/common/unordered_dense.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/generic/async_worker.hpp"
+#include "hipSYCL/runtime/kernel_cache_archive.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 
 namespace hipsycl {
@@ -182,7 +188,7 @@ public:
 
   const common::hcf_container* get_hcf(hcf_object_id obj) const;
   
-  hcf_object_id register_hcf_object(const common::hcf_container& obj);
+  hcf_object_id register_hcf_object(common::hcf_container obj);
   void unregister_hcf_object(hcf_object_id id);
 
   struct device_image_id {
@@ -320,43 +326,209 @@ public:
     }
     HIPSYCL_DEBUG_INFO << "kernel_cache: Cache MISS for id "
                       << kernel_configuration::to_string(id_of_code_object) << "\n";
-    
-    std::string compiled_binary;
-    // TODO: We might want to allow JIT compilation in parallel at some point
-    std::lock_guard<std::mutex> lock{_mutex};
 
-    if(!persistent_cache_lookup(id_of_binary, compiled_binary)){
-      if(!jit_compile(compiled_binary))
-        return nullptr;
-
-      if(_is_first_jit_compilation) {
-        _is_first_jit_compilation = false;
-        HIPSYCL_DEBUG_WARNING
-            << "kernel_cache: This application run has resulted in new "
-               "binaries being JIT-compiled. This indicates that the runtime "
-               "optimization process has not yet reached peak performance. You "
-               "may want to run the application again until this warning no "
-               "longer appears to achieve optimal performance."
-            << std::endl;
+    // JIT compilation and code object construction happen outside of _mutex,
+    // so that different kernels can be compiled concurrently from different
+    // submitting threads. Concurrent requests for the same object instead
+    // wait for the thread that is already constructing it.
+    std::promise<const code_object*> code_object_promise;
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      // Another thread might have completed construction in the meantime
+      if(auto* existing_object = get_code_object_impl(id_of_code_object))
+        return existing_object;
+
+      auto it = _pending_code_objects.find(id_of_code_object);
+      if(it != _pending_code_objects.end()) {
+        std::shared_future<const code_object*> pending = it->second;
+        lock.unlock();
+        HIPSYCL_DEBUG_INFO
+            << "kernel_cache: Waiting for concurrent construction of id "
+            << kernel_configuration::to_string(id_of_code_object) << "\n";
+        return pending.get();
       }
-      persistent_cache_store(id_of_binary, compiled_binary);
+      _pending_code_objects[id_of_code_object] =
+          code_object_promise.get_future().share();
     }
-    
-    const code_object* new_object = c(compiled_binary);
-    if(new_object)
-      _code_objects[id_of_code_object] = code_object_ptr{new_object};
-    
+    pending_result_guard guard{_mutex, _pending_code_objects, id_of_code_object,
+                               code_object_promise};
+
+    const code_object* new_object = nullptr;
+    try {
+      std::shared_ptr<const std::string> compiled_binary =
+          get_or_compile_jit_binary(id_of_binary, jit_compile);
+
+      if(compiled_binary)
+        new_object = c(*compiled_binary);
+    } catch(...) {
+      guard.fail(std::current_exception());
+      throw;
+    }
+
+    guard.complete(new_object, [&](){
+      if(new_object)
+        _code_objects[id_of_code_object] = code_object_ptr{new_object};
+    });
+
     return new_object;
   }
 
+  /// Returns whether the binary with the provided id can be obtained without
+  /// JIT compilation, i.e. whether it has already been compiled in this
+  /// application run or is available in the persistent kernel cache.
+  bool is_jit_binary_available(code_object_id id_of_binary) const;
+
+  /// Returns whether background JIT compilation of the binary with the
+  /// provided id has been requested before. This remains true after the
+  /// compilation has completed or failed.
+  bool is_background_jit_queued(code_object_id id_of_binary) const;
+
+  /// Enqueues JIT compilation of the binary with the provided id on a
+  /// background thread. Once complete, the binary will be used by
+  /// \c get_or_construct_jit_code_object() instead of compiling it again.
+  /// Requests for binaries that are already queued are ignored.
+  /// \c jit_compile has the same semantics as in
+  /// \c get_or_construct_jit_code_object(), but must not reference any state
+  /// that might be destroyed before compilation has completed.
+  void background_jit_compile(code_object_id id_of_binary,
+                              std::function<bool(std::string &)> jit_compile);
+
   // Unload entire cache and release resources to prepare runtime shutdown.
   void unload();
 
-  // Stitches together the persisten cache path with the id of the binary to a unique path.
+  // Stitches together the persistent cache directory with the id of the binary
+  // to a unique path. Can be used by backends that need to store additional,
+  // backend-specific files derived from the binary.
   static std::string get_persistent_cache_file(code_object_id id_of_binary);
+
+  // Returns the path of the archive that contains the JIT-compiled binaries
+  static std::string get_persistent_cache_archive_path();
 private:
+  using binary_ptr = std::shared_ptr<const std::string>;
+
+  /// Owns the entry of a thread in one of the maps of pending results.
+  /// On every path out of the scope, the entry is erased and waiting
+  /// threads are woken up, either with the result or with the exception
+  /// that aborted its construction.
+  template<class PendingMap, class Result>
+  class pending_result_guard {
+  public:
+    pending_result_guard(std::mutex &mutex, PendingMap &pending,
+                         code_object_id id, std::promise<Result> &promise)
+        : _mutex{mutex}, _pending{pending}, _id{id}, _promise{promise} {}
+
+    pending_result_guard(const pending_result_guard&) = delete;
+    pending_result_guard& operator=(const pending_result_guard&) = delete;
+
+    /// Publishes the result. \c on_completion is invoked while
+    /// the cache mutex is held, before the pending entry is erased.
+    template<class F>
+    void complete(Result result, F&& on_completion) {
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        on_completion();
+        _pending.erase(_id);
+      }
+      _is_complete = true;
+      _promise.set_value(std::move(result));
+    }
+
+    void fail(std::exception_ptr e) {
+      _exception = e;
+    }
+
+    ~pending_result_guard() {
+      if(_is_complete)
+        return;
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _pending.erase(_id);
+      }
+      if(!_exception)
+        _exception = std::make_exception_ptr(std::runtime_error{
+            "kernel_cache: Construction of pending object was aborted"});
+      _promise.set_exception(_exception);
+    }
+  private:
+    std::mutex& _mutex;
+    PendingMap& _pending;
+    code_object_id _id;
+    std::promise<Result>& _promise;
+    std::exception_ptr _exception;
+    bool _is_complete = false;
+  };
+
+  /// Obtains the binary for \c id_of_binary either from the persistent
+  /// cache or by invoking \c jit_compile. If another thread is already
+  /// compiling the same binary, waits for its result instead.
+  /// Returns nullptr if JIT compilation failed.
+  template<class JitCompiler>
+  binary_ptr get_or_compile_jit_binary(code_object_id id_of_binary,
+                                       JitCompiler &jit_compile) {
+    std::promise<binary_ptr> binary_promise;
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      auto background_result = _background_binaries.find(id_of_binary);
+      if(background_result != _background_binaries.end()) {
+        binary_ptr result = background_result->second;
+        HIPSYCL_DEBUG_INFO
+            << "kernel_cache: Using background JIT result for binary "
+            << kernel_configuration::to_string(id_of_binary) << "\n";
+        return result;
+      }
+
+      auto it = _pending_binaries.find(id_of_binary);
+      if(it != _pending_binaries.end()) {
+        std::shared_future<binary_ptr> pending = it->second;
+        lock.unlock();
+        HIPSYCL_DEBUG_INFO
+            << "kernel_cache: Waiting for concurrent JIT compilation of binary "
+            << kernel_configuration::to_string(id_of_binary) << "\n";
+        return pending.get();
+      }
+      _pending_binaries[id_of_binary] = binary_promise.get_future().share();
+    }
+    pending_result_guard guard{_mutex, _pending_binaries, id_of_binary,
+                               binary_promise};
+
+    auto compiled_binary = std::make_shared<std::string>();
+    binary_ptr result = compiled_binary;
+
+    try {
+      if(!persistent_cache_lookup(id_of_binary, *compiled_binary)){
+        if(jit_compile(*compiled_binary)) {
+          if(_is_first_jit_compilation.exchange(false)) {
+            HIPSYCL_DEBUG_WARNING
+                << "kernel_cache: This application run has resulted in new "
+                   "binaries being JIT-compiled. This indicates that the runtime "
+                   "optimization process has not yet reached peak performance. You "
+                   "may want to run the application again until this warning no "
+                   "longer appears to achieve optimal performance."
+                << std::endl;
+          }
+          persistent_cache_store(id_of_binary, *compiled_binary);
+        } else {
+          result = nullptr;
+        }
+      }
+    } catch(...) {
+      guard.fail(std::current_exception());
+      throw;
+    }
+
+    guard.complete(result, [&](){
+      if(result)
+        _available_binaries.insert(id_of_binary);
+    });
+
+    return result;
+  }
+
   bool persistent_cache_lookup(code_object_id id_of_binary, std::string& out) const;
   void persistent_cache_store(code_object_id id_of_binary, const std::string& data) const;
+  bool persistent_cache_contains(code_object_id id_of_binary) const;
+  void flush_persistent_cache_recency();
+  kernel_cache_archive* get_persistent_cache() const;
   
   const code_object* get_code_object_impl(code_object_id id) const;
 
@@ -383,8 +555,40 @@ private:
 
   ankerl::unordered_dense::map<code_object_id, code_object_ptr, rt::kernel_id_hash>
       _code_objects;
-  
-  bool _is_first_jit_compilation = true;
+
+  // Code objects and binaries that are currently being constructed or
+  // JIT-compiled by some thread.
+  ankerl::unordered_dense::map<code_object_id,
+                               std::shared_future<const code_object *>,
+                               rt::kernel_id_hash>
+      _pending_code_objects;
+  ankerl::unordered_dense::map<code_object_id, std::shared_future<binary_ptr>,
+                               rt::kernel_id_hash>
+      _pending_binaries;
+
+  // Ids of binaries that were successfully obtained in this application run
+  ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash>
+      _available_binaries;
+  // Binaries compiled by the background JIT worker. They are retained,
+  // so that code objects for other devices can be constructed from them.
+  ankerl::unordered_dense::map<code_object_id, binary_ptr, rt::kernel_id_hash>
+      _background_binaries;
+  // Binaries that have been enqueued for background compilation. Entries
+  // are kept after completion or failure, so that they are not retried.
+  ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash>
+      _queued_background_binaries;
+  std::unique_ptr<worker_thread> _background_jit_worker;
+
+  // Binaries that were loaded from the persistent cache, and whose
+  // recency has not yet been recorded in the appdb.
+  mutable ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash>
+      _persistent_cache_hits;
+  mutable std::mutex _persistent_cache_hits_mutex;
+
+  mutable std::once_flag _persistent_cache_init_flag;
+  mutable std::unique_ptr<kernel_cache_archive> _persistent_cache;
+
+  std::atomic<bool> _is_first_jit_compilation = true;
 };
 
 namespace detail {
@@ -0,0 +1,102 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_RT_KERNEL_CACHE_ARCHIVE_HPP
+#define HIPSYCL_RT_KERNEL_CACHE_ARCHIVE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hipSYCL/common/unordered_dense.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Persistent storage for JIT-compiled binaries in a single, append-only
+/// archive file. The archive is memory-mapped, and binaries are located
+/// using an in-memory hash index that is built by walking the record headers.
+///
+/// Multiple processes may use the same archive concurrently; appends and
+/// compaction are serialized using advisory file locks. A compaction
+/// atomically replaces the archive file, which other processes detect
+/// and handle by rebuilding their index.
+///
+/// This class is thread-safe.
+class kernel_cache_archive {
+public:
+  using binary_id = kernel_configuration::id_type;
+  /// Returns a value that is larger for more recently used binaries.
+  using recency_function = std::function<uint64_t(const binary_id &)>;
+
+  /// \param max_size If the archive grows beyond this size in bytes,
+  /// the least recently used binaries are evicted. 0 means no limit.
+  kernel_cache_archive(const std::string &path, std::size_t max_size,
+                       recency_function recency);
+  ~kernel_cache_archive();
+
+  kernel_cache_archive(const kernel_cache_archive &) = delete;
+  kernel_cache_archive &operator=(const kernel_cache_archive &) = delete;
+
+  bool contains(const binary_id &id);
+  bool lookup(const binary_id &id, std::string &out);
+  bool store(const binary_id &id, const std::string &data);
+
+  /// Rewrites the archive such that it contains only the most recently
+  /// used binaries, and does not exceed target_size bytes.
+  void compact(std::size_t target_size);
+
+  const std::string& get_path() const {
+    return _path;
+  }
+private:
+  struct index_entry {
+    // Offset of the payload in the archive file
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  bool open_archive();
+  void close_archive();
+  // Makes sure that the mapping covers the whole file, and that the
+  // index contains all records. Reopens the file if it has been replaced.
+  bool refresh();
+  bool is_replaced_on_disk() const;
+  // Writers lock this file instead of the archive itself, since
+  // compaction replaces the archive file.
+  std::string get_lock_path() const;
+  void scan_records();
+  void compact_locked(std::size_t target_size);
+
+  std::string _path;
+  std::size_t _max_size;
+  recency_function _recency;
+
+  int _fd = -1;
+  uint64_t _file_identity = 0;
+  const char* _mapping = nullptr;
+  std::size_t _mapped_size = 0;
+  // All records before this offset have been added to the index
+  std::size_t _scanned_until = 0;
+
+  // Only used on platforms without mmap support
+  std::vector<char> _file_contents;
+
+  ankerl::unordered_dense::map<binary_id, index_entry, kernel_id_hash> _index;
+  std::mutex _mutex;
+};
+
+}
+}
+
+#endif
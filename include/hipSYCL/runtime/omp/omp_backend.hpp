@@ -15,6 +15,7 @@
 #include "../multi_queue_executor.hpp"
 #include "omp_allocator.hpp"
 #include "omp_hardware_manager.hpp"
+#include "omp_work_group_pool.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -39,9 +40,15 @@ public:
 
   std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
+
+  /// The pool shared by all queues of the backend. It is started on first
+  /// use, and joined when the backend is destroyed.
+  omp_work_group_pool& get_work_group_pool() const;
 private:
   mutable omp_allocator _allocator;
   mutable omp_hardware_manager _hw;
+  // Must outlive the queues of _executor, which submit to it
+  mutable lazily_constructed_executor<omp_work_group_pool> _work_group_pool;
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
 };
 
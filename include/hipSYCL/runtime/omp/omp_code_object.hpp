@@ -11,6 +11,7 @@
 #ifndef HIPSYCL_OMP_CODE_OBJECT_HPP
 #define HIPSYCL_OMP_CODE_OBJECT_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,6 +23,10 @@
 
 
 namespace hipsycl {
+namespace compiler {
+class HostJITDylib;
+}
+
 namespace rt {
 
 class omp_sscp_executable_object : public code_object {
@@ -44,7 +49,7 @@ public:
 
   using omp_sscp_kernel = void(const work_group_info *, void **);
 
-  omp_sscp_executable_object(const std::string &shared_lib_path,
+  omp_sscp_executable_object(const std::string &binary,
                              hcf_object_id hcf_source,
                              const std::vector<std::string> &kernel_names,
                              const kernel_configuration &config);
@@ -69,6 +74,7 @@ public:
 
 private:
   result build(const std::string &source, const std::vector<std::string> &kernel_names);
+  void *get_symbol(const std::string &name) const;
 
   hcf_object_id _hcf;
   kernel_configuration::id_type _id;
@@ -76,6 +82,9 @@ private:
 
   result _build_result;
   void *_module;
+  // Set instead of a shared library if the kernels have been compiled
+  // to a relocatable object, which is linked in-process.
+  std::unique_ptr<compiler::HostJITDylib> _jit_dylib;
 
   std::vector<std::string> _kernel_names;
   std::unordered_map<std::string_view, omp_sscp_kernel*> _kernels;
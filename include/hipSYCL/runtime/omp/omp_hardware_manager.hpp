@@ -13,9 +13,33 @@
 
 #include "../hardware.hpp"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace hipsycl {
 namespace rt {
 
+/// \return The size of the L2 cache, which is typically the largest
+/// cache that is private to a core. Inline, so that it is also available
+/// to the OpenMP kernel launchers.
+inline std::size_t get_host_cache_size() {
+  static const std::size_t cache_size = []() -> std::size_t {
+#if !defined(_WIN32) && defined(_SC_LEVEL2_CACHE_SIZE)
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if(size > 0)
+      return static_cast<std::size_t>(size);
+#endif
+    return 512 * 1024;
+  }();
+  return cache_size;
+}
+
+/// \return The sub-group size that SSCP host kernels use if
+/// ACPP_JITOPT_HOST_SIMD_SUBGROUPS is enabled: The number of 32 bit
+/// lanes in the widest vector registers of the CPU, or 1 if unknown.
+std::size_t get_host_simd_subgroup_size();
+
 class omp_hardware_context : public hardware_context
 {
 public:
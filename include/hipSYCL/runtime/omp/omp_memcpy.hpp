@@ -0,0 +1,64 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OMP_MEMCPY_HPP
+#define HIPSYCL_OMP_MEMCPY_HPP
+
+#include <cstddef>
+
+namespace hipsycl {
+namespace rt {
+
+class omp_work_group_pool;
+
+/// A possibly strided 3D region of host memory that is copied
+/// row by row. Pitches are given in bytes.
+struct omp_copy_region {
+  const char *src;
+  char *dest;
+
+  std::size_t row_size;
+  std::size_t num_rows;
+  std::size_t num_surfaces;
+
+  std::size_t src_row_pitch;
+  std::size_t src_surface_pitch;
+  std::size_t dest_row_pitch;
+  std::size_t dest_surface_pitch;
+};
+
+/// Copies and fills large host memory regions using the workers of an
+/// omp_work_group_pool.
+///
+/// * The destination is split into page-aligned blocks. Since the pool
+///   initially assigns each worker a contiguous range of blocks, and orders
+///   workers by NUMA node, each NUMA node writes a contiguous part of the
+///   destination. For fresh allocations, this first touch places the pages
+///   on the node that wrote them.
+/// * When processed in parallel, destinations that do not fit into the
+///   cache are written with non-temporal stores where supported, so that
+///   they do not evict the source data from the cache.
+/// * Small regions are processed by the calling thread.
+/// * Large regions are processed with the given priority, see
+///   omp_work_group_pool.
+///
+/// Must not be called from a worker of the given pool.
+class omp_memcpy_engine {
+public:
+  static void copy(omp_work_group_pool &pool, const omp_copy_region &region,
+                   int priority);
+  static void fill(omp_work_group_pool &pool, void *ptr, int pattern,
+                   std::size_t num_bytes, int priority);
+};
+
+}
+}
+
+#endif
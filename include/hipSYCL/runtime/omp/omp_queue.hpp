@@ -24,6 +24,7 @@ namespace rt {
 
 class omp_queue;
 class omp_backend;
+class omp_work_group_pool;
 
 class omp_sscp_code_object_invoker : public sscp_code_object_invoker {
 public:
@@ -52,7 +53,7 @@ private:
 class omp_queue : public inorder_queue
 {
 public:
-  omp_queue(omp_backend* be, int dev);
+  omp_queue(omp_backend* be, int dev, int priority);
   virtual ~omp_queue();
 
   /// Inserts an event into the stream
@@ -86,6 +87,9 @@ public:
   worker_thread& get_worker();
 private:
   const backend_id _backend_id;
+  omp_work_group_pool& _work_group_pool;
+  // Priority of kernels and large transfers in the _work_group_pool
+  const int _priority;
   worker_thread _worker;
 
   omp_sscp_code_object_invoker _sscp_code_object_invoker;
@@ -0,0 +1,128 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OMP_WORK_GROUP_POOL_HPP
+#define HIPSYCL_OMP_WORK_GROUP_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Pool of persistent worker threads that execute the work-groups of SSCP
+/// kernels and large transfers on the host. The omp_backend owns the pool,
+/// and all of its omp_queue instances share it, so concurrently running
+/// kernels do not oversubscribe the machine.
+///
+/// * Each launch is split into one contiguous range of work-group ids per
+///   worker. Workers process their own range in chunks, and steal half of
+///   the remaining range of other workers when they run out of work,
+///   preferring workers on the same NUMA node.
+/// * Each worker participates in at most one launch at a time. If multiple
+///   launches are active, workers distribute themselves evenly across them,
+///   such that independent kernels co-run on disjoint sets of cores.
+/// * Launches carry a priority; as for CUDA streams, lower values indicate
+///   higher priority. Workers always join the launch with the highest
+///   priority, and leave lower-priority launches for it once they have
+///   completed their current chunk of work-groups. Launches of equal
+///   priority share the workers. To avoid starvation, the priority of
+///   launches that no worker participates in increases over time, until
+///   they are joined by a worker. Aging restarts once they are left
+///   without workers again.
+/// * If libnuma is available, workers are bound to the CPUs of their
+///   NUMA node.
+class omp_work_group_pool {
+public:
+  /// Processes the work-groups with linear ids [begin, end).
+  using range_function = void (*)(void *user_data, std::size_t begin,
+                                  std::size_t end);
+
+  static constexpr int default_priority = 0;
+  /// The range of priorities that is reported to users. Other values
+  /// are accepted and ordered accordingly.
+  static constexpr int lowest_priority = default_priority;
+  static constexpr int highest_priority = -4;
+  /// The time after which the priority of a launch without workers
+  /// increases by one
+  static constexpr std::chrono::milliseconds aging_interval{20};
+
+  /// Creates one worker per OpenMP thread
+  omp_work_group_pool();
+  explicit omp_work_group_pool(std::size_t num_workers);
+
+  omp_work_group_pool(const omp_work_group_pool&) = delete;
+  omp_work_group_pool& operator=(const omp_work_group_pool&) = delete;
+  /// Waits for the workers to finish. No launches may be running.
+  ~omp_work_group_pool();
+
+  /// Executes \c f for disjoint ranges covering [0, num_work_groups)
+  /// and returns once all of them have completed. May be called
+  /// concurrently from multiple threads, but not from a pool worker.
+  void run(std::size_t num_work_groups, range_function f, void *user_data,
+           int priority = default_priority);
+
+  template <class F>
+  void run(std::size_t num_work_groups, F &&f,
+           int priority = default_priority) {
+    run(
+        num_work_groups,
+        [](void *user_data, std::size_t begin, std::size_t end) {
+          (*static_cast<std::remove_reference_t<F> *>(user_data))(begin, end);
+        },
+        static_cast<void *>(&f), priority);
+  }
+
+  std::size_t get_num_workers() const { return _workers.size(); }
+private:
+  struct job;
+
+  struct worker {
+    std::thread thread;
+    int numa_node = 0;
+    // Order in which other workers' ranges are stolen from
+    std::vector<std::size_t> victims;
+  };
+
+  void work(std::size_t worker_id);
+  // Executes chunks of the given job until it runs out of work, or
+  // the worker should move to a different job. Returns true if the job
+  // has no work left that could be claimed.
+  bool process(job &j, std::size_t worker_id);
+  bool claim(job &j, std::size_t worker_id, std::size_t &begin,
+             std::size_t &end);
+  bool should_switch_job(const job& j) const;
+  // Needs to be called with _mutex locked
+  job *select_job() const;
+  // Needs to be called with _mutex locked
+  int get_effective_priority(const job &j,
+                             std::chrono::steady_clock::time_point now) const;
+
+  std::vector<worker> _workers;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _work_available;
+  std::condition_variable _job_completed;
+  std::vector<job *> _active_jobs;
+  std::atomic<std::size_t> _num_active_jobs;
+  bool _shutdown;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_RECORDED_GRAPH_HPP
+#define HIPSYCL_RECORDED_GRAPH_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dag_node.hpp"
+#include "device_id.hpp"
+#include "error.hpp"
+#include "hints.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+class operation;
+class inorder_executor;
+class backend_executor;
+class runtime;
+
+/// An immutable snapshot of a section of the DAG that has already been
+/// executed once. All scheduling decisions - target device, executor and
+/// execution lane as well as the dependencies between the operations - are
+/// resolved when the graph is created, so replaying the graph submits the
+/// operations directly to their lanes without going through the dag_builder
+/// or the schedulers.
+///
+/// Operations are shared between all replays, so the graph can only contain
+/// operations that do not carry per-submission state, i.e. no buffer
+/// requirements. Instrumentation is not available for replayed nodes.
+class recorded_graph {
+public:
+  /// Creates a graph from the given nodes, which must all have been
+  /// submitted. The order of nodes defines the operation indices.
+  /// Requirements of the nodes that are not part of \c nodes are not
+  /// recorded; instead, the corresponding nodes will depend on the external
+  /// dependencies passed to \c replay().
+  static result create(const node_list_t &nodes,
+                       std::shared_ptr<recorded_graph> &graph_out);
+
+  /// Submits all operations of the graph as members of the given node group.
+  /// Operations with dependencies outside of the graph wait for
+  /// \c external_deps instead.
+  /// Returns the nodes of the submitted operations in index order.
+  result replay(const node_list_t &external_deps, std::size_t node_group_id,
+                runtime *rt, node_list_t &nodes_out);
+
+  /// Replaces the operation with the given index by the operation of
+  /// \c node, which must have been created but not submitted. Executor and
+  /// hints are taken from \c node in the same way as during recording.
+  /// Replays that are already in flight keep using the previous operation.
+  result update_operation(std::size_t index, const dag_node_ptr &node);
+
+  std::size_t get_num_operations() const;
+  /// Indices of the operations that no other operation in the graph
+  /// depends on
+  const std::vector<std::size_t>& get_sink_indices() const;
+
+private:
+  recorded_graph() = default;
+
+  struct entry {
+    std::shared_ptr<operation> op;
+    device_id dev;
+    backend_executor* executor;
+    inorder_executor* lane;
+    execution_hints hints;
+    std::vector<std::size_t> dependencies;
+    bool has_external_dependencies;
+  };
+
+  std::vector<entry> _entries;
+  std::vector<std::size_t> _sinks;
+  std::mutex _mutex;
+};
+
+}
+}
+
+#endif
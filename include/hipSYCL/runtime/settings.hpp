@@ -25,6 +25,7 @@ namespace rt {
 
 enum class scheduler_type { direct, unbound };
 enum class default_selector_behavior { strict, multigpu, system };
+enum class omp_parallel_for_tiling { none, row_major, morton };
 enum class jitopt_host_vector_math_library {
   none = 0,
   sleef = 1,
@@ -58,6 +59,7 @@ bool has_device_visibility_mask(const visibility_mask_t& mask, backend_id backen
 std::istream &operator>>(std::istream &istr, scheduler_type &out);
 std::istream &operator>>(std::istream &istr, visibility_mask_t &out);
 std::istream &operator>>(std::istream &istr, default_selector_behavior& out);
+std::istream &operator>>(std::istream &istr, omp_parallel_for_tiling& out);
 std::istream &operator>>(std::istream &istr, std::optional<hipsycl::rt::jitopt_host_vector_math_library>& out);
 
 enum class setting {
@@ -75,12 +77,21 @@ enum class setting {
   ocl_no_shared_context,
   ocl_show_all_devices,
   no_jit_cache_population,
+  jit_cache_max_size,
   adaptivity_level,
   jitopt_iads_relative_threshold,
   jitopt_iads_relative_eviction_threshold,
   jitopt_iads_relative_threshold_min_data,
+  jitopt_iads_background_compilation,
   enable_allocation_tracking,
-  jitopt_host_vector_math_library
+  jitopt_host_vector_math_library,
+  allocation_pool_max_cached_size,
+  jitopt_host_simd_subgroups,
+  memcpy_calibration,
+  event_pool_max_size,
+  event_pool_preallocation,
+  eager_backend_initialization,
+  omp_parallel_for_tiling
 };
 
 template <setting S> struct setting_trait {};
@@ -112,16 +123,34 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::gc_trigger_batch_size, "rt_gc_trigger_bat
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_no_shared_context, "rt_ocl_no_shared_context", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_show_all_devices, "rt_ocl_show_all_devices", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::no_jit_cache_population, "rt_no_jit_cache_population", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_cache_max_size, "rt_jit_cache_max_size", std::size_t)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::adaptivity_level, "adaptivity_level", int)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold, "jitopt_iads_relative_threshold", double)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_eviction_threshold, "jitopt_iads_relative_eviction_threshold", double)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold_min_data,
                               "jitopt_iads_relative_threshold_min_data",
                               std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_background_compilation,
+                              "jitopt_iads_background_compilation", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::enable_allocation_tracking, "allocation_tracking", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_host_vector_math_library,
                               "jitopt_host_vector_math_library",
                               std::optional<jitopt_host_vector_math_library>)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::allocation_pool_max_cached_size,
+                              "rt_allocation_pool_max_cached_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_host_simd_subgroups,
+                              "jitopt_host_simd_subgroups", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::memcpy_calibration,
+                              "rt_memcpy_calibration", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::event_pool_max_size,
+                              "rt_event_pool_max_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::event_pool_preallocation,
+                              "rt_event_pool_preallocation", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::eager_backend_initialization,
+                              "rt_eager_backend_initialization", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_parallel_for_tiling,
+                              "rt_omp_parallel_for_tiling",
+                              omp_parallel_for_tiling)
 
 class settings
 {
@@ -156,6 +185,8 @@ public:
       return _ocl_show_all_devices;
     } else if constexpr(S == setting::no_jit_cache_population) {
       return _no_jit_cache_population;
+    } else if constexpr(S == setting::jit_cache_max_size) {
+      return _jit_cache_max_size;
     } else if constexpr(S == setting::adaptivity_level) {
       return _adaptivity_level;
     } else if constexpr(S == setting::jitopt_iads_relative_threshold) {
@@ -164,10 +195,26 @@ public:
       return _jitopt_iads_relative_threshold_min_data;
     } else if constexpr(S == setting::jitopt_iads_relative_eviction_threshold) {
       return _jitopt_iads_relative_eviction_threshold;
+    } else if constexpr(S == setting::jitopt_iads_background_compilation) {
+      return _jitopt_iads_background_compilation;
     } else if constexpr(S == setting::enable_allocation_tracking) {
       return _enable_allocation_tracking;
     } else if constexpr(S == setting::jitopt_host_vector_math_library) {
       return _jitopt_host_vector_math_library;
+    } else if constexpr(S == setting::allocation_pool_max_cached_size) {
+      return _allocation_pool_max_cached_size;
+    } else if constexpr(S == setting::jitopt_host_simd_subgroups) {
+      return _jitopt_host_simd_subgroups;
+    } else if constexpr(S == setting::memcpy_calibration) {
+      return _memcpy_calibration;
+    } else if constexpr(S == setting::event_pool_max_size) {
+      return _event_pool_max_size;
+    } else if constexpr(S == setting::event_pool_preallocation) {
+      return _event_pool_preallocation;
+    } else if constexpr(S == setting::eager_backend_initialization) {
+      return _eager_backend_initialization;
+    } else if constexpr(S == setting::omp_parallel_for_tiling) {
+      return _omp_parallel_for_tiling;
     }
     return typename setting_trait<S>::type{};
   }
@@ -209,6 +256,8 @@ public:
         get_configuration_or_default<setting::ocl_show_all_devices>(false);
     _no_jit_cache_population =
         get_configuration_or_default<setting::no_jit_cache_population>(false);
+    _jit_cache_max_size =
+        get_configuration_or_default<setting::jit_cache_max_size>(4096);
     _adaptivity_level =
         get_configuration_or_default<setting::adaptivity_level>(1);
     
@@ -218,12 +267,31 @@ public:
         get_configuration_or_default<setting::jitopt_iads_relative_eviction_threshold>(0.1);
     _jitopt_iads_relative_threshold_min_data =
         get_configuration_or_default<setting::jitopt_iads_relative_threshold_min_data>(1024);
+    _jitopt_iads_background_compilation =
+        get_configuration_or_default<setting::jitopt_iads_background_compilation>(false);
     _enable_allocation_tracking =
         get_configuration_or_default<setting::enable_allocation_tracking>(
             common::settings::get_default_enable_allocation_tracking());
     _jitopt_host_vector_math_library =
         get_configuration_or_default<setting::jitopt_host_vector_math_library>(
             std::optional<jitopt_host_vector_math_library>{});
+    _allocation_pool_max_cached_size =
+        get_configuration_or_default<setting::allocation_pool_max_cached_size>(
+            256);
+    _jitopt_host_simd_subgroups =
+        get_configuration_or_default<setting::jitopt_host_simd_subgroups>(false);
+    _memcpy_calibration =
+        get_configuration_or_default<setting::memcpy_calibration>(false);
+    _event_pool_max_size =
+        get_configuration_or_default<setting::event_pool_max_size>(1024);
+    _event_pool_preallocation =
+        get_configuration_or_default<setting::event_pool_preallocation>(16);
+    _eager_backend_initialization =
+        get_configuration_or_default<setting::eager_backend_initialization>(
+            false);
+    _omp_parallel_for_tiling =
+        get_configuration_or_default<setting::omp_parallel_for_tiling>(
+            omp_parallel_for_tiling::morton);
   }
 
 private:
@@ -250,12 +318,21 @@ private:
   bool _ocl_no_shared_context;
   bool _ocl_show_all_devices;
   bool _no_jit_cache_population;
+  std::size_t _jit_cache_max_size;
   int _adaptivity_level;
   double _jitopt_iads_relative_threshold;
   double _jitopt_iads_relative_eviction_threshold;
   std::size_t _jitopt_iads_relative_threshold_min_data;
+  bool _jitopt_iads_background_compilation;
   bool _enable_allocation_tracking;
   std::optional<jitopt_host_vector_math_library> _jitopt_host_vector_math_library;
+  std::size_t _allocation_pool_max_cached_size;
+  bool _jitopt_host_simd_subgroups;
+  bool _memcpy_calibration;
+  std::size_t _event_pool_max_size;
+  std::size_t _event_pool_preallocation;
+  bool _eager_backend_initialization;
+  omp_parallel_for_tiling _omp_parallel_for_tiling;
 };
 
 }
@@ -23,6 +23,7 @@
 #include <cassert>
 
 #include "hipSYCL/common/allocation_map.hpp"
+#include "hipSYCL/common/spin_lock.hpp"
 
 
 extern "C" void *__libc_malloc(size_t);
@@ -241,6 +242,225 @@ private:
   std::array<block_set_type, max_allocation_space_in_bits> _sorted_free_blocks_in_level;
 };
 
+/// Front-end for small allocations. Objects are grouped into size classes,
+/// and carved from slabs that each hold objects of a single class, so that
+/// small objects are neither rounded up to full pages nor need to pass
+/// through the free_space_map.
+///
+/// Freed objects are cached per thread, and exchanged with a per-class
+/// free list in batches. Slabs are never returned to the provider.
+///
+/// Since the caches are thread-local, there may only be one instance.
+class slab_allocator {
+public:
+  static constexpr std::size_t max_object_size = 2048;
+  static constexpr std::size_t slab_size = 64 * 1024;
+
+  /// Returns a new slab of slab_size bytes, or nullptr if none
+  /// is available.
+  using slab_provider = void *(*)(void *user_data);
+
+  slab_allocator(slab_provider provider, void *user_data)
+      : _provider{provider}, _provider_data{user_data} {
+    for(auto& c : _size_classes) {
+      c.free_list = nullptr;
+      c.slab_cursor = nullptr;
+      c.slab_end = nullptr;
+    }
+  }
+
+  static bool is_small(std::size_t size) {
+    return size <= max_object_size;
+  }
+
+  void* allocate(std::size_t size) {
+    assert(is_small(size));
+    int size_class = get_size_class(size);
+    thread_cache& cache = get_thread_cache();
+
+    if(!cache.heads[size_class] && !refill(cache, size_class))
+      return nullptr;
+
+    free_object* obj = cache.heads[size_class];
+    cache.heads[size_class] = obj->next;
+    --cache.counts[size_class];
+
+    if(cache.is_detached)
+      flush(cache, size_class, 0);
+    return obj;
+  }
+
+  void deallocate(void* ptr, std::size_t size) {
+    assert(is_small(size));
+    int size_class = get_size_class(size);
+    thread_cache& cache = get_thread_cache();
+
+    free_object* obj = static_cast<free_object*>(ptr);
+    obj->next = cache.heads[size_class];
+    cache.heads[size_class] = obj;
+    ++cache.counts[size_class];
+
+    std::size_t batch_size = get_batch_size(size_class);
+    if(cache.is_detached)
+      flush(cache, size_class, 0);
+    else if(cache.counts[size_class] >= 2 * batch_size)
+      flush(cache, size_class, batch_size);
+  }
+
+  static constexpr std::size_t get_object_size(int size_class) {
+    // 16 byte steps up to 128 bytes, then 4 steps per power of two
+    if(size_class < 8)
+      return 16 * (size_class + 1);
+    int group = (size_class - 8) / 4;
+    int step = (size_class - 8) % 4;
+    return (std::size_t{128} << group) + (step + 1) * (std::size_t{32} << group);
+  }
+private:
+  static constexpr int num_size_classes = 24;
+
+  struct free_object {
+    free_object* next;
+  };
+
+  struct alignas(64) size_class {
+    common::spin_lock lock;
+    free_object* free_list;
+    // Part of the most recent slab that has not been handed out yet
+    char* slab_cursor;
+    char* slab_end;
+  };
+
+  // Trivially destructible, so that it remains usable while other
+  // thread-local objects are destroyed.
+  struct thread_cache {
+    free_object* heads[num_size_classes];
+    std::size_t counts[num_size_classes];
+    slab_allocator* owner;
+    // Set once the thread has returned its cached objects;
+    // objects are then exchanged with the size classes directly.
+    bool is_detached;
+  };
+
+  struct thread_cache_release {
+    ~thread_cache_release() {
+      thread_cache& c = get_thread_cache_storage();
+      if(c.owner)
+        for(int i = 0; i < num_size_classes; ++i)
+          c.owner->flush(c, i, 0);
+      c.is_detached = true;
+    }
+  };
+
+  thread_cache& get_thread_cache() {
+    thread_cache& c = get_thread_cache_storage();
+    c.owner = this;
+    return c;
+  }
+
+  static thread_cache& get_thread_cache_storage() {
+    static thread_local thread_cache c{};
+    static thread_local thread_cache_release r;
+    return c;
+  }
+
+  static int get_size_class(std::size_t size) {
+    if(size <= 128)
+      return size == 0 ? 0 : static_cast<int>((size + 15) / 16) - 1;
+    uint64_t s = size - 1;
+    int msb = 63 - __builtin_clzll(s);
+    return 8 + (msb - 7) * 4 + static_cast<int>(s >> (msb - 2)) - 4;
+  }
+
+  // Number of objects that are exchanged between thread caches
+  // and the size class at a time
+  static std::size_t get_batch_size(int size_class) {
+    return std::max(std::size_t{4}, 4096 / get_object_size(size_class));
+  }
+
+  bool refill(thread_cache& cache, int size_class_index) {
+    size_class& c = _size_classes[size_class_index];
+    std::size_t object_size = get_object_size(size_class_index);
+    std::size_t batch_size = get_batch_size(size_class_index);
+
+    free_object* head = nullptr;
+    free_object* tail = nullptr;
+    std::size_t num_objects = 0;
+    {
+      common::spin_lock_guard lock{c.lock};
+      for(; num_objects < batch_size && c.free_list; ++num_objects) {
+        free_object* obj = c.free_list;
+        c.free_list = obj->next;
+        obj->next = nullptr;
+        if(tail)
+          tail->next = obj;
+        else
+          head = obj;
+        tail = obj;
+      }
+
+      for(; num_objects < batch_size; ++num_objects) {
+        if(c.slab_end - c.slab_cursor < static_cast<std::ptrdiff_t>(object_size)) {
+          char* slab = static_cast<char*>(_provider(_provider_data));
+          if(!slab)
+            break;
+          c.slab_cursor = slab;
+          c.slab_end = slab + slab_size;
+        }
+        // Hand out consecutive objects in address order
+        free_object* obj = reinterpret_cast<free_object*>(c.slab_cursor);
+        c.slab_cursor += object_size;
+        obj->next = nullptr;
+        if(tail)
+          tail->next = obj;
+        else
+          head = obj;
+        tail = obj;
+      }
+    }
+
+    if(!head)
+      return false;
+    tail->next = cache.heads[size_class_index];
+    cache.heads[size_class_index] = head;
+    cache.counts[size_class_index] += num_objects;
+    return true;
+  }
+
+  // Returns all cached objects of the size class except for the
+  // num_retained most recently freed ones.
+  void flush(thread_cache& cache, int size_class_index,
+             std::size_t num_retained) {
+    std::size_t& count = cache.counts[size_class_index];
+    if(count <= num_retained)
+      return;
+
+    free_object* head;
+    if(num_retained == 0) {
+      head = cache.heads[size_class_index];
+      cache.heads[size_class_index] = nullptr;
+    } else {
+      free_object* last_retained = cache.heads[size_class_index];
+      for(std::size_t i = 1; i < num_retained; ++i)
+        last_retained = last_retained->next;
+      head = last_retained->next;
+      last_retained->next = nullptr;
+    }
+    free_object* tail = head;
+    while(tail->next)
+      tail = tail->next;
+    count = num_retained;
+
+    size_class& c = _size_classes[size_class_index];
+    common::spin_lock_guard lock{c.lock};
+    tail->next = c.free_list;
+    c.free_list = head;
+  }
+
+  slab_provider _provider;
+  void* _provider_data;
+  std::array<size_class, num_size_classes> _size_classes;
+};
+
 }
 
 #endif
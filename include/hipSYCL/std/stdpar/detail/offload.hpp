@@ -545,6 +545,10 @@ public:
     }
     // Convert from seconds to ns
     _min_time_per_offload_decision *= 1.e9;
+    if (!common::settings::try_retrieve_settings_variable(
+            "stdpar_ohc_exploration_fraction", _exploration_fraction)) {
+      _exploration_fraction = 0.05;
+    }
   }
 
   double get_min_time_per_offload_decision() const {
@@ -552,11 +556,26 @@ public:
   }
 
   int get_min_ops_per_offload_decision() const {
-    return _min_time_per_offload_decision;
+    return _min_ops_per_offload_decision;
+  }
+
+  // Maximum fraction of operations that may be executed on the device
+  // that the heuristic currently does not prefer in order to obtain
+  // measurements.
+  double get_exploration_fraction() const {
+    return _exploration_fraction;
+  }
+
+  // Number of consecutive operations executed when exploring. The first
+  // operation after switching between host and offloading includes data
+  // migrations, so multiple operations are needed for a clean measurement.
+  int get_exploration_burst_length() const {
+    return 4;
   }
 private:
   double _min_time_per_offload_decision;
   int _min_ops_per_offload_decision;
+  double _exploration_fraction;
 };
 
 struct offload_heuristic_state {
@@ -629,6 +648,50 @@ struct offload_heuristic_state {
   const offload_heuristic_config& get_configuration() const {
     return _config;
   }
+
+  // Exploration executes operations on the device that is currently not
+  // preferred, so that measurements are obtained during regular
+  // application runs.
+  bool is_exploring() const {
+    return _num_remaining_exploration_ops > 0;
+  }
+
+  bool may_begin_exploration() const {
+    return static_cast<double>(_num_explored_ops) <
+           _config.get_exploration_fraction() *
+               static_cast<double>(_num_total_ops);
+  }
+
+  void begin_exploration(bool offloading) {
+    _is_exploring_offloading = offloading;
+    _num_remaining_exploration_ops = _config.get_exploration_burst_length();
+  }
+
+  // Returns whether the explored operation should be offloaded
+  bool proceed_exploration() {
+    --_num_remaining_exploration_ops;
+    ++_num_explored_ops;
+    return _is_exploring_offloading;
+  }
+
+  // Returns true if the most recent operation was executed on the other
+  // side, in which case data likely needs to be migrated.
+  bool proceed_execution_side(bool offloading) {
+    bool changed = offloading != _is_previous_op_offloaded;
+    _is_previous_op_offloaded = offloading;
+    return changed;
+  }
+
+  // Number of bytes that are expected to be migrated for the next operation
+  void set_pending_migration(std::size_t num_bytes) {
+    _pending_migration_size = num_bytes;
+  }
+
+  std::size_t take_pending_migration() {
+    std::size_t num_bytes = _pending_migration_size;
+    _pending_migration_size = 0;
+    return num_bytes;
+  }
 private:
   
   offload_heuristic_state()
@@ -636,7 +699,10 @@ private:
         _is_offload_sampling_run{is_offload_sampling_run_requested()},
         _num_ops_since_offloading_change{0}, _previous_op{},
         _previous_offloading_change_timestamp{0}, _time_since_previous_op{0},
-        _is_currently_offloading{false}, _num_total_ops{0}, _num_predicted_ops{0} {}
+        _is_currently_offloading{false}, _num_total_ops{0}, _num_predicted_ops{0},
+        _num_explored_ops{0}, _num_remaining_exploration_ops{0},
+        _is_exploring_offloading{false}, _is_previous_op_offloaded{false},
+        _pending_migration_size{0} {}
 
   bool _is_host_sampling_run;
   bool _is_offload_sampling_run;
@@ -648,6 +714,12 @@ private:
   bool _is_currently_offloading;
   std::size_t _num_total_ops;
   int _num_predicted_ops;
+  std::size_t _num_explored_ops;
+  int _num_remaining_exploration_ops;
+  bool _is_exploring_offloading;
+  // Data is initially on the host
+  bool _is_previous_op_offloaded;
+  std::size_t _pending_migration_size;
   offload_heuristic_config _config;
 
   static bool is_host_sampling_run_requested(){
@@ -720,32 +792,31 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
     }
   };
 
-  auto decide_offloading_viability = [&](std::optional<bool> is_currently_offloading = {}){
-
-    // Instead of hardcoding peak PCIe speeds, this should be measured
-    double data_transfer_time_estimate = 0;
+  auto& db = detail::stdpar_tls_runtime::get().get_offload_db();
 
+  std::size_t used_memory = 0;
 #if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
-    std::size_t used_memory = 0;
-    for_each_contained_pointer([&](void* ptr){
-      unified_shared_memory::allocation_lookup_result lookup_result;
-  
-      if(ptr && unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
-        used_memory += lookup_result.info->allocation_size;
-      }
-    }, args...);
+  for_each_contained_pointer([&](void* ptr){
+    unified_shared_memory::allocation_lookup_result lookup_result;
 
-    if(detail::stdpar_tls_runtime::get().get_current_offloading_batch_id() > 0)
-      data_transfer_time_estimate = used_memory / 32.0;
+    if(ptr && unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
+      used_memory += lookup_result.info->allocation_size;
+    }
+  }, args...);
 #endif
 
+  auto decide_offloading_viability = [&](std::optional<bool> is_currently_offloading = {}){
+
+    double data_transfer_time_estimate = 0;
+    if(detail::stdpar_tls_runtime::get().get_current_offloading_batch_id() > 0)
+      data_transfer_time_estimate = used_memory / db.get_migration_bandwidth();
+
     double host_time_estimate = 0.0;
     double offload_time_estimate = 0.0;
     
     num_predicted_ops = 0;
 
     for_each_known_op_in_batch([&](op_id op) -> bool{
-      auto& db = detail::stdpar_tls_runtime::get().get_offload_db();
       double current_host_estimate = db.estimate_runtime(
           op.first, op.second, offload_heuristic_db::host_device_id);
       double current_offload_estimate = db.estimate_runtime(
@@ -793,11 +864,9 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
 
   state.proceed_to(op_hash, n);
   
-  if (state.get_num_ops_since_offloading_change() < state.get_num_predicted_ops() ||
-      state.get_num_ops_since_offloading_change() < min_ops_before_offloading_change ||
-      state.get_ns_since_previous_op() < state.get_configuration().get_min_time_per_offload_decision()) {
-    return state.is_currently_offloading();
-  } else {
+  if (state.get_num_ops_since_offloading_change() >= state.get_num_predicted_ops() &&
+      state.get_num_ops_since_offloading_change() >= min_ops_before_offloading_change &&
+      state.get_ns_since_previous_op() >= state.get_configuration().get_min_time_per_offload_decision()) {
     state.set_offloading(decide_offloading_viability(state.is_currently_offloading()));
     state.set_num_predicted_ops(num_predicted_ops);
 
@@ -807,13 +876,35 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
                        << "\n";
   }
 
-  return state.is_currently_offloading();
+  bool is_offloading = state.is_currently_offloading();
+  if(state.is_exploring()) {
+    is_offloading = state.proceed_exploration();
+  } else if(state.may_begin_exploration()) {
+    auto unpreferred_device = is_offloading
+                                  ? offload_heuristic_db::host_device_id
+                                  : offload_heuristic_db::offload_device_id;
+    // Explore if we do not know how the operation performs
+    // for the current problem size on the other device
+    if(!db.has_sample_near(op_hash, n, unpreferred_device)) {
+      HIPSYCL_DEBUG_INFO << "[stdpar] Exploring "
+                         << (is_offloading ? "host execution" : "offloading")
+                         << " for operation " << op_hash
+                         << " with problem size " << n << "\n";
+      state.begin_exploration(!is_offloading);
+      is_offloading = state.proceed_exploration();
+    }
+  }
+
+  if(state.proceed_execution_side(is_offloading))
+    state.set_pending_migration(used_memory);
+  return is_offloading;
 #endif
 }
 
 struct host_invocation_measurement {
   host_invocation_measurement(uint64_t hash, std::size_t problem_size)
-  : _hash{hash}, _problem_size{problem_size} {}
+  : _hash{hash}, _problem_size{problem_size},
+    _migrated_bytes{offload_heuristic_state::get().take_pending_migration()} {}
 
   template<class F>
   auto operator()(F&& f) {
@@ -829,15 +920,31 @@ struct host_invocation_measurement {
     auto& offload_db = stdpar_tls_runtime::get().get_offload_db();
     
       uint64_t end = get_time_now();
-      uint64_t delta = end - _start;
+      double delta = static_cast<double>(end - _start);
+
+      if(_migrated_bytes > 0) {
+        // Data had to be migrated back from the device
+        if (offload_db.has_sample_near(_hash, _problem_size,
+                                       offload_heuristic_db::host_device_id)) {
+          double compute_time_estimate = offload_db.estimate_runtime(
+              _hash, _problem_size, offload_heuristic_db::host_device_id);
+          offload_db.update_migration_bandwidth(_migrated_bytes,
+                                                delta - compute_time_estimate);
+          return;
+        }
+        delta -= _migrated_bytes / offload_db.get_migration_bandwidth();
+        if(delta <= 0.0)
+          return;
+      }
 
       offload_db.update_entry(_hash, _problem_size,
                               offload_heuristic_db::host_device_id,
-                              (double)delta);
+                              delta);
   }
 private:
   uint64_t _hash;
   std::size_t _problem_size;
+  std::size_t _migrated_bytes;
   uint64_t _start = 0;
 };
 
@@ -849,7 +956,9 @@ struct device_invocation_measurement {
   auto operator()(F&& f) {
  
     auto& offload_db = stdpar_tls_runtime::get().get_offload_db();
-    stdpar_tls_runtime::get().instrument_offloaded_operation(_hash, _problem_size);
+    stdpar_tls_runtime::get().instrument_offloaded_operation(
+        _hash, _problem_size,
+        offload_heuristic_state::get().take_pending_migration());
 
     return f();
   }
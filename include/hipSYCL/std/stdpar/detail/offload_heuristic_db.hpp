@@ -11,6 +11,8 @@
 #ifndef HIPSYCL_PSTL_OFFLOAD_HEURISTIC_HPP
 #define HIPSYCL_PSTL_OFFLOAD_HEURISTIC_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -64,6 +66,7 @@ struct count_if{};
 struct mismatch{};
 struct equal {};
 struct sort {};
+struct stable_sort {};
 struct is_sorted {};
 struct is_sorted_until {};
 struct merge {};
@@ -108,6 +111,14 @@ public:
       std::string line;
       while(std::getline(f, line)) {
         std::stringstream sstr{line};
+        if(line.rfind(migration_bandwidth_key, 0) == 0) {
+          std::string key;
+          double bandwidth = 0.0;
+          if((sstr >> key >> bandwidth) && bandwidth > 0.0)
+            _migration_bandwidth = bandwidth;
+          continue;
+        }
+
         uint64_t hash;
         entry e;
         sstr >> hash;
@@ -121,6 +132,7 @@ public:
   ~offload_heuristic_db_storage() {
     std::fstream f{get_dataset_filename().c_str(),
                    std::ios::out | std::ios::trunc};
+    f << migration_bandwidth_key << " " << _migration_bandwidth << "\n";
     for (const auto &entry : _entries) {
       f << entry.first << " ";
       entry.second.write(f);
@@ -136,12 +148,19 @@ public:
     double runtime = std::numeric_limits<double>::max();
     uint64_t num_samples = 0;
 
+    // Existing measurements are weighted as if there were at most
+    // max_merged_samples of them, such that the runtime follows
+    // changes in application behavior.
+    static constexpr uint64_t max_merged_samples = 32;
+
     void merge(const device_entry& other) {
       if(dev == other.dev && problem_size == other.problem_size) {
-        uint64_t aggregated_num_samples = num_samples + other.num_samples;
-        runtime = (num_samples * runtime + other.num_samples * other.runtime) /
-                  aggregated_num_samples;
-        num_samples = aggregated_num_samples;
+        uint64_t weight = std::min(num_samples, max_merged_samples);
+        uint64_t aggregated_weight = weight + other.num_samples;
+        if(aggregated_weight > 0)
+          runtime = (weight * runtime + other.num_samples * other.runtime) /
+                    aggregated_weight;
+        num_samples += other.num_samples;
       }
     }
 
@@ -215,6 +234,16 @@ public:
     return _entries;
   }
 
+  double get_migration_bandwidth() const {
+    std::lock_guard<std::mutex> lock{_lock};
+    return _migration_bandwidth;
+  }
+
+  void set_migration_bandwidth(double bandwidth) {
+    std::lock_guard<std::mutex> lock{_lock};
+    _migration_bandwidth = bandwidth;
+  }
+
   void update_entry_map(const host_malloc_unordered_map<uint64_t, entry>& entry_map) {
     std::lock_guard<std::mutex> lock{_lock};
     for(const auto& e : entry_map) {
@@ -229,6 +258,9 @@ public:
   }
   
 private:
+  // Header line of the dataset file that stores the learned
+  // migration bandwidth; all other lines are entries.
+  static constexpr const char* migration_bandwidth_key = "migration_bandwidth";
 
   static std::string get_dataset_filename() {
     return ".acpp-stdpar-"+get_dataset_name();
@@ -244,6 +276,9 @@ private:
   }
 
   host_malloc_unordered_map<uint64_t, entry> _entries;
+  // In bytes per ns; initially assumes PCIe 4 x16 speeds until
+  // migrations have been measured.
+  double _migration_bandwidth = 32.0;
   mutable std::mutex _lock;
 };
 
@@ -252,10 +287,12 @@ public:
   offload_heuristic_db()
   : _storage{offload_heuristic_db_storage::get()} {
     _entries = _storage->get_entries();
+    _migration_bandwidth = _storage->get_migration_bandwidth();
   }
 
   ~offload_heuristic_db() {
     _storage->update_entry_map(_entries);
+    _storage->set_migration_bandwidth(_migration_bandwidth);
   }
 
   using device_t = offload_heuristic_db_storage::device_t;
@@ -335,6 +372,44 @@ public:
     return result;
   }
 
+  /// Whether there is a measurement for the device with a problem size
+  /// that differs at most by the relative tolerance from \c problem_size.
+  bool has_sample_near(uint64_t op_hash, std::size_t problem_size, device_t dev,
+                       double tolerance = 0.25) const {
+    auto it = _entries.find(op_hash);
+    if(it == _entries.end())
+      return false;
+
+    for(auto& e : it->second.entries) {
+      if(e.dev == dev && e.is_sampled()) {
+        double delta = std::abs(static_cast<double>(e.problem_size) -
+                                static_cast<double>(problem_size));
+        if(delta <= tolerance * static_cast<double>(problem_size))
+          return true;
+      }
+    }
+    return false;
+  }
+
+  /// Estimated bandwidth of page migrations between host and device in bytes
+  /// per ns.
+  double get_migration_bandwidth() const {
+    return _migration_bandwidth;
+  }
+
+  /// Takes into account a measured migration of \c num_bytes which
+  /// took \c time ns.
+  void update_migration_bandwidth(std::size_t num_bytes, double time) {
+    if(num_bytes == 0 || time <= 0.0)
+      return;
+    double measured_bandwidth = static_cast<double>(num_bytes) / time;
+    // Exponential moving average, so that outliers due to inaccurate
+    // estimates of the compute time do not dominate.
+    constexpr double alpha = 0.25;
+    _migration_bandwidth =
+        alpha * measured_bandwidth + (1.0 - alpha) * _migration_bandwidth;
+  }
+
   void update_entry(uint64_t op_hash, std::size_t problem_size, device_t dev, double runtime) {
 
     uint64_t& op_invocation_count = _kernel_invocation_counts[op_hash];
@@ -358,14 +433,39 @@ public:
       }
     }
 
+    // Limit the number of problem sizes per device. If the input sizes of
+    // the application drift, forget the measurements furthest away from the
+    // current problem size.
+    std::size_t num_device_entries = 0;
+    auto furthest = e.entries.end();
+    uint64_t furthest_delta = 0;
+    for(auto it = e.entries.begin(); it != e.entries.end(); ++it) {
+      if(it->dev == dev) {
+        ++num_device_entries;
+        uint64_t delta = it->problem_size > problem_size
+                             ? it->problem_size - problem_size
+                             : problem_size - it->problem_size;
+        if(furthest == e.entries.end() || delta > furthest_delta) {
+          furthest = it;
+          furthest_delta = delta;
+        }
+      }
+    }
+    if(num_device_entries >= max_problem_sizes_per_device &&
+       furthest != e.entries.end())
+      e.entries.erase(furthest);
+
     e.entries.push_back(d_entry);
   }
 
 
 private:
+  static constexpr std::size_t max_problem_sizes_per_device = 64;
+
   std::shared_ptr<offload_heuristic_db_storage> _storage;
   host_malloc_unordered_map<uint64_t, offload_heuristic_db_storage::entry>
       _entries;
+  double _migration_bandwidth;
   host_malloc_unordered_map<uint64_t, uint64_t> _kernel_invocation_counts;
 };
 
@@ -213,6 +213,7 @@ private:
   std::vector<uint64_t, libc_allocator<uint64_t>> _instrumented_ops_in_batch;
   std::vector<std::size_t, libc_allocator<std::size_t>> _instrumented_op_problem_sizes_in_batch;
   uint64_t _batch_start_timestamp = 0;
+  std::size_t _migrated_bytes_in_batch = 0;
 
   scheduling_monitor _scheduling_monitor;
 
@@ -256,11 +257,15 @@ public:
     ++_outstanding_offloaded_operations;
   }
 
-  void instrument_offloaded_operation(uint64_t op_hash, std::size_t problem_size) {
+  // migrated_bytes is the amount of data that is expected to be migrated
+  // to the device for this operation.
+  void instrument_offloaded_operation(uint64_t op_hash, std::size_t problem_size,
+                                      std::size_t migrated_bytes = 0) {
     if(_outstanding_offloaded_operations == 0)
       _batch_start_timestamp = get_time_now();
     _instrumented_ops_in_batch.push_back(op_hash);
     _instrumented_op_problem_sizes_in_batch.push_back(problem_size);
+    _migrated_bytes_in_batch += migrated_bytes;
   }
 
   std::size_t get_current_offloading_batch_id() const {
@@ -302,20 +307,55 @@ public:
   void finalize_offloading_batch() noexcept {
 #ifndef __ACPP_STDPAR_UNCONDITIONAL_OFFLOAD__
     uint64_t batch_end = get_time_now();
-    double mean_time = static_cast<double>(batch_end - _batch_start_timestamp) /
-                       _instrumented_ops_in_batch.size();
+    double batch_time = static_cast<double>(batch_end - _batch_start_timestamp);
     
     assert(_instrumented_ops_in_batch.size() ==
            _instrumented_op_problem_sizes_in_batch.size());
-    
-    for(std::size_t i = 0; i < _instrumented_ops_in_batch.size(); ++i) {
-      std::size_t problem_size = _instrumented_op_problem_sizes_in_batch[i];
-      _offload_db.update_entry(_instrumented_ops_in_batch[i], problem_size,
-                               offload_heuristic_db::offload_device_id,
-                               mean_time);
+
+    bool update_entries = !_instrumented_ops_in_batch.empty();
+    if(update_entries && _migrated_bytes_in_batch > 0) {
+      // If we know how long the operations take without migrations,
+      // the remaining time was spent migrating data. Otherwise, use
+      // the current bandwidth estimate to obtain measurements for the
+      // operations.
+      bool are_all_ops_known = true;
+      double compute_time_estimate = 0.0;
+      for(std::size_t i = 0; i < _instrumented_ops_in_batch.size(); ++i) {
+        uint64_t op_hash = _instrumented_ops_in_batch[i];
+        std::size_t problem_size = _instrumented_op_problem_sizes_in_batch[i];
+        if (!_offload_db.has_sample_near(
+                op_hash, problem_size,
+                offload_heuristic_db::offload_device_id)) {
+          are_all_ops_known = false;
+          break;
+        }
+        compute_time_estimate += _offload_db.estimate_runtime(
+            op_hash, problem_size, offload_heuristic_db::offload_device_id);
+      }
+
+      if(are_all_ops_known) {
+        _offload_db.update_migration_bandwidth(
+            _migrated_bytes_in_batch, batch_time - compute_time_estimate);
+        update_entries = false;
+      } else {
+        batch_time -= _migrated_bytes_in_batch /
+                      _offload_db.get_migration_bandwidth();
+        update_entries = batch_time > 0.0;
+      }
+    }
+
+    if(update_entries) {
+      double mean_time = batch_time / _instrumented_ops_in_batch.size();
+      for(std::size_t i = 0; i < _instrumented_ops_in_batch.size(); ++i) {
+        std::size_t problem_size = _instrumented_op_problem_sizes_in_batch[i];
+        _offload_db.update_entry(_instrumented_ops_in_batch[i], problem_size,
+                                 offload_heuristic_db::offload_device_id,
+                                 mean_time);
+      }
     }
     _instrumented_ops_in_batch.clear();
     _instrumented_op_problem_sizes_in_batch.clear();
+    _migrated_bytes_in_batch = 0;
 #endif
     _dependencies_in_batch.clear();
     _scheduling_monitor.finalize_batch();
@@ -400,6 +440,7 @@ public:
   memory_pool(std::size_t size)
       : _pool_size{size}, _pool{nullptr},
         _free_space_map{size > 0 ? size : 1024},
+        _slab_allocator{&claim_slab, this},
         _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))} {
     init();
   }
@@ -408,35 +449,21 @@ public:
     if(_pool_size == 0)
       return nullptr;
 
-    if(size < _page_size)
-      size = _page_size;
-
-    uint64_t address = 0;
-    if(_free_space_map.claim(size, address)) {
-      
-      void* ptr = static_cast<void*>((char*)_base_address + address);
-      assert(is_from_pool(ptr));
-      assert(is_from_pool((char*)ptr+size));
-      assert((uint64_t)ptr % _page_size == 0);
-
-      // Inform the runtime that there is a new user allocation
-      // by invoking the runtime hook. We need to do this manually
-      // because memory pool directly uses raw backend allocation commands.
-      rt::application::event_handler_layer().on_new_allocation(
-          ptr, size,
-          rt::allocation_info{_dev,
-                              rt::allocation_info::allocation_type::shared});
-
-      return ptr;
-    }
+    if(slab_allocator::is_small(size))
+      return _slab_allocator.allocate(size);
 
-    return nullptr;
+    return claim_pages(size);
   }
 
   void release(void* ptr, std::size_t size) {
     if(_pool && is_from_pool(ptr)) {
+      if(slab_allocator::is_small(size)) {
+        _slab_allocator.deallocate(ptr, size);
+        return;
+      }
+
       uint64_t address = reinterpret_cast<uint64_t>(ptr)-reinterpret_cast<uint64_t>(_base_address);
-      _free_space_map.release(address, size);
+      _free_space_map.release(address, std::max(size, _page_size));
 
       rt::application::event_handler_layer().on_deallocation(ptr);
     }
@@ -460,6 +487,39 @@ public:
   }
 private:
 
+  // Slabs are registered with the runtime as a whole, so that
+  // small objects do not need to be registered individually.
+  static void* claim_slab(void* pool) {
+    return static_cast<memory_pool *>(pool)->claim_pages(
+        slab_allocator::slab_size);
+  }
+
+  void* claim_pages(std::size_t size) {
+    if(size < _page_size)
+      size = _page_size;
+
+    uint64_t address = 0;
+    if(_free_space_map.claim(size, address)) {
+      
+      void* ptr = static_cast<void*>((char*)_base_address + address);
+      assert(is_from_pool(ptr));
+      assert(is_from_pool((char*)ptr+size));
+      assert((uint64_t)ptr % _page_size == 0);
+
+      // Inform the runtime that there is a new user allocation
+      // by invoking the runtime hook. We need to do this manually
+      // because memory pool directly uses raw backend allocation commands.
+      rt::application::event_handler_layer().on_new_allocation(
+          ptr, size,
+          rt::allocation_info{_dev,
+                              rt::allocation_info::allocation_type::shared});
+
+      return ptr;
+    }
+
+    return nullptr;
+  }
+
   void* raw_malloc_shared(std::size_t bytes, sycl::queue& q) {
     auto *allocator = sycl::detail::select_usm_allocator(q.get_context(),
                                                          q.get_device());
@@ -489,6 +549,7 @@ private:
   void* _pool;
   void* _base_address;
   free_space_map _free_space_map;
+  slab_allocator _slab_allocator;
   std::size_t _page_size;
   rt::device_id _dev;
 };
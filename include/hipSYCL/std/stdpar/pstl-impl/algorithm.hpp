@@ -1455,7 +1455,11 @@ template <class RandomIt>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
                                         RandomIt last) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last);
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::sort(queue, scratch_group, first, last);
   };
 
   auto fallback = [&](){
@@ -1475,7 +1479,11 @@ template <class RandomIt, class Compare>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
                                         RandomIt last, Compare comp) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last, comp);
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::sort(queue, scratch_group, first, last, comp);
   };
 
   auto fallback = [&]() {
@@ -1491,6 +1499,54 @@ HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
 }
 
 
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq, RandomIt first,
+                                           RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::stable_sort(queue, scratch_group, first, last);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_unseq_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq, RandomIt first,
+                                           RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::stable_sort(queue, scratch_group, first, last, comp);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_unseq_host_fallback, first, last, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+
 template<class ForwardIt>
 HIPSYCL_STDPAR_ENTRYPOINT bool is_sorted(hipsycl::stdpar::par_unseq, ForwardIt first,
                                          ForwardIt last) {
@@ -3329,7 +3385,11 @@ template <class RandomIt>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
                                         RandomIt last) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last);
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::sort(queue, scratch_group, first, last);
   };
 
   auto fallback = [&](){
@@ -3348,7 +3408,11 @@ template <class RandomIt, class Compare>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
                                     RandomIt last, Compare comp) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last, comp);
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::sort(queue, scratch_group, first, last, comp);
   };
 
   auto fallback = [&]() {
@@ -3363,6 +3427,54 @@ HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par, RandomIt first,
+                                           RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::stable_sort(queue, scratch_group, first, last);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par, RandomIt first,
+                                           RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>();
+    hipsycl::algorithms::stable_sort(queue, scratch_group, first, last, comp);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_host_fallback, first, last, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
 template<class ForwardIt>
 HIPSYCL_STDPAR_ENTRYPOINT bool is_sorted(hipsycl::stdpar::par, ForwardIt first,
                                          ForwardIt last) {
@@ -45,6 +45,16 @@ inline rt::device_id get_host_device() {
 
 rt::device_id extract_rt_device(const device&);
 
+// Used to avoid starting backends that cannot contain the devices
+// that are looked for.
+inline bool backend_may_provide_cpus(rt::backend_id b) {
+  return b == rt::backend_id::omp || b == rt::backend_id::ocl;
+}
+
+inline bool backend_may_provide_non_cpus(rt::backend_id b) {
+  return b != rt::backend_id::omp;
+}
+
 }
 
 class platform;
@@ -205,36 +215,7 @@ public:
   }
 
   static std::vector<device>
-  get_devices(info::device_type deviceType = info::device_type::all) {
-
-    std::vector<device> result;
-    rt::runtime_keep_alive_token requires_runtime;
-
-    requires_runtime.get()->backends().for_each_backend(
-        [&](rt::backend *b) {
-          rt::backend_descriptor bd = b->get_backend_descriptor();
-          std::size_t num_devices =
-              b->get_hardware_manager()->get_num_devices();
-
-          for (std::size_t dev = 0; dev < num_devices; ++dev) {
-            rt::device_id d_id{bd, static_cast<int>(dev)};
-
-            device d{d_id};
-
-            if (deviceType == info::device_type::all ||
-                (deviceType == info::device_type::accelerator &&
-                 d.is_accelerator()) ||
-                (deviceType == info::device_type::cpu && d.is_cpu()) ||
-                (deviceType == info::device_type::host && d.is_cpu()) ||
-                (deviceType == info::device_type::gpu && d.is_gpu())) {
-
-              result.push_back(d);
-            }
-          }
-        });
-
-    return result;
-  }
+  get_devices(info::device_type deviceType = info::device_type::all);
 
   static int get_num_devices() {
     return get_devices(info::device_type::all).size();
@@ -293,6 +274,61 @@ private:
   }
 };
 
+namespace detail {
+
+/// Returns the devices of the given type from all backends for which
+/// \c backend_filter returns true. Other backends are not started.
+template<class BackendFilter>
+std::vector<device> get_devices(info::device_type deviceType,
+                                BackendFilter backend_filter) {
+  std::vector<device> result;
+  rt::runtime_keep_alive_token requires_runtime;
+
+  auto may_provide_device_type = [&](rt::backend_id b) {
+    if (deviceType == info::device_type::cpu ||
+        deviceType == info::device_type::host)
+      return backend_may_provide_cpus(b);
+    if (deviceType == info::device_type::gpu ||
+        deviceType == info::device_type::accelerator)
+      return backend_may_provide_non_cpus(b);
+    return true;
+  };
+
+  requires_runtime.get()->backends().for_each_backend_if(
+      [&](rt::backend_id b) {
+        return may_provide_device_type(b) && backend_filter(b);
+      },
+      [&](rt::backend *b) {
+        rt::backend_descriptor bd = b->get_backend_descriptor();
+        std::size_t num_devices =
+            b->get_hardware_manager()->get_num_devices();
+
+        for (std::size_t dev = 0; dev < num_devices; ++dev) {
+          rt::device_id d_id{bd, static_cast<int>(dev)};
+
+          device d{d_id};
+
+          if (deviceType == info::device_type::all ||
+              (deviceType == info::device_type::accelerator &&
+               d.is_accelerator()) ||
+              (deviceType == info::device_type::cpu && d.is_cpu()) ||
+              (deviceType == info::device_type::host && d.is_cpu()) ||
+              (deviceType == info::device_type::gpu && d.is_gpu())) {
+
+            result.push_back(d);
+          }
+        }
+      });
+
+  return result;
+}
+
+}
+
+inline std::vector<device> device::get_devices(info::device_type deviceType) {
+  return detail::get_devices(deviceType, [](rt::backend_id) { return true; });
+}
+
 HIPSYCL_SPECIALIZE_GET_INFO(device, device_type) {
   if (this->is_cpu())
     return info::device_type::cpu;
@@ -60,6 +60,17 @@ struct selector_traits<multi_device_selector<Selector, P>>{
   static constexpr selection_policy policy = P;
 };
 
+/// Backends are only started for device selection if the selector
+/// might choose one of their devices.
+template<class Selector>
+struct selector_backends {
+  static bool may_select(rt::backend_id) { return true; }
+};
+
+template<class Selector, selection_policy P>
+struct selector_backends<multi_device_selector<Selector, P>>
+    : public selector_backends<Selector> {};
+
 
 inline int select_gpu(const device& dev) {
   if (dev.is_gpu()) {
@@ -199,6 +210,63 @@ public:
 };
 
 
+namespace detail {
+
+template<>
+struct selector_backends<gpu_selector> {
+  static bool may_select(rt::backend_id b) {
+    return backend_may_provide_non_cpus(b);
+  }
+};
+
+template<>
+struct selector_backends<accelerator_selector> {
+  static bool may_select(rt::backend_id b) {
+    return backend_may_provide_non_cpus(b);
+  }
+};
+
+template<>
+struct selector_backends<cpu_selector> {
+  static bool may_select(rt::backend_id b) {
+    return backend_may_provide_cpus(b);
+  }
+};
+
+template<>
+struct selector_backends<host_selector> {
+  static bool may_select(rt::backend_id b) {
+    return b == rt::backend_id::omp;
+  }
+};
+
+// Mirrors select_default() and device::AdaptiveCpp_has_compiled_kernels()
+template<>
+struct selector_backends<default_selector> {
+  static bool may_select(rt::backend_id b) {
+#if defined(__ACPP_ENABLE_LLVM_SSCP_TARGET__)
+    return true;
+#elif defined(__ACPP_ENABLE_CUDA_TARGET__) ||                               \
+    defined(__ACPP_ENABLE_HIP_TARGET__)
+    if(backend_may_provide_cpus(b))
+      return true;
+#if defined(__ACPP_ENABLE_CUDA_TARGET__)
+    if(b == rt::backend_id::cuda)
+      return true;
+#endif
+#if defined(__ACPP_ENABLE_HIP_TARGET__)
+    if(b == rt::backend_id::hip)
+      return true;
+#endif
+    return false;
+#else
+    return b == rt::backend_id::omp;
+#endif
+  }
+};
+
+}
+
 inline constexpr default_selector default_selector_v;
 inline constexpr cpu_selector cpu_selector_v;
 inline constexpr gpu_selector gpu_selector_v;
@@ -282,9 +350,12 @@ std::vector<device> select_devices(const Selector &s) {
       return select_devices(multi_gpu_selector_v);
   }
 
-  auto devices = device::get_devices();
-  // There should always be at least a CPU device
-  assert(devices.size() > 0);
+  auto devices = get_devices(info::device_type::all, [](rt::backend_id b) {
+    return selector_backends<Selector>::may_select(b);
+  });
+  if (devices.empty()) {
+    throw exception{make_error_code(errc::runtime), "No matching device"};
+  }
   std::vector<int> dev_indices(devices.size());
   std::vector<int> dev_scores(devices.size());
 
@@ -29,6 +29,7 @@ namespace sycl {
 
 class event {
   friend class handler;
+  friend class queue;
 public:
   event()
   {}
@@ -79,6 +79,7 @@
 #define ACPP_EXT_RESTRICT_PTR
 #define ACPP_EXT_JIT_COMPILE_IF
 #define ACPP_EXT_TARGET_NUMA_NODE_PROPERTY
+#define ACPP_EXT_RECORDED_GRAPHS
 
 // KHR extensions
 
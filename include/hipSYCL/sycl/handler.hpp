@@ -913,6 +913,11 @@ private:
                   "Overload resolution should never pick this overload without "
                   "reductions");
 
+    if(_is_recording || _is_capture_only)
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "handler: Reductions cannot be used in recorded "
+                      "command groups"};
+
     if constexpr(KernelType == rt::kernel_type::ndrange_parallel_for) {
       _command_group_nodes.push_back(
           submit_ndrange_reduction_kernel<KernelName>(global_range, local_range,
@@ -1186,6 +1191,18 @@ private:
         has_non_instant_dependency = true;
     }
     
+    if((_is_recording || _is_capture_only) &&
+       (uses_buffers || op->is_requirement()))
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "handler: Buffers cannot be used in recorded command "
+                      "groups"};
+
+    if(_is_capture_only) {
+      // The operation is only stored in the node, and will be
+      // submitted when replaying a recorded graph.
+      return rt::make_dag_node(hints, rt::node_list_t{}, std::move(op), _rt);
+    }
+
     bool is_dedicated_in_order_queue = false;
     rt::backend_executor* executor = nullptr;
     if(hints.has_hint<rt::hints::prefer_executor>()) {
@@ -1205,7 +1222,7 @@ private:
       return build.builder()->add_command_group(std::move(op), requirements, hints);
     } else {
 
-      rt::dag_node_ptr node = std::make_shared<rt::dag_node>(
+      rt::dag_node_ptr node = rt::make_dag_node(
           hints, requirements.get(), std::move(op), _rt);
       node->assign_to_device(
           hints.get_hint<rt::hints::bind_to_device>()->get_device_id());
@@ -1240,6 +1257,11 @@ private:
   rt::runtime* _rt;
 
   bool _contains_non_instant_nodes = false;
+  // Set by the queue while recording a graph
+  bool _is_recording = false;
+  // Operations are created but not submitted, used to update
+  // operations of recorded graphs
+  bool _is_capture_only = false;
 
   algorithms::util::allocation_cache* _allocation_cache;
 
@@ -130,7 +130,7 @@ inline sycl::event make_event(hipsycl::rt::pcuda::event* evt) {
 
   auto op = std::make_unique<rt::kernel_operation>(
       "<no-op>", rt::kernel_launcher({}, {}), rt::requirements_list{acpp_rt});
-  rt::dag_node_ptr node = std::make_shared<rt::dag_node>(
+  rt::dag_node_ptr node = rt::make_dag_node(
       rt::execution_hints{}, rt::node_list_t{}, std::move(op),
       acpp_rt);
   node->assign_to_device(evt->get_device());
@@ -32,6 +32,7 @@
 #include "context.hpp"
 #include "event.hpp"
 #include "handler.hpp"
+#include "recorded_graph.hpp"
 #include "info/info.hpp"
 #include "detail/function_set.hpp"
 
@@ -162,6 +163,10 @@ class queue : public detail::property_carrying_object
     std::shared_ptr<rt::kernel_cache> kernel_cache;
     // For non-emulated in-order queues only
     std::atomic<bool> has_non_instant_operations = false;
+
+    // Nodes submitted since AdaptiveCpp_begin_recording()
+    bool is_recording = false;
+    rt::node_list_t recorded_nodes;
   };
 
   template<typename, int, access::mode, access::target>
@@ -449,6 +454,7 @@ public:
     apply_preferred_group_size<1>(prop_list, cgh);
     apply_preferred_group_size<2>(prop_list, cgh);
     apply_preferred_group_size<3>(prop_list, cgh);
+    cgh._is_recording = _impl->is_recording;
 
     this->get_hooks()->run_all(cgh);
 
@@ -1061,6 +1067,144 @@ public:
   }
 
 
+  /// Starts recording all subsequent submissions to this queue. The
+  /// submissions are executed as usual. They must not use buffers or
+  /// reductions.
+  void AdaptiveCpp_begin_recording() {
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    if(_impl->is_recording)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Recording has already been started"};
+    _impl->is_recording = true;
+    _impl->recorded_nodes.clear();
+  }
+
+  /// Stops recording, and returns a graph of the operations submitted
+  /// since AdaptiveCpp_begin_recording(). The graph remembers the device,
+  /// execution lane and dependencies of each operation.
+  AdaptiveCpp_recorded_graph AdaptiveCpp_end_recording() {
+    rt::node_list_t nodes;
+    {
+      std::lock_guard<std::mutex> lock{_impl->lock};
+      if(!_impl->is_recording)
+        throw exception{make_error_code(errc::invalid),
+                        "queue: Recording has not been started"};
+      _impl->is_recording = false;
+      nodes = std::move(_impl->recorded_nodes);
+      _impl->recorded_nodes.clear();
+    }
+
+    // Scheduling decisions are only available once nodes are submitted
+    for(const auto& node : nodes) {
+      if(!node->is_submitted()) {
+        _impl->requires_runtime.get()->dag().flush_and_gc();
+        break;
+      }
+    }
+
+    std::shared_ptr<rt::recorded_graph> graph;
+    auto err = rt::recorded_graph::create(nodes, graph);
+    if(!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+    return AdaptiveCpp_recorded_graph{graph};
+  }
+
+  /// Submits all operations of a recorded graph. Operations that
+  /// depended on operations outside of the graph during recording
+  /// instead depend on \c deps and, for in-order queues, on the previous
+  /// submission.
+  event AdaptiveCpp_replay(const AdaptiveCpp_recorded_graph &graph,
+                           const std::vector<event> &deps = {}) {
+    if(!graph._graph)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Attempted to replay invalid recorded graph"};
+
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    if(_impl->is_recording)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Recorded graphs cannot be replayed "
+                      "while recording"};
+
+    rt::node_list_t external_deps;
+    for(const auto& dep : deps)
+      if(dep._node)
+        external_deps.push_back(dep._node);
+    if(is_in_order() && _impl->needs_in_order_emulation &&
+       _impl->previous_submission)
+      external_deps.push_back(_impl->previous_submission);
+
+    rt::node_list_t nodes;
+    auto err = graph._graph->replay(external_deps, _impl->node_group_id,
+                                    _impl->requires_runtime.get(), nodes);
+    if(!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+    if(nodes.empty())
+      return event{};
+
+    rt::dag_node_ptr result;
+    const auto& sinks = graph._graph->get_sink_indices();
+    if(sinks.size() == 1) {
+      result = nodes[sinks.front()];
+    } else if(is_in_order() && !_impl->needs_in_order_emulation) {
+      // All operations were submitted to the same in-order lane
+      result = nodes.back();
+    } else {
+      // Join the sinks so that a single event can be returned.
+      handler cgh{get_context(),
+                  _impl->handler,
+                  _impl->default_hints,
+                  _impl->requires_runtime.get(),
+                  &(_impl->allocation_cache),
+                  &(_impl->most_recent_reduction_kernel)};
+      for(std::size_t sink : sinks)
+        cgh.depends_on(event{nodes[sink], _impl->handler});
+      cgh.AdaptiveCpp_enqueue_custom_operation([](auto&){});
+      result = extract_dag_node(cgh);
+    }
+
+    if(is_in_order() && _impl->needs_in_order_emulation)
+      _impl->previous_submission = result;
+    return event{result, _impl->handler};
+  }
+
+  /// Replaces the operation with the given index in a recorded graph by the
+  /// operation that the command group \c cgf creates. The command group is
+  /// not executed; the new operation will be used by subsequent replays.
+  /// This can be used to change kernel arguments between replays.
+  template <class Cgf>
+  void AdaptiveCpp_update_recorded_operation(AdaptiveCpp_recorded_graph &graph,
+                                             std::size_t index, Cgf cgf) {
+    if(!graph._graph)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Attempted to update invalid recorded graph"};
+    if(!_impl->default_hints.has_hint<rt::hints::bind_to_device>())
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "queue: Updating recorded graphs requires queues "
+                      "bound to a single device"};
+
+    // Like submissions, hold the queue lock while the command group is
+    // evaluated; the graph itself is locked while the operation is replaced.
+    std::lock_guard<std::mutex> lock{_impl->lock};
+
+    handler cgh{get_context(),
+                _impl->handler,
+                _impl->default_hints,
+                _impl->requires_runtime.get(),
+                &(_impl->allocation_cache),
+                &(_impl->most_recent_reduction_kernel)};
+    cgh._is_capture_only = true;
+    cgf(cgh);
+
+    if(cgh.get_cg_nodes().size() != 1)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Command group used to update a recorded graph "
+                      "must contain exactly one operation"};
+
+    auto err = graph._graph->update_operation(index, cgh.get_cg_nodes().front());
+    if(!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+  }
+
   [[deprecated("Use AdaptiveCpp_hash_code()")]]
   auto hipSYCL_hash_code() const {
     return AdaptiveCpp_hash_code();
@@ -1108,6 +1252,10 @@ private:
     cgf(cgh);
 
     rt::dag_node_ptr node = this->extract_dag_node(cgh);
+    if(_impl->is_recording) {
+      for(const auto& n : cgh.get_cg_nodes())
+        _impl->recorded_nodes.push_back(n);
+    }
     if (is_in_order()) {
       if(_impl->needs_in_order_emulation) {
         _impl->previous_submission = node;
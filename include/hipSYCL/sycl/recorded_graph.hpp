@@ -0,0 +1,62 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SYCL_RECORDED_GRAPH_HPP
+#define HIPSYCL_SYCL_RECORDED_GRAPH_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include "hipSYCL/runtime/recorded_graph.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+class queue;
+
+/// Operations recorded by a queue between
+/// queue::AdaptiveCpp_begin_recording() and queue::AdaptiveCpp_end_recording(),
+/// which can be replayed using queue::AdaptiveCpp_replay().
+class AdaptiveCpp_recorded_graph {
+  friend class queue;
+public:
+  AdaptiveCpp_recorded_graph() = default;
+
+  /// Number of recorded operations
+  std::size_t size() const {
+    if(!_graph)
+      return 0;
+    return _graph->get_num_operations();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  friend bool operator==(const AdaptiveCpp_recorded_graph &lhs,
+                         const AdaptiveCpp_recorded_graph &rhs) {
+    return lhs._graph == rhs._graph;
+  }
+
+  friend bool operator!=(const AdaptiveCpp_recorded_graph &lhs,
+                         const AdaptiveCpp_recorded_graph &rhs) {
+    return !(lhs == rhs);
+  }
+private:
+  AdaptiveCpp_recorded_graph(std::shared_ptr<rt::recorded_graph> graph)
+  : _graph{graph} {}
+
+  std::shared_ptr<rt::recorded_graph> _graph;
+};
+
+}
+}
+
+#endif
@@ -10,11 +10,17 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/config.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <random>
 #include <type_traits>
 
+#include HIPSYCL_CXX_FILESYSTEM_HEADER
+
 namespace hipsycl::common::db {
 
 namespace {
@@ -67,8 +73,7 @@ void kernel_entry::dump(std::ostream& ostr, int indentation_level) const {
 }
 
 void binary_entry::dump(std::ostream& ostr, int indentation_level) const {
-  print_key_value_pair(ostr, "jit_cache_filename", jit_cache_filename,
-                       indentation_level);
+  print_key_value_pair(ostr, "last_used", last_used, indentation_level);
 }
 
 void scheduling_object_entry::dump(std::ostream& ostr, int indentation_level) const {
@@ -76,6 +81,11 @@ void scheduling_object_entry::dump(std::ostream& ostr, int indentation_level) co
                        is_free_of_indirect_access, indentation_level);
 }
 
+void transfer_link_entry::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "latency_ns", latency_ns, indentation_level);
+  print_key_value_pair(ostr, "bytes_per_sec", bytes_per_sec, indentation_level);
+}
+
 void appdb_data::dump(std::ostream& ostr, int indentation_level) const {
   print_key_value_pair(ostr, "content_version", content_version, indentation_level);
   
@@ -109,38 +119,366 @@ void appdb_data::dump(std::ostream& ostr, int indentation_level) const {
     print_key_value_pair(ostr, obj_name, "<scheduling-object-entry>", indentation_level+1);
     entry.second.dump(ostr, indentation_level+2);
   }
+
+  print_key_value_pair(ostr, "transfer_links", "<map>", indentation_level);
+
+  for(const auto& entry : transfer_links) {
+    print_key_value_pair(ostr, entry.first, "<transfer-link-entry>", indentation_level+1);
+    entry.second.dump(ostr, indentation_level+2);
+  }
+}
+
+namespace {
+
+// "ACPPJRNL"
+constexpr uint64_t journal_magic = 0x4c4e524a50504341ull;
+// Number of journal records after which the journal is merged
+// into the snapshot
+constexpr std::size_t max_journal_records = 64;
+
+std::string get_journal_path(const std::string& db_path) {
+  return db_path + ".journal";
+}
+
+std::string get_lock_path(const std::string& db_path) {
+  return db_path + ".lock";
+}
+
+bool read_file(const std::string& path, std::vector<uint8_t>& out) {
+  std::ifstream file{path, std::ios::in | std::ios::binary | std::ios::ate};
+  if (!file.is_open())
+    return false;
+  std::streamsize file_size = file.tellg();
+
+  file.seekg(0, std::ios::beg);
+
+  out.resize(file_size);
+  file.read(reinterpret_cast<char *>(out.data()), file_size);
+  return static_cast<bool>(file);
+}
+
+bool read_uint64(const std::vector<uint8_t>& data, std::size_t& pos, uint64_t& out) {
+  if(data.size() - pos < sizeof(uint64_t))
+    return false;
+  std::memcpy(&out, data.data() + pos, sizeof(uint64_t));
+  pos += sizeof(uint64_t);
+  return true;
+}
+
+void write_uint64(std::string& out, uint64_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+}
+
+std::string serialize_record(appdb_data record) {
+  auto data = msgpack::pack(record);
+  std::string out;
+  write_uint64(out, data.size());
+  out.append(reinterpret_cast<const char*>(data.data()), data.size());
+  return out;
+}
+
+appdb_data load_snapshot(const std::string& db_path) {
+  std::vector<uint8_t> file_content;
+  if(!filesystem::exists(db_path) || !read_file(db_path, file_content))
+    return appdb_data{};
+
+  std::error_code ec;
+  auto data = msgpack::unpack<appdb_data>(file_content, ec);
+  // Start over if the snapshot is corrupted
+  if(ec)
+    return appdb_data{};
+  return data;
+}
+
+struct journal {
+  uint64_t id = 0;
+  std::vector<appdb_data> records;
+  // Size of the part of the file that contains complete records
+  std::size_t valid_size = 0;
+};
+
+// Returns false if there is no journal with a valid header. Incomplete
+// records at the end, as left behind by a process that crashed while
+// appending, are ignored.
+bool load_journal(const std::string& db_path, journal& out) {
+  std::vector<uint8_t> file_content;
+  std::string path = get_journal_path(db_path);
+  if(!filesystem::exists(path) || !read_file(path, file_content))
+    return false;
+
+  std::size_t pos = 0;
+  uint64_t magic = 0;
+  if(!read_uint64(file_content, pos, magic) || magic != journal_magic ||
+     !read_uint64(file_content, pos, out.id))
+    return false;
+
+  out.valid_size = pos;
+  uint64_t record_size = 0;
+  while(read_uint64(file_content, pos, record_size)) {
+    if(file_content.size() - pos < record_size)
+      break;
+    std::error_code ec;
+    auto record = msgpack::unpack<appdb_data>(file_content.data() + pos,
+                                              record_size, ec);
+    if(ec)
+      break;
+    out.records.push_back(std::move(record));
+    pos += record_size;
+    out.valid_size = pos;
+  }
+  return true;
+}
+
+const kernel_arg_value_statistics *
+find_tracked_value(const kernel_entry *entry, std::size_t arg_index,
+                   uint64_t value, bool *was_specialized = nullptr) {
+  if(!entry || arg_index >= entry->kernel_args.size())
+    return nullptr;
+  const auto& arg = entry->kernel_args[arg_index];
+  for(int i = 0; i < kernel_arg_entry::max_tracked_values; ++i) {
+    if(arg.common_values[i].count > 0 && arg.common_values[i].value == value) {
+      if(was_specialized)
+        *was_specialized = arg.was_specialized[i];
+      return &arg.common_values[i];
+    }
+  }
+  return nullptr;
+}
+
+// Determines what has changed in data since it was loaded. The result
+// uses the appdb_data layout, but holds increments instead of absolute
+// values for all counters, and invocation numbers relative to the number of
+// invocations that had been registered at load time.
+appdb_data compute_changes(const appdb_data& data, const appdb_data& loaded) {
+  appdb_data changes;
+
+  for(const auto& [id, entry] : data.kernels) {
+    auto it = loaded.kernels.find(id);
+    const kernel_entry* loaded_entry =
+        (it != loaded.kernels.end()) ? &it->second : nullptr;
+    const uint64_t loaded_invocations =
+        loaded_entry ? loaded_entry->num_registered_invocations : 0;
+
+    kernel_entry delta;
+    delta.num_registered_invocations =
+        entry.num_registered_invocations - loaded_invocations;
+    if(!loaded_entry ||
+       loaded_entry->first_iads_invocation_run == kernel_entry::no_usage)
+      delta.first_iads_invocation_run = entry.first_iads_invocation_run;
+    delta.retained_argument_indices = entry.retained_argument_indices;
+    delta.is_free_of_indirect_access = entry.is_free_of_indirect_access;
+
+    bool has_changed_args = false;
+    delta.kernel_args.resize(entry.kernel_args.size());
+    for(std::size_t i = 0; i < entry.kernel_args.size(); ++i) {
+      for(int j = 0; j < kernel_arg_entry::max_tracked_values; ++j) {
+        const auto& stats = entry.kernel_args[i].common_values[j];
+        const bool was_specialized = entry.kernel_args[i].was_specialized[j];
+        if(stats.count == 0)
+          continue;
+
+        bool loaded_was_specialized = false;
+        const auto* loaded_stats = find_tracked_value(
+            loaded_entry, i, stats.value, &loaded_was_specialized);
+        uint64_t count = stats.count;
+        // The value might have been evicted and tracked again since loading
+        if(loaded_stats && loaded_stats->count <= stats.count)
+          count -= loaded_stats->count;
+        if(count == 0 && was_specialized == loaded_was_specialized)
+          continue;
+
+        auto& delta_stats = delta.kernel_args[i].common_values[j];
+        delta_stats.value = stats.value;
+        delta_stats.count = count;
+        delta_stats.last_used = stats.last_used >= loaded_invocations
+                                    ? stats.last_used - loaded_invocations
+                                    : 0;
+        delta.kernel_args[i].was_specialized[j] = was_specialized;
+        has_changed_args = true;
+      }
+    }
+
+    if (!loaded_entry || has_changed_args || delta.num_registered_invocations > 0 ||
+        delta.first_iads_invocation_run != kernel_entry::no_usage ||
+        entry.retained_argument_indices != loaded_entry->retained_argument_indices ||
+        entry.is_free_of_indirect_access != loaded_entry->is_free_of_indirect_access)
+      changes.kernels[id] = std::move(delta);
+  }
+
+  for(const auto& [id, entry] : data.binaries) {
+    auto it = loaded.binaries.find(id);
+    if(it == loaded.binaries.end() || it->second.last_used != entry.last_used)
+      changes.binaries[id] = entry;
+  }
+
+  for(const auto& [id, entry] : data.scheduling_objects) {
+    auto it = loaded.scheduling_objects.find(id);
+    if (it == loaded.scheduling_objects.end() ||
+        it->second.is_free_of_indirect_access != entry.is_free_of_indirect_access)
+      changes.scheduling_objects[id] = entry;
+  }
+
+  for(const auto& [id, entry] : data.transfer_links) {
+    auto it = loaded.transfer_links.find(id);
+    if (it == loaded.transfer_links.end() ||
+        it->second.latency_ns != entry.latency_ns ||
+        it->second.bytes_per_sec != entry.bytes_per_sec)
+      changes.transfer_links[id] = entry;
+  }
+
+  return changes;
+}
+
+void merge_tracked_value(kernel_arg_entry& arg,
+                         const kernel_arg_value_statistics& delta,
+                         bool was_specialized, uint64_t invocation_offset) {
+  const uint64_t last_used = invocation_offset + delta.last_used;
+
+  int empty_slot = -1;
+  int eviction_candidate = -1;
+  for(int i = 0; i < kernel_arg_entry::max_tracked_values; ++i) {
+    auto& stats = arg.common_values[i];
+    if(stats.count > 0 && stats.value == delta.value) {
+      stats.count += delta.count;
+      stats.last_used = std::max(stats.last_used, last_used);
+      arg.was_specialized[i] = arg.was_specialized[i] || was_specialized;
+      return;
+    } else if(stats.count == 0) {
+      empty_slot = i;
+    } else if (!arg.was_specialized[i] &&
+               (eviction_candidate < 0 ||
+                stats.last_used < arg.common_values[eviction_candidate].last_used)) {
+      eviction_candidate = i;
+    }
+  }
+
+  int slot = empty_slot;
+  // Same policy as during regular operation: Replace the least recently
+  // used value that has not led to specialization.
+  if (slot < 0 && eviction_candidate >= 0 &&
+      arg.common_values[eviction_candidate].last_used < last_used)
+    slot = eviction_candidate;
+
+  if(slot >= 0) {
+    arg.common_values[slot] = delta;
+    arg.common_values[slot].last_used = last_used;
+    arg.was_specialized[slot] = was_specialized;
+  }
+}
+
+// Applies the result of compute_changes() of one application run
+void apply_changes(appdb_data& data, const appdb_data& changes) {
+  for(const auto& [id, delta] : changes.kernels) {
+    auto& entry = data.kernels[id];
+    const uint64_t invocation_offset = entry.num_registered_invocations;
+
+    if(entry.first_iads_invocation_run == kernel_entry::no_usage)
+      entry.first_iads_invocation_run = delta.first_iads_invocation_run;
+    if(!delta.retained_argument_indices.empty())
+      entry.retained_argument_indices = delta.retained_argument_indices;
+    entry.is_free_of_indirect_access = delta.is_free_of_indirect_access;
+
+    if(entry.kernel_args.size() < delta.kernel_args.size())
+      entry.kernel_args.resize(delta.kernel_args.size());
+    for(std::size_t i = 0; i < delta.kernel_args.size(); ++i) {
+      for(int j = 0; j < kernel_arg_entry::max_tracked_values; ++j) {
+        const auto& stats = delta.kernel_args[i].common_values[j];
+        const bool was_specialized = delta.kernel_args[i].was_specialized[j];
+        if(stats.count > 0 || was_specialized)
+          merge_tracked_value(entry.kernel_args[i], stats, was_specialized,
+                              invocation_offset);
+      }
+    }
+    entry.num_registered_invocations += delta.num_registered_invocations;
+  }
+
+  // Binaries were used during the application run that this
+  // record corresponds to.
+  for(const auto& [id, entry] : changes.binaries)
+    data.binaries[id].last_used = data.content_version;
+
+  for(const auto& [id, entry] : changes.scheduling_objects)
+    data.scheduling_objects[id] = entry;
+
+  for(const auto& [id, entry] : changes.transfer_links)
+    data.transfer_links[id] = entry;
+
+  ++data.content_version;
+}
+
 }
 
 appdb::appdb(const std::string& db_path) 
 : _db_path{db_path}, _lock{0}, _was_modified{false} {
 
-  if(filesystem::exists(db_path)) {
-    std::ifstream file{_db_path, std::ios::in | std::ios::binary | std::ios::ate};
-    if (!file.is_open())
-      return;
-    std::streamsize file_size = file.tellg();
-    
-    file.seekg(0, std::ios::beg);
+  filesystem::file_lock lock{get_lock_path(_db_path)};
 
-    std::vector<uint8_t> file_content;
-    file_content.resize(file_size);
-    file.read(reinterpret_cast<char *>(file_content.data()), file_size);
+  _data = load_snapshot(_db_path);
 
-    _data = msgpack::unpack<appdb_data>(file_content);
+  journal j;
+  if(load_journal(_db_path, j) && j.id != _data.compacted_journal_id) {
+    for(const auto& record : j.records)
+      apply_changes(_data, record);
   }
+
+  _loaded_data = _data;
 }
 
 appdb::~appdb() {
   if(_was_modified) {
-    ++_data.content_version;
+    appdb_data changes = compute_changes(_data, _loaded_data);
+
+    filesystem::file_lock lock{get_lock_path(_db_path)};
+    // Needed to detect a stale journal, which can remain if a process
+    // has crashed during compaction.
+    appdb_data snapshot = load_snapshot(_db_path);
+
+    journal j;
+    bool is_journal_valid =
+        load_journal(_db_path, j) && j.id != snapshot.compacted_journal_id;
+
+    std::string journal_path = get_journal_path(_db_path);
+    if (is_journal_valid && j.records.size() + 1 >= max_journal_records) {
+      for(const auto& record : j.records)
+        apply_changes(snapshot, record);
+      apply_changes(snapshot, changes);
+      snapshot.compacted_journal_id = j.id;
 
-    auto data = msgpack::pack(_data);
-    std::string data_string;
-    data_string.resize(data.size());
-    std::memcpy(data_string.data(), data.data(), data.size());
+      auto data = msgpack::pack(snapshot);
+      std::string data_string;
+      data_string.resize(data.size());
+      std::memcpy(data_string.data(), data.data(), data.size());
 
-    common::filesystem::atomic_write(_db_path, data_string);
+      if(common::filesystem::atomic_write(_db_path, data_string))
+        common::filesystem::remove(journal_path);
+    } else if(is_journal_valid) {
+      std::error_code ec;
+      // Drop incomplete records so that they don't hide the new one
+      HIPSYCL_CXX_FILESYSTEM_NAMESPACE::resize_file(journal_path, j.valid_size, ec);
+      std::ofstream file{journal_path,
+                         std::ios::out | std::ios::binary | std::ios::app};
+      std::string record = serialize_record(std::move(changes));
+      file.write(record.data(), record.size());
+    } else {
+      uint64_t journal_id = 0;
+      // 0 is the compacted_journal_id of a new snapshot
+      while(journal_id == 0 || journal_id == snapshot.compacted_journal_id)
+        journal_id = std::random_device{}() ^
+                     (static_cast<uint64_t>(std::random_device{}()) << 32);
+
+      std::string content;
+      write_uint64(content, journal_magic);
+      write_uint64(content, journal_id);
+      content += serialize_record(std::move(changes));
+      common::filesystem::atomic_write(journal_path, content);
+    }
   }
 }
 
-}
\ No newline at end of file
+bool appdb::clear(const std::string& db_path) {
+  filesystem::file_lock lock{get_lock_path(db_path)};
+  common::filesystem::remove(get_journal_path(db_path));
+  return common::filesystem::remove(db_path);
+}
+
+}
@@ -20,9 +20,12 @@
 #include <memory>
 #include <random>
 #include <cassert>
+#include <cerrno>
 
 #ifndef _WIN32
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/file.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -200,6 +203,47 @@ bool remove(const std::string &filename) {
   return false;
 }
 
+file_lock::file_lock(const std::string& filename) {
+#ifndef _WIN32
+  _fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(_fd < 0)
+    return;
+  int ret;
+  do {
+    ret = ::flock(_fd, LOCK_EX);
+  } while(ret != 0 && errno == EINTR);
+  _is_locked = (ret == 0);
+#else
+  HANDLE h = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE,
+                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                         nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(h == INVALID_HANDLE_VALUE)
+    return;
+  _handle = h;
+  OVERLAPPED overlapped = {};
+  _is_locked = LockFileEx(h, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD,
+                          &overlapped) != 0;
+#endif
+}
+
+file_lock::~file_lock() {
+#ifndef _WIN32
+  if(_fd >= 0) {
+    if(_is_locked)
+      ::flock(_fd, LOCK_UN);
+    ::close(_fd);
+  }
+#else
+  if(_handle) {
+    if(_is_locked) {
+      OVERLAPPED overlapped = {};
+      UnlockFileEx(static_cast<HANDLE>(_handle), 0, MAXDWORD, MAXDWORD, &overlapped);
+    }
+    CloseHandle(static_cast<HANDLE>(_handle));
+  }
+#endif
+}
+
 persistent_storage &persistent_storage::get() {
   static persistent_storage t;
   return t;
@@ -58,7 +58,7 @@ void markLoopParallel(llvm::Function &F, llvm::Loop *L) {
 }
 
 void addVectorizationHints(const llvm::Function &F, const llvm::TargetTransformInfo &TTI,
-                           const llvm::Loop *L) {
+                           const llvm::Loop *L, unsigned VectorWidth) {
   llvm::SmallVector<llvm::MDNode *, 3> PostTransformMD;
   // work-item loops should be vectorizable, so emit metadata to suggest so
   if (!llvm::findOptionMDForLoop(L, "llvm.loop.vectorize.enable")) {
@@ -69,8 +69,18 @@ void addVectorizationHints(const llvm::Function &F, const llvm::TargetTransformI
     PostTransformMD.push_back(MDVectorize);
   }
 
+  // a fixed width is required e.g. if the sub-group size is tied to the vector width
+  const bool HasFixedWidth = VectorWidth > 1 && L->getSubLoops().empty();
+  if (HasFixedWidth && !llvm::findOptionMDForLoop(L, "llvm.loop.vectorize.width")) {
+    auto *MDWidth = llvm::MDNode::get(
+        F.getContext(), {llvm::MDString::get(F.getContext(), "llvm.loop.vectorize.width"),
+                         llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(
+                             llvm::IntegerType::get(F.getContext(), 32), VectorWidth))});
+    PostTransformMD.push_back(MDWidth);
+  }
+
   // enable scalable vectorization
-  if (TTI.supportsScalableVectors()) {
+  if (!HasFixedWidth && TTI.supportsScalableVectors()) {
     if (!llvm::findOptionMDForLoop(L, "llvm.loop.vectorize.scalable.enable")) {
       auto *MDVectorize = llvm::MDNode::get(
           F.getContext(),
@@ -89,7 +99,7 @@ void addVectorizationHints(const llvm::Function &F, const llvm::TargetTransformI
 }
 
 bool markLoopsWorkItem(llvm::Function &F, const llvm::LoopInfo &LI,
-                       const llvm::TargetTransformInfo &TTI) {
+                       const llvm::TargetTransformInfo &TTI, unsigned VectorWidth = 0) {
   bool Changed = false;
 
   for (auto *SL : utils::getLoopsInPreorder(LI)) {
@@ -99,7 +109,7 @@ bool markLoopsWorkItem(llvm::Function &F, const llvm::LoopInfo &LI,
 
       markLoopParallel(F, SL);
 
-      addVectorizationHints(F, TTI, SL);
+      addVectorizationHints(F, TTI, SL, VectorWidth);
     }
   }
 
@@ -147,7 +157,7 @@ hipsycl::compiler::LoopsParallelMarkerPass::run(llvm::Function &F,
     return llvm::PreservedAnalyses::all();
   }
   if (SAA->isKernelFunc(&F))
-    markLoopsWorkItem(F, LI, TTI);
+    markLoopsWorkItem(F, LI, TTI, VectorWidth);
 
   return llvm::PreservedAnalyses::all();
 }
@@ -58,7 +58,8 @@ void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM) {
 #define IS_ROCM_CLANG_VERSION_5_5_0
 #endif
 
-void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp) {
+void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp,
+                         unsigned WorkItemLoopVectorWidth) {
   MPM.addPass(SplitterAnnotationAnalysisCacher{});
 
   llvm::FunctionPassManager FPM;
@@ -98,7 +99,7 @@ void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp
   if (Opt == OptLevel::O3)
     FPM.addPass(KernelFlatteningPass{});
   if (Opt != OptLevel::O0)
-    FPM.addPass(LoopsParallelMarkerPass{});
+    FPM.addPass(LoopsParallelMarkerPass{WorkItemLoopVectorWidth});
   
   MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
 }
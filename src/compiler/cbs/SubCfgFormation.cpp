@@ -1419,6 +1419,40 @@ getBarrierIds(llvm::BasicBlock *Entry, llvm::SmallPtrSetImpl<llvm::BasicBlock *>
   return Barriers;
 }
 
+// Barriers must be reached by all work items of the work-group. Returns whether
+// any barrier block is dominated by a branch on a work-item dependent condition
+// without post-dominating it, i.e. is only executed by some of the work items.
+bool hasDivergentBarriers(llvm::Function &F,
+                          const llvm::DenseMap<llvm::BasicBlock *, size_t> &Barriers,
+                          const hipsycl::compiler::VectorizationInfo &VecInfo,
+                          const llvm::DominatorTree &DT, const llvm::PostDominatorTree &PDT) {
+  for (auto &BB : F) {
+    auto *Term = BB.getTerminator();
+    llvm::Value *Cond = nullptr;
+    if (auto *BI = llvm::dyn_cast<llvm::BranchInst>(Term)) {
+      if (BI->isConditional())
+        Cond = BI->getCondition();
+    } else if (auto *SI = llvm::dyn_cast<llvm::SwitchInst>(Term)) {
+      Cond = SI->getCondition();
+    }
+    if (!Cond || !VecInfo.hasKnownShape(*Cond) ||
+        !VecInfo.getVectorShape(*Cond).greaterThanUniform())
+      continue;
+
+    for (auto &BIt : Barriers) {
+      if (BIt.second == EntryBarrierId || BIt.second == ExitBarrierId)
+        continue;
+      if (DT.dominates(&BB, BIt.first) && !PDT.dominates(BIt.first, &BB)) {
+        HIPSYCL_DEBUG_WARNING << "[SubCFG] Barrier " << BIt.first->getName() << " in "
+                              << F.getName() << " depends on divergent branch in "
+                              << BB.getName() << "\n";
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
                  llvm::PostDominatorTree &PDT, const SplitterAnnotationInfo &SAA, bool IsSscp) {
   HIPSYCL_DEBUG_EXECUTE_VERBOSE(F.viewCFG();)
@@ -1459,6 +1493,15 @@ void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
 
   auto Barriers = getBarrierIds(Entry, ExitingBlocks, Blocks, SAA);
 
+  // Divergent barriers are undefined behavior and cannot be handled by CBS. Let
+  // the SSCP host backend decide whether to reject the kernel.
+  if (IsSscp && hasDivergentBarriers(F, Barriers, VecInfo, DT, PDT)) {
+    auto &Ctx = F.getContext();
+    F.getParent()
+        ->getOrInsertNamedMetadata(cbs::DivergentBarrierKernelsName)
+        ->addOperand(llvm::MDNode::get(Ctx, llvm::MDString::get(Ctx, F.getName())));
+  }
+
   const llvm::DataLayout &DL = F.getParent()->getDataLayout();
   auto *LastBarrierIdStorage =
       Builder.CreateAlloca(DL.getLargestLegalIntType(F.getContext()), nullptr, "LastBarrierId");
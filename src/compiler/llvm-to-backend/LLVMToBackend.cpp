@@ -43,9 +43,14 @@
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/Error.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <string>
 #include <optional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <cstdlib>
 #include <sstream>
 #include <unordered_set>
@@ -534,14 +539,16 @@ bool LLVMToBackendTranslator::optimizeFlavoredIR(llvm::Module& M, PassHandler& P
   return true;
 }
 
-bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::string &Bitcode,
+bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, std::string_view Bitcode,
                                                 const std::string &ForcedTriple,
                                                 const std::string &ForcedDataLayout,
                                                 bool LinkOnlyNeeded) {
-  std::unique_ptr<llvm::Module> OtherModule;
-  auto err = loadModuleFromString(Bitcode, M.getContext(), OtherModule);
+  // Function bodies are only materialized when the linker needs them.
+  auto OtherModule = llvm::getLazyBitcodeModule(
+      llvm::MemoryBufferRef{llvm::StringRef{Bitcode.data(), Bitcode.size()}, ""},
+      M.getContext());
 
-  if (err) {
+  if (auto err = OtherModule.takeError()) {
     this->registerError("LLVMToBackend: Could not load LLVM module");
     llvm::handleAllErrors(std::move(err), [&](llvm::ErrorInfoBase &EIB) {
       this->registerError(EIB.message());
@@ -553,7 +560,7 @@ bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::stri
   if(LinkOnlyNeeded)
     F = llvm::Linker::LinkOnlyNeeded;
 
-  if(!linkBitcode(M, std::move(OtherModule), ForcedTriple, ForcedDataLayout, F)) {
+  if(!linkBitcode(M, std::move(OtherModule.get()), ForcedTriple, ForcedDataLayout, F)) {
     this->registerError("LLVMToBackend: Linking module failed");
     return false;
   }
@@ -561,18 +568,36 @@ bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::stri
   return true;
 }
 
+bool LLVMToBackendTranslator::readBitcodeFile(const std::string &BitcodeFile,
+                                              std::string_view &Out) {
+  // Buffers are never evicted, so views into them remain valid.
+  static std::mutex Mutex;
+  static std::unordered_map<std::string, std::unique_ptr<llvm::MemoryBuffer>> Cache;
+
+  std::lock_guard<std::mutex> Lock{Mutex};
+  auto It = Cache.find(BitcodeFile);
+  if(It == Cache.end()) {
+    auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
+    if(auto Err = F.getError()) {
+      this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
+      return false;
+    }
+    It = Cache.emplace(BitcodeFile, std::move(F.get())).first;
+  }
+  llvm::StringRef Buffer = It->second->getBuffer();
+  Out = std::string_view{Buffer.data(), Buffer.size()};
+  return true;
+}
+
 bool LLVMToBackendTranslator::linkBitcodeFile(llvm::Module &M, const std::string &BitcodeFile,
                                               const std::string &ForcedTriple,
                                               const std::string &ForcedDataLayout,
                                               bool LinkOnlyNeeded) {
-  auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
-  if(auto Err = F.getError()) {
-    this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
+  std::string_view Bitcode;
+  if(!readBitcodeFile(BitcodeFile, Bitcode))
     return false;
-  }
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
-  return linkBitcodeString(M, std::string{F.get()->getBuffer()}, ForcedTriple, ForcedDataLayout,
-                           LinkOnlyNeeded);
+  return linkBitcodeString(M, Bitcode, ForcedTriple, ForcedDataLayout, LinkOnlyNeeded);
 }
 
 void LLVMToBackendTranslator::specializeKernelArgument(const std::string &KernelName, int ParamIndex,
@@ -452,13 +452,10 @@ bool LLVMToAmdgpuTranslator::hiprtcJitLink(const std::string &Bitcode, std::stri
                           "hipSYCL SSCP Bitcode", 0, 0, 0);
 
   auto addBitcodeFile = [&](const std::string &BCFileName) -> bool {
-    auto ReadResult = llvm::MemoryBuffer::getFile(BCFileName, false);
-    if(auto Err = ReadResult.getError()) {
-      this->registerError("LLVMToAmdgpu: Could not open file: " + BCFileName);
+    std::string_view BC;
+    if(!this->readBitcodeFile(BCFileName, BC))
       return false;
-    }
 
-    llvm::StringRef BC = ReadResult->get()->getBuffer();
     hiprtcLinkAddData(LS, HIPRTC_JIT_INPUT_LLVM_BITCODE, const_cast<char *>(BC.data()), BC.size(),
                       BCFileName.c_str(), 0, 0, 0);
 
@@ -507,16 +504,7 @@ bool LLVMToAmdgpuTranslator::hiprtcJitLink(const std::string &Bitcode, std::stri
 bool LLVMToAmdgpuTranslator::clangJitLink(llvm::Module& FlavoredModule, std::string& Out) {
   
   auto addBitcodeFile = [&](const std::string &BCFileName) -> bool {
-    auto ReadResult = llvm::MemoryBuffer::getFile(BCFileName, false);
-    if(auto Err = ReadResult.getError()) {
-      this->registerError("LLVMToAmdgpu: Could not open file: " + BCFileName);
-      return false;
-    }
-
-    llvm::StringRef BC = ReadResult->get()->getBuffer();
-    this->linkBitcodeFile(FlavoredModule, BCFileName, "", "", false);
-
-    return true;
+    return this->linkBitcodeFile(FlavoredModule, BCFileName, "", "", false);
   };
 
   std::vector<std::string> DeviceLibs;
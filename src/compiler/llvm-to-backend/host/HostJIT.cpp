@@ -0,0 +1,209 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJIT.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHost.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/Utils.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/Shared/ExecutorAddress.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+
+namespace {
+
+std::vector<std::string> getVectorMathLibraryFiles() {
+  std::vector<std::string> Files;
+  auto addIfAvailable = [&](const std::string &Dir, const std::string &Name) {
+    if (!Dir.empty())
+      Files.push_back(common::filesystem::join_path(Dir, Name));
+  };
+#ifdef SLEEF_AVAILABLE
+  addIfAvailable(getLibSleefDir(), LIB_SLEEF_NAME);
+#endif
+#ifdef AMATH_AVAILABLE
+  addIfAvailable(getLibAmathDir(), LIB_AMATH_NAME);
+#endif
+#ifdef SVML_AVAILABLE
+  addIfAvailable(getLibSvmlDir(), LIB_INTLC_NAME);
+  addIfAvailable(getLibSvmlDir(), LIB_SVML_NAME);
+#endif
+#ifdef LIBMVEC_AVAILABLE
+  addIfAvailable(getLibMvecDir(), LIB_MVEC_NAME);
+#endif
+  return Files;
+}
+
+template <class SymbolT> void *getSymbolAddress(const SymbolT &Sym) {
+  if constexpr (std::is_same_v<SymbolT, llvm::orc::ExecutorAddr>)
+    return Sym.template toPtr<void *>();
+  else
+    return reinterpret_cast<void *>(static_cast<std::uintptr_t>(Sym.getAddress()));
+}
+
+// Process-wide JIT instance. All kernel objects are linked into their own
+// JITDylib, which resolves external symbols against the main JITDylib.
+// The main JITDylib in turn exposes all symbols of the process as well
+// as the vector math libraries that kernels might have been vectorized for.
+class HostJITSession {
+public:
+  static HostJITSession &get() {
+    // Intentionally leaked: Code objects referencing the JIT might
+    // be destroyed during static destruction in other libraries.
+    static HostJITSession *S = new HostJITSession{};
+    return *S;
+  }
+
+  llvm::orc::LLJIT *getJIT(std::string &ErrorOut) {
+    std::lock_guard<std::mutex> Lock{Mutex};
+    if (!JIT && InitError.empty())
+      init();
+    ErrorOut = InitError;
+    return JIT.get();
+  }
+
+  std::string createDylibName() {
+    return "acpp-host-kernels-" + std::to_string(DylibCounter++);
+  }
+
+private:
+  HostJITSession() = default;
+
+  void init() {
+    initializeHostTarget();
+
+    auto J = llvm::orc::LLJITBuilder{}.create();
+    if (!J) {
+      InitError = "Could not create JIT: " + llvm::toString(J.takeError());
+      return;
+    }
+    JIT = std::move(*J);
+
+    char GlobalPrefix = JIT->getDataLayout().getGlobalPrefix();
+    auto ProcessSymbols =
+        llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(GlobalPrefix);
+    if (!ProcessSymbols) {
+      InitError = "Could not expose process symbols to JIT: " +
+                  llvm::toString(ProcessSymbols.takeError());
+      JIT.reset();
+      return;
+    }
+    JIT->getMainJITDylib().addGenerator(std::move(*ProcessSymbols));
+
+    for (const auto &File : getVectorMathLibraryFiles()) {
+      auto Generator =
+          llvm::orc::DynamicLibrarySearchGenerator::Load(File.c_str(), GlobalPrefix);
+      if (Generator) {
+        HIPSYCL_DEBUG_INFO << "HostJIT: Exposing vector math library " << File << "\n";
+        JIT->getMainJITDylib().addGenerator(std::move(*Generator));
+      } else {
+        HIPSYCL_DEBUG_WARNING << "HostJIT: Could not load vector math library " << File << ": "
+                              << llvm::toString(Generator.takeError()) << "\n";
+      }
+    }
+  }
+
+  std::mutex Mutex;
+  std::unique_ptr<llvm::orc::LLJIT> JIT;
+  std::string InitError;
+  std::atomic<std::size_t> DylibCounter = 0;
+};
+
+class OrcHostJITDylib : public HostJITDylib {
+public:
+  OrcHostJITDylib(llvm::orc::LLJIT &J, llvm::orc::JITDylib &JD) : J{J}, JD{JD} {}
+
+  virtual ~OrcHostJITDylib() {
+    if (auto Err = J.getExecutionSession().removeJITDylib(JD)) {
+      HIPSYCL_DEBUG_ERROR << "HostJIT: Could not unload kernels: "
+                          << llvm::toString(std::move(Err)) << "\n";
+    }
+  }
+
+  virtual void *getSymbol(const std::string &Name) const override {
+    auto Sym = J.lookup(JD, Name);
+    if (!Sym) {
+      HIPSYCL_DEBUG_WARNING << "HostJIT: Could not resolve " << Name << ": "
+                            << llvm::toString(Sym.takeError()) << "\n";
+      return nullptr;
+    }
+    return getSymbolAddress(*Sym);
+  }
+
+private:
+  llvm::orc::LLJIT &J;
+  llvm::orc::JITDylib &JD;
+};
+
+} // anonymous namespace
+
+#endif
+
+bool isHostRelocatableObject(const std::string &Image) {
+  switch (llvm::identify_magic(Image)) {
+  case llvm::file_magic::elf_relocatable:
+  case llvm::file_magic::macho_object:
+  case llvm::file_magic::coff_object:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::unique_ptr<HostJITDylib> loadHostRelocatableObject(const std::string &Image,
+                                                        std::string &ErrorOut) {
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+  HostJITSession &Session = HostJITSession::get();
+  llvm::orc::LLJIT *J = Session.getJIT(ErrorOut);
+  if (!J)
+    return nullptr;
+
+  auto JD = J->getExecutionSession().createJITDylib(Session.createDylibName());
+  if (!JD) {
+    ErrorOut = llvm::toString(JD.takeError());
+    return nullptr;
+  }
+  JD->addToLinkOrder(J->getMainJITDylib());
+
+  // Construct the handle right away so that the JITDylib is removed on error
+  auto Dylib = std::make_unique<OrcHostJITDylib>(*J, *JD);
+  if (auto Err = J->addObjectFile(
+          *JD, llvm::MemoryBuffer::getMemBufferCopy(Image, JD->getName()))) {
+    ErrorOut = llvm::toString(std::move(Err));
+    return nullptr;
+  }
+  return Dylib;
+#else
+  ErrorOut = "AdaptiveCpp was built without in-process host JIT support";
+  return nullptr;
+#endif
+}
+
+}
+}
@@ -24,6 +24,8 @@
 #include "hipSYCL/glue/llvm-sscp/jit-reflection/queries.hpp"
 
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/CallingConv.h>
@@ -31,6 +33,7 @@
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/GlobalValue.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassManager.h>
@@ -38,7 +41,12 @@
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#endif
 #if LLVM_VERSION_MAJOR < 16
 #include <llvm/ADT/Triple.h>
 #include <llvm/Support/Host.h>
@@ -50,6 +58,7 @@
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <vector>
@@ -162,6 +171,23 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
   HostStaticLocalMemoryPass SLMPass{};
   SLMPass.run(M, *PH.ModuleAnalysisManager);
 
+  if (SimdSubgroupSize > 1) {
+    // Redirect sub-group builtins used by the kernels to their SIMD implementations.
+    // Builtins that are implemented using sub-group builtins (e.g. work-group
+    // reductions) are not affected since they are only linked afterwards.
+    const llvm::StringRef Prefix = "__acpp_sscp_";
+    for (auto &F : M) {
+      llvm::StringRef Name = F.getName();
+      if (!F.isDeclaration() || !llvmutils::starts_with(Name, Prefix))
+        continue;
+      if (llvmutils::starts_with(Name, "__acpp_sscp_sub_group_") ||
+          Name == "__acpp_sscp_get_subgroup_local_id" || Name == "__acpp_sscp_get_subgroup_size" ||
+          Name == "__acpp_sscp_get_subgroup_max_size" || Name == "__acpp_sscp_get_subgroup_id" ||
+          Name == "__acpp_sscp_get_num_subgroups")
+        F.setName("__acpp_sscp_host_simd_" + Name.drop_front(Prefix.size()).str());
+    }
+  }
+
   std::string BuiltinBitcodeFileName = "libkernel-sscp-host-full.bc";
   if(IsFastMath)
     BuiltinBitcodeFileName = "libkernel-sscp-host-fast-full.bc";
@@ -190,7 +216,8 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
   });
   PH.PassBuilder->registerModuleAnalyses(*PH.ModuleAnalysisManager);
 
-  registerCBSPipeline(MPM, hipsycl::compiler::OptLevel::O3, true);
+  registerCBSPipeline(MPM, hipsycl::compiler::OptLevel::O3, true,
+                      SimdSubgroupSize > 1 ? SimdSubgroupSize : 0);
   HIPSYCL_DEBUG_INFO << "LLVMToHostTranslator: Done registering\n";
 
   llvm::FunctionPassManager FPM;
@@ -198,12 +225,263 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
   MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
 
   MPM.run(M, *PH.ModuleAnalysisManager);
+
+  // SIMD sub-group collectives synchronize the whole work-group, so they must not
+  // be called in divergent control flow. Reject such kernels instead of running
+  // them with results that depend on which work items reached the collective.
+  if (auto *DivergentKernels = M.getNamedMetadata(cbs::DivergentBarrierKernelsName)) {
+    if (SimdSubgroupSize > 1) {
+      std::string Names;
+      for (auto *Op : DivergentKernels->operands()) {
+        if (!Names.empty())
+          Names += ", ";
+        Names += llvm::cast<llvm::MDString>(Op->getOperand(0))->getString().str();
+      }
+      this->registerError("LLVMToHost: Kernels " + Names +
+                          " call sub-group functions or barriers in control flow that "
+                          "depends on the work item, which is not supported with "
+                          "ACPP_JITOPT_HOST_SIMD_SUBGROUPS=1");
+      return false;
+    }
+    M.eraseNamedMetadata(DivergentKernels);
+  }
   HIPSYCL_DEBUG_INFO << "LLVMToHostTranslator: Done toBackendFlavor\n";
   return true;
 }
 
+void initializeHostTarget() {
+  static std::once_flag Flag;
+  std::call_once(Flag, []() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+}
+
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+
+namespace {
+
+// The signature of addVectorizableFunctionsFromVecLib() differs between
+// LLVM versions, depending on whether the mappings depend on the target.
+template <class TLIImplT, class VecLibT>
+auto addVecLib(TLIImplT &TLII, VecLibT Lib, const llvm::Triple &TT, int)
+    -> decltype(TLII.addVectorizableFunctionsFromVecLib(Lib, TT), void()) {
+  TLII.addVectorizableFunctionsFromVecLib(Lib, TT);
+}
+
+template <class TLIImplT, class VecLibT>
+void addVecLib(TLIImplT &TLII, VecLibT Lib, const llvm::Triple &TT, long) {
+  TLII.addVectorizableFunctionsFromVecLib(Lib);
+}
+
+// Equivalent of opt -vector-library=... for the in-process pipeline.
+// The library itself is made available to kernels by the host JIT.
+void addVectorMathLibrary(llvm::TargetLibraryInfoImpl &TLII, const llvm::Triple &TT,
+                          host_vector_math_library Lib) {
+  switch (Lib) {
+  case host_vector_math_library::sleef:
+#if defined(SLEEF_AVAILABLE) && LLVM_VERSION_MAJOR >= 16
+    if (!getLibSleefDir().empty()) {
+      addVecLib(TLII, llvm::TargetLibraryInfoImpl::SLEEFGNUABI, TT, 0);
+      return;
+    }
+#endif
+    break;
+  case host_vector_math_library::armpl:
+#if defined(AMATH_AVAILABLE) && LLVM_VERSION_MAJOR >= 17
+    if (!getLibAmathDir().empty()) {
+      addVecLib(TLII, llvm::TargetLibraryInfoImpl::ArmPL, TT, 0);
+      return;
+    }
+#endif
+    break;
+  case host_vector_math_library::svml:
+#ifdef SVML_AVAILABLE
+    if (!getLibSvmlDir().empty()) {
+      addVecLib(TLII, llvm::TargetLibraryInfoImpl::SVML, TT, 0);
+      return;
+    }
+#endif
+    break;
+  case host_vector_math_library::libmvec:
+#ifdef LIBMVEC_AVAILABLE
+    if (!getLibMvecDir().empty()) {
+#if LLVM_VERSION_MAJOR > 20
+      addVecLib(TLII, llvm::TargetLibraryInfoImpl::LIBMVEC, TT, 0);
+#else
+      addVecLib(TLII, llvm::TargetLibraryInfoImpl::LIBMVEC_X86, TT, 0);
+#endif
+      return;
+    }
+#endif
+    break;
+  default:
+    return;
+  }
+  HIPSYCL_DEBUG_WARNING << "LLVMToHost: Requested vector math library is not available. Kernel "
+                           "will be compiled without it.\n";
+}
+
+std::unique_ptr<llvm::TargetMachine> createHostTargetMachine(bool IsFastMath,
+                                                             std::string &Error) {
+  initializeHostTarget();
+
+  auto JTMB = llvm::orc::JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    Error = "Could not detect host target: " + llvm::toString(JTMB.takeError());
+    return nullptr;
+  }
+  // Empty means that the CPU of the machine we are running on is targeted.
+  const std::string ForcedCPU = ACPP_HOST_JIT_CPU;
+  if (!ForcedCPU.empty()) {
+    JTMB->setCPU(ForcedCPU);
+    JTMB->getFeatures() = llvm::SubtargetFeatures{};
+  }
+  JTMB->setRelocationModel(llvm::Reloc::PIC_);
+#if LLVM_VERSION_MAJOR >= 18
+  JTMB->setCodeGenOptLevel(llvm::CodeGenOptLevel::Aggressive);
+#else
+  JTMB->setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+#endif
+  if (IsFastMath) {
+    llvm::TargetOptions &Options = JTMB->getOptions();
+    Options.UnsafeFPMath = true;
+    Options.NoInfsFPMath = true;
+    Options.NoNaNsFPMath = true;
+    Options.NoSignedZerosFPMath = true;
+    Options.NoTrappingFPMath = true;
+  }
+
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    Error = "Could not create target machine: " + llvm::toString(TM.takeError());
+    return nullptr;
+  }
+  return std::move(*TM);
+}
+
+} // anonymous namespace
+
+bool LLVMToHostTranslator::translateInProcess(llvm::Module &FlavoredModule, std::string &out) {
+  std::string Error;
+  auto TM = createHostTargetMachine(IsFastMath, Error);
+  if (!TM) {
+    this->registerError("LLVMToHost: " + Error);
+    return false;
+  }
+  const llvm::Triple &TT = TM->getTargetTriple();
+#if LLVM_VERSION_MAJOR > 20
+  FlavoredModule.setTargetTriple(TT);
+#else
+  FlavoredModule.setTargetTriple(TT.str());
+#endif
+  FlavoredModule.setDataLayout(TM->createDataLayout());
+
+  llvm::TargetLibraryInfoImpl TLII{TT};
+  addVectorMathLibrary(TLII, TT, VectorMathLibary);
+
+  // Corresponds to the former opt -O3 invocation, but now
+  // with knowledge about the target
+  {
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+    llvm::PassBuilder PB{TM.get()};
+    // Needs to be registered before the default analyses
+    FAM.registerPass([&] { return llvm::TargetLibraryAnalysis{TLII}; });
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    HIPSYCL_DEBUG_INFO << "LLVMToHost: Optimizing for " << TM->getTargetCPU().str() << "\n";
+    llvm::ModulePassManager MPM = PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+    MPM.run(FlavoredModule, MAM);
+  }
+
+  // Corresponds to the former llc invocation
+  llvm::SmallVector<char, 0> ObjectBuffer;
+  {
+    llvm::raw_svector_ostream ObjectStream{ObjectBuffer};
+    llvm::legacy::PassManager CodeGenPM;
+    CodeGenPM.add(new llvm::TargetLibraryInfoWrapperPass(TLII));
+#if LLVM_VERSION_MAJOR >= 18
+    auto FileType = llvm::CodeGenFileType::ObjectFile;
+#else
+    auto FileType = llvm::CGFT_ObjectFile;
+#endif
+    if (TM->addPassesToEmitFile(CodeGenPM, ObjectStream, nullptr, FileType)) {
+      this->registerError("LLVMToHost: Target does not support object file emission");
+      return false;
+    }
+    HIPSYCL_DEBUG_INFO << "LLVMToHost: Emitting object file\n";
+    CodeGenPM.run(FlavoredModule);
+  }
+
+  // No linking step required - the object file is linked into the
+  // process by the host JIT when the kernels are loaded.
+  out.assign(ObjectBuffer.begin(), ObjectBuffer.end());
+  return true;
+}
+
+#endif
+
+bool LLVMToHostTranslator::prepareBackendFlavor(llvm::Module &M) {
+  if (!UseSimdSubgroups)
+    return true;
+
+  auto isValidSubgroupSize = [](int Size) {
+    return Size > 1 && Size <= 64 && (Size & (Size - 1)) == 0;
+  };
+
+  if (isValidSubgroupSize(DesiredSubgroupSize)) {
+    SimdSubgroupSize = DesiredSubgroupSize;
+  } else {
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+    std::string Error;
+    auto TM = createHostTargetMachine(IsFastMath, Error);
+    llvm::Function *Kernel = nullptr;
+    for (const auto &Name : KernelNames)
+      if (!Kernel)
+        Kernel = M.getFunction(Name);
+
+    if (TM && Kernel) {
+      // Number of 32 bit lanes in a vector register
+      int Width = static_cast<int>(
+          TM->getTargetTransformInfo(*Kernel)
+              .getRegisterBitWidth(llvm::TargetTransformInfo::RGK_FixedWidthVector)
+              .getKnownMinValue() / 32);
+      if (isValidSubgroupSize(Width))
+        SimdSubgroupSize = Width;
+    } else if (!TM) {
+      HIPSYCL_DEBUG_WARNING << "LLVMToHost: " << Error << "\n";
+    }
+#else
+    HIPSYCL_DEBUG_WARNING << "LLVMToHost: Cannot determine native SIMD width without in-process "
+                             "JIT support, SIMD sub-groups require the desired-subgroup-size "
+                             "build option.\n";
+#endif
+  }
+
+  HIPSYCL_DEBUG_INFO << "LLVMToHost: Using sub-group size " << SimdSubgroupSize << "\n";
+  if (SimdSubgroupSize > 1)
+    setReflectionField("host_simd_subgroup_size", SimdSubgroupSize);
+  return true;
+}
+
 bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule,
                                                     std::string &out) {
+#ifdef ACPP_HOST_IN_PROCESS_JIT
+  return translateInProcess(FlavoredModule, out);
+#else
+  return translateWithExternalTools(FlavoredModule, out);
+#endif
+}
+
+bool LLVMToHostTranslator::translateWithExternalTools(llvm::Module &FlavoredModule,
+                                                      std::string &out) {
 
   llvm::SmallVector<char> InputFile;
   int InputFD;
@@ -514,6 +792,14 @@ bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule
   return true;
 }
 
+bool LLVMToHostTranslator::applyBuildFlag(const std::string &Flag) {
+  if (Flag == "host-simd-subgroups") {
+    UseSimdSubgroups = true;
+    return true;
+  }
+  return false;
+}
+
 bool LLVMToHostTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
   if (Option == "host-vector-math-library") {
     VectorMathLibary = static_cast<host_vector_math_library>(std::stoi(Value));
@@ -0,0 +1,273 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+// Sub-group builtins for ACPP_JITOPT_HOST_SIMD_SUBGROUPS. LLVMToHost redirects
+// kernel calls to __acpp_sscp_sub_group_* and the sub-group queries to the
+// __acpp_sscp_host_simd_* functions defined here.
+//
+// A sub-group consists of SIMD-width consecutive work items, i.e. the lanes of
+// one vector iteration of the work-item loop. Work items exchange data through
+// the internal local memory between work-group barriers, which the CBS pipeline
+// turns into separate work-item loops that can be vectorized with the same width.
+// Consequently, all work items of the work-group must call sub-group functions.
+// SubCfgFormation detects barriers in divergent control flow, and LLVMToHost
+// rejects such kernels.
+
+#include "hipSYCL/sycl/libkernel/sscp/builtins/barrier.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/builtin_config.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/core_typed.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/detail/utils.hpp"
+
+HIPSYCL_SSCP_BUILTIN void *__acpp_sscp_host_get_internal_local_memory();
+
+extern "C" int __acpp_sscp_jit_reflect_host_simd_subgroup_size();
+extern "C" int __acpp_sscp_jit_reflect_knows_host_simd_subgroup_size();
+
+namespace {
+
+using namespace hipsycl::libkernel::sscp;
+
+__attribute__((always_inline)) __acpp_int32 simd_sg_max_size() {
+  if (__acpp_sscp_jit_reflect_knows_host_simd_subgroup_size())
+    return __acpp_sscp_jit_reflect_host_simd_subgroup_size();
+  return 1;
+}
+
+__attribute__((always_inline)) __acpp_int32 simd_sg_wg_lid() {
+  return __acpp_sscp_typed_get_local_linear_id<3, int>();
+}
+
+__attribute__((always_inline)) __acpp_int32 simd_sg_wg_size() {
+  return __acpp_sscp_typed_get_local_size<3, int>();
+}
+
+__attribute__((always_inline)) __acpp_int32 simd_sg_size() {
+  const __acpp_int32 max_size = simd_sg_max_size();
+  const __acpp_int32 remaining = simd_sg_wg_size() - (simd_sg_wg_lid() / max_size) * max_size;
+  return remaining < max_size ? remaining : max_size;
+}
+
+__attribute__((always_inline)) void simd_sg_wg_barrier() {
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::relaxed);
+}
+
+// Returns the value of x of the sub-group member with the given sub-group local id,
+// or x itself if there is no such member.
+template <typename T> __attribute__((always_inline)) T simd_sg_shuffle(T x, __acpp_int32 src) {
+  T *shrd_mem = static_cast<T *>(__acpp_sscp_host_get_internal_local_memory());
+  const __acpp_int32 wg_lid = simd_sg_wg_lid();
+  const __acpp_int32 sg_lid = wg_lid % simd_sg_max_size();
+
+  shrd_mem[wg_lid] = x;
+  simd_sg_wg_barrier();
+  T result = (src >= 0 && src < simd_sg_size()) ? shrd_mem[wg_lid - sg_lid + src] : x;
+  simd_sg_wg_barrier();
+  return result;
+}
+
+// Folds x of sub-group members [0, end) in order
+template <typename T, typename BinaryOperation>
+__attribute__((always_inline)) T simd_sg_fold(T x, BinaryOperation op, T init,
+                                              __acpp_int32 end) {
+  T *shrd_mem = static_cast<T *>(__acpp_sscp_host_get_internal_local_memory());
+  const __acpp_int32 wg_lid = simd_sg_wg_lid();
+  const __acpp_int32 sg_base = wg_lid - wg_lid % simd_sg_max_size();
+
+  shrd_mem[wg_lid] = x;
+  simd_sg_wg_barrier();
+  T result = init;
+  for (__acpp_int32 i = 0; i < end; ++i)
+    result = op(result, shrd_mem[sg_base + i]);
+  simd_sg_wg_barrier();
+  return result;
+}
+
+template <typename T, typename BinaryOperation>
+__attribute__((always_inline)) T simd_sg_reduce(T x, BinaryOperation op) {
+  T *shrd_mem = static_cast<T *>(__acpp_sscp_host_get_internal_local_memory());
+  const __acpp_int32 wg_lid = simd_sg_wg_lid();
+  const __acpp_int32 sg_base = wg_lid - wg_lid % simd_sg_max_size();
+  const __acpp_int32 sg_size = simd_sg_size();
+
+  shrd_mem[wg_lid] = x;
+  simd_sg_wg_barrier();
+  T result = shrd_mem[sg_base];
+  for (__acpp_int32 i = 1; i < sg_size; ++i)
+    result = op(result, shrd_mem[sg_base + i]);
+  simd_sg_wg_barrier();
+  return result;
+}
+
+template <typename T, typename BinaryOperation>
+__attribute__((always_inline)) T simd_sg_inclusive_scan(T x, BinaryOperation op) {
+  T *shrd_mem = static_cast<T *>(__acpp_sscp_host_get_internal_local_memory());
+  const __acpp_int32 wg_lid = simd_sg_wg_lid();
+  const __acpp_int32 sg_lid = wg_lid % simd_sg_max_size();
+
+  shrd_mem[wg_lid] = x;
+  simd_sg_wg_barrier();
+  T result = shrd_mem[wg_lid - sg_lid];
+  for (__acpp_int32 i = 1; i <= sg_lid; ++i)
+    result = op(result, shrd_mem[wg_lid - sg_lid + i]);
+  simd_sg_wg_barrier();
+  return result;
+}
+
+template <typename T, typename BinaryOperation>
+__attribute__((always_inline)) T simd_sg_exclusive_scan(T x, BinaryOperation op, T init) {
+  return simd_sg_fold(x, op, init, simd_sg_wg_lid() % simd_sg_max_size());
+}
+
+template <typename T, typename Algorithm>
+__attribute__((always_inline)) T dispatch_float_op(__acpp_sscp_algorithm_op op, Algorithm f) {
+  switch (op) {
+  case __acpp_sscp_algorithm_op::plus:
+    return f(plus{});
+  case __acpp_sscp_algorithm_op::multiply:
+    return f(multiply{});
+  case __acpp_sscp_algorithm_op::min:
+    return f(min{});
+  case __acpp_sscp_algorithm_op::max:
+    return f(max{});
+  default:
+    return T{};
+  }
+}
+
+template <typename T, typename Algorithm>
+__attribute__((always_inline)) T dispatch_int_op(__acpp_sscp_algorithm_op op, Algorithm f) {
+  switch (op) {
+  case __acpp_sscp_algorithm_op::bit_and:
+    return f(bit_and{});
+  case __acpp_sscp_algorithm_op::bit_or:
+    return f(bit_or{});
+  case __acpp_sscp_algorithm_op::bit_xor:
+    return f(bit_xor{});
+  case __acpp_sscp_algorithm_op::logical_and:
+    return f(logical_and{});
+  case __acpp_sscp_algorithm_op::logical_or:
+    return f(logical_or{});
+  default:
+    return dispatch_float_op<T>(op, f);
+  }
+}
+
+} // anonymous namespace
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_host_simd_get_subgroup_local_id() {
+  return simd_sg_wg_lid() % simd_sg_max_size();
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_host_simd_get_subgroup_size() {
+  return simd_sg_size();
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_host_simd_get_subgroup_max_size() {
+  return simd_sg_max_size();
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_host_simd_get_subgroup_id() {
+  return simd_sg_wg_lid() / simd_sg_max_size();
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_host_simd_get_num_subgroups() {
+  const __acpp_int32 max_size = simd_sg_max_size();
+  return (simd_sg_wg_size() + max_size - 1) / max_size;
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_host_simd_sub_group_barrier(__acpp_sscp_memory_scope fence_scope,
+                                        __acpp_sscp_memory_order order) {
+  // Sub-group members are executed in different iterations of the work-item loop
+  __acpp_sscp_work_group_barrier(fence_scope, order);
+}
+
+#define ACPP_HOST_SIMD_SHUFFLES(int_size)                                                          \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_int##int_size __acpp_sscp_host_simd_sub_group_shl_i##int_size(                            \
+      __acpp_int##int_size value, __acpp_uint32 delta) {                                           \
+    return simd_sg_shuffle(value, static_cast<__acpp_int32>(                                       \
+                                      __acpp_sscp_host_simd_get_subgroup_local_id() + delta));     \
+  }                                                                                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_int##int_size __acpp_sscp_host_simd_sub_group_shr_i##int_size(                            \
+      __acpp_int##int_size value, __acpp_uint32 delta) {                                           \
+    return simd_sg_shuffle(value, static_cast<__acpp_int32>(                                       \
+                                      __acpp_sscp_host_simd_get_subgroup_local_id() - delta));     \
+  }                                                                                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_int##int_size __acpp_sscp_host_simd_sub_group_permute_i##int_size(                        \
+      __acpp_int##int_size value, __acpp_int32 mask) {                                             \
+    return simd_sg_shuffle(value, static_cast<__acpp_int32>(                                       \
+                                      __acpp_sscp_host_simd_get_subgroup_local_id() ^ mask));      \
+  }                                                                                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_int##int_size __acpp_sscp_host_simd_sub_group_select_i##int_size(                         \
+      __acpp_int##int_size value, __acpp_int32 id) {                                               \
+    return simd_sg_shuffle(value, id);                                                             \
+  }                                                                                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_int##int_size __acpp_sscp_host_simd_sub_group_broadcast_i##int_size(                      \
+      __acpp_int32 sender, __acpp_int##int_size x) {                                               \
+    return simd_sg_shuffle(x, sender);                                                             \
+  }
+
+ACPP_HOST_SIMD_SHUFFLES(8)
+ACPP_HOST_SIMD_SHUFFLES(16)
+ACPP_HOST_SIMD_SHUFFLES(32)
+ACPP_HOST_SIMD_SHUFFLES(64)
+
+#define ACPP_HOST_SIMD_ALGORITHMS(fn_suffix, type, dispatch)                                       \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_##type __acpp_sscp_host_simd_sub_group_reduce_##fn_suffix(__acpp_sscp_algorithm_op op,    \
+                                                                   __acpp_##type x) {              \
+    return dispatch<__acpp_##type>(op, [&](auto binary_op) { return simd_sg_reduce(x, binary_op); }); \
+  }                                                                                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_##type __acpp_sscp_host_simd_sub_group_inclusive_scan_##fn_suffix(                        \
+      __acpp_sscp_algorithm_op op, __acpp_##type x) {                                              \
+    return dispatch<__acpp_##type>(                                                                \
+        op, [&](auto binary_op) { return simd_sg_inclusive_scan(x, binary_op); });                 \
+  }                                                                                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN                                                                  \
+  __acpp_##type __acpp_sscp_host_simd_sub_group_exclusive_scan_##fn_suffix(                        \
+      __acpp_sscp_algorithm_op op, __acpp_##type x, __acpp_##type init) {                          \
+    return dispatch<__acpp_##type>(                                                                \
+        op, [&](auto binary_op) { return simd_sg_exclusive_scan(x, binary_op, init); });           \
+  }
+
+ACPP_HOST_SIMD_ALGORITHMS(f16, f16, dispatch_float_op)
+ACPP_HOST_SIMD_ALGORITHMS(f32, f32, dispatch_float_op)
+ACPP_HOST_SIMD_ALGORITHMS(f64, f64, dispatch_float_op)
+ACPP_HOST_SIMD_ALGORITHMS(i8, int8, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(i16, int16, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(i32, int32, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(i64, int64, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(u8, uint8, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(u16, uint16, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(u32, uint32, dispatch_int_op)
+ACPP_HOST_SIMD_ALGORITHMS(u64, uint64, dispatch_int_op)
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __acpp_sscp_host_simd_sub_group_all(bool pred) {
+  return __acpp_sscp_host_simd_sub_group_reduce_i8(__acpp_sscp_algorithm_op::logical_and, pred);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __acpp_sscp_host_simd_sub_group_any(bool pred) {
+  return __acpp_sscp_host_simd_sub_group_reduce_i8(__acpp_sscp_algorithm_op::logical_or, pred);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN
+bool __acpp_sscp_host_simd_sub_group_none(bool pred) {
+  return !__acpp_sscp_host_simd_sub_group_reduce_i8(__acpp_sscp_algorithm_op::logical_or, pred);
+}
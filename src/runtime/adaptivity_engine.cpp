@@ -193,6 +193,9 @@ kernel_adaptivity_engine::kernel_adaptivity_engine(
       _local_mem_size(local_mem_size) {
 
   _adaptivity_level = application::get_settings().get<setting::adaptivity_level>();
+  _is_background_compilation_enabled =
+      application::get_settings()
+          .get<setting::jitopt_iads_background_compilation>();
 }
 
 kernel_configuration::id_type
@@ -338,6 +341,11 @@ kernel_adaptivity_engine::finalize_binary_configuration(
   if(_adaptivity_level > 1) {
 
     auto base_id = config.generate_id();
+
+    std::optional<kernel_configuration> unspecialized_config;
+    if(_is_background_compilation_enabled)
+      unspecialized_config = config;
+    bool has_specialized_arguments = false;
     
     // Automatic application of specialization constants by detecting
     // invariant kernel arguments
@@ -369,6 +377,7 @@ kernel_adaptivity_engine::finalize_binary_configuration(
                              << " is invariant or common, specializing."
                              << std::endl;
           config.set_specialized_kernel_argument(i, arg_value);
+          has_specialized_arguments = true;
         } else {
           HIPSYCL_DEBUG_INFO << "adaptivity_engine: Not specializing kernel argument " << i
                              << std::endl;
@@ -385,6 +394,9 @@ kernel_adaptivity_engine::finalize_binary_configuration(
         }
       }
     });
+
+    if(has_specialized_arguments)
+      _unspecialized_config = std::move(unspecialized_config);
   }
 
   return config.generate_id();
@@ -0,0 +1,232 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/allocation_pool.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr std::size_t min_size_class = 256;
+
+// Rounds up to the next size class. Between two powers of two,
+// there are four equally spaced size classes, so at most 25% of
+// an allocation is wasted.
+std::size_t get_size_class(std::size_t size_bytes) {
+  if(size_bytes <= min_size_class)
+    return min_size_class;
+
+  std::size_t power_of_two = 1;
+  while(power_of_two <= size_bytes / 2)
+    power_of_two *= 2;
+
+  std::size_t step = power_of_two / 4;
+  return (size_bytes + step - 1) / step * step;
+}
+
+bool is_aligned(void* ptr, std::size_t alignment) {
+  if(alignment == 0)
+    return true;
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+void *backend_allocate(backend_allocator *alloc,
+                       allocation_pool::allocation_kind kind,
+                       std::size_t min_alignment, std::size_t size_bytes,
+                       const allocation_hints &hints) {
+  switch(kind) {
+  case allocation_pool::allocation_kind::device:
+    return alloc->raw_allocate(min_alignment, size_bytes, hints);
+  case allocation_pool::allocation_kind::host:
+    return alloc->raw_allocate_optimized_host(min_alignment, size_bytes, hints);
+  case allocation_pool::allocation_kind::shared:
+    return alloc->raw_allocate_usm(size_bytes, hints);
+  }
+  return nullptr;
+}
+
+}
+
+allocation_pool& allocation_pool::get() {
+  static allocation_pool pool;
+  return pool;
+}
+
+allocation_pool::allocation_pool()
+: allocation_pool{application::get_settings()
+                      .get<setting::allocation_pool_max_cached_size>() *
+                  1024 * 1024} {}
+
+allocation_pool::allocation_pool(std::size_t max_cached_bytes)
+: _max_cached_bytes{max_cached_bytes} {}
+
+// Backends are already gone at this point, so cached memory cannot be
+// freed anymore. backend_manager calls release_all() on shutdown instead.
+allocation_pool::~allocation_pool() = default;
+
+allocation_pool::allocator_state *
+allocation_pool::find_state(backend_allocator *alloc) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(auto& state : _allocators)
+    if(state->allocator == alloc)
+      return state.get();
+  return nullptr;
+}
+
+allocation_pool::allocator_state *
+allocation_pool::get_state(backend_allocator *alloc) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(auto& state : _allocators)
+    if(state->allocator == alloc)
+      return state.get();
+
+  _allocators.emplace_back(std::make_unique<allocator_state>());
+  _allocators.back()->allocator = alloc;
+  return _allocators.back().get();
+}
+
+void *allocation_pool::allocate(backend_allocator *alloc, allocation_kind kind,
+                                std::size_t min_alignment,
+                                std::size_t size_bytes,
+                                const allocation_hints &hints) {
+  // Memory with special placement requirements is not interchangeable,
+  // so do not cache it.
+  if(_max_cached_bytes == 0 || hints.AdaptiveCpp_target_numa_node.has_value())
+    return backend_allocate(alloc, kind, min_alignment, size_bytes, hints);
+
+  std::size_t size_class = get_size_class(size_bytes);
+  if(size_class > _max_cached_bytes)
+    return backend_allocate(alloc, kind, min_alignment, size_bytes, hints);
+
+  allocator_state* state = get_state(alloc);
+  {
+    std::lock_guard<std::mutex> lock{state->mutex};
+    auto it = state->free_blocks[static_cast<int>(kind)].find(size_class);
+    if(it != state->free_blocks[static_cast<int>(kind)].end()) {
+      auto& blocks = it->second;
+      // Prefer the most recently freed block, which is most likely
+      // to still be in cache.
+      for(std::size_t i = blocks.size(); i-- > 0;) {
+        void* ptr = blocks[i];
+        if(is_aligned(ptr, min_alignment)) {
+          blocks.erase(blocks.begin() + i);
+          state->num_cached_bytes -= size_class;
+          state->used_blocks[ptr] = block_info{size_class, kind};
+          return ptr;
+        }
+      }
+    }
+  }
+
+  void *ptr = backend_allocate(alloc, kind, min_alignment, size_class, hints);
+  if(!ptr) {
+    std::lock_guard<std::mutex> lock{state->mutex};
+    if(state->num_cached_bytes > 0) {
+      HIPSYCL_DEBUG_INFO << "allocation_pool: Allocation failed, releasing "
+                         << state->num_cached_bytes
+                         << " cached bytes and retrying" << std::endl;
+      release(*state);
+      ptr = backend_allocate(alloc, kind, min_alignment, size_class, hints);
+    }
+  }
+  if(ptr) {
+    std::lock_guard<std::mutex> lock{state->mutex};
+    state->used_blocks[ptr] = block_info{size_class, kind};
+  }
+  return ptr;
+}
+
+bool allocation_pool::try_free(allocator_state& state, void* mem) {
+  std::lock_guard<std::mutex> lock{state.mutex};
+  auto it = state.used_blocks.find(mem);
+  if(it == state.used_blocks.end())
+    return false;
+
+  block_info info = it->second;
+  state.used_blocks.erase(it);
+
+  if(state.num_cached_bytes + info.size_class <= _max_cached_bytes) {
+    state.free_blocks[static_cast<int>(info.kind)][info.size_class]
+        .push_back(mem);
+    state.num_cached_bytes += info.size_class;
+  } else {
+    state.allocator->raw_free(mem);
+  }
+  return true;
+}
+
+void allocation_pool::free(backend_allocator *alloc, void *mem) {
+  if(_max_cached_bytes > 0) {
+    allocator_state* state = find_state(alloc);
+    if(state && try_free(*state, mem))
+      return;
+
+    // USM memory might be freed using a different allocator than it was
+    // allocated with (e.g. device allocations on a device other than the
+    // first of the context), so look at the other allocators on a miss.
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(auto& other : _allocators)
+      if(other.get() != state && try_free(*other, mem))
+        return;
+  }
+  alloc->raw_free(mem);
+}
+
+void allocation_pool::release(allocator_state& state) {
+  for(auto& free_blocks : state.free_blocks) {
+    for(auto& size_class : free_blocks)
+      for(void* ptr : size_class.second)
+        state.allocator->raw_free(ptr);
+    free_blocks.clear();
+  }
+  state.num_cached_bytes = 0;
+}
+
+void allocation_pool::release(backend_allocator* alloc) {
+  allocator_state* state = get_state(alloc);
+  std::lock_guard<std::mutex> lock{state->mutex};
+  release(*state);
+}
+
+void allocation_pool::release_all() {
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(auto& state : _allocators) {
+    std::lock_guard<std::mutex> state_lock{state->mutex};
+    if(!state->used_blocks.empty()) {
+      HIPSYCL_DEBUG_INFO << "allocation_pool: " << state->used_blocks.size()
+                         << " allocations are still in use during release"
+                         << std::endl;
+    }
+    release(*state);
+  }
+  _allocators.clear();
+}
+
+std::size_t
+allocation_pool::get_num_cached_bytes(backend_allocator *alloc) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(auto& state : _allocators) {
+    if(state->allocator == alloc) {
+      std::lock_guard<std::mutex> state_lock{state->mutex};
+      return state->num_cached_bytes;
+    }
+  }
+  return 0;
+}
+
+}
+}
@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/allocation_pool.hpp"
 #include "hipSYCL/runtime/allocation_tracker.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/hints.hpp"
@@ -20,7 +21,9 @@ namespace rt {
 
 void *allocate_device(backend_allocator *alloc, size_t min_alignment,
                       size_t size_bytes, const allocation_hints &hints) {
-  auto *ptr = alloc->raw_allocate(min_alignment, size_bytes, hints);
+  auto *ptr = allocation_pool::get().allocate(
+      alloc, allocation_pool::allocation_kind::device, min_alignment,
+      size_bytes, hints);
   if(ptr) {
     application::event_handler_layer().on_new_allocation(
         ptr, size_bytes,
@@ -32,7 +35,9 @@ void *allocate_device(backend_allocator *alloc, size_t min_alignment,
 
 void *allocate_host(backend_allocator *alloc, size_t min_alignment,
                     size_t bytes, const allocation_hints &hints) {
-  auto* ptr = alloc->raw_allocate_optimized_host(min_alignment, bytes, hints);
+  auto *ptr = allocation_pool::get().allocate(
+      alloc, allocation_pool::allocation_kind::host, min_alignment, bytes,
+      hints);
   if(ptr) {
     application::event_handler_layer().on_new_allocation(
         ptr, bytes,
@@ -44,7 +49,8 @@ void *allocate_host(backend_allocator *alloc, size_t min_alignment,
 
 void *allocate_shared(backend_allocator *alloc, size_t bytes,
                       const allocation_hints &hints) {
-  auto* ptr = alloc->raw_allocate_usm(bytes, hints);
+  auto *ptr = allocation_pool::get().allocate(
+      alloc, allocation_pool::allocation_kind::shared, 0, bytes, hints);
   if(ptr) {
     application::event_handler_layer().on_new_allocation(
         ptr, bytes,
@@ -55,8 +61,8 @@ void *allocate_shared(backend_allocator *alloc, size_t bytes,
 }
 
 void deallocate(backend_allocator* alloc, void *mem) {
-  alloc->raw_free(mem);
   application::event_handler_layer().on_deallocation(mem);
+  allocation_pool::get().free(alloc, mem);
 }
 
 }
@@ -9,6 +9,7 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/allocation_pool.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -17,12 +18,15 @@
 #include "hipSYCL/runtime/kernel_cache.hpp"
 
 #include <algorithm>
+#include <mutex>
+#include <thread>
 
 namespace hipsycl {
 namespace rt {
 
 backend_manager::backend_manager()
-  : _hw_model(std::make_unique<hw_model>(this)),
+  : _all_backends_initialized{false},
+    _hw_model(std::make_unique<hw_model>(this)),
     _kernel_cache{kernel_cache::get()}
 {
 
@@ -30,19 +34,101 @@ backend_manager::backend_manager()
 
   for (std::size_t backend_index = 0;
        backend_index < _loader.get_num_backends(); ++backend_index) {
+    auto slot = std::make_unique<backend_slot>();
+    slot->loader_index = backend_index;
+    slot->id = backend_loader::get_backend_id(
+        _loader.get_backend_name(backend_index));
+    _backends.emplace_back(std::move(slot));
+  }
+
+  auto has_cpu_backend = [this]() {
+    return std::any_of(_backends.cbegin(), _backends.cend(),
+                       [](const std::unique_ptr<backend_slot> &slot) {
+                         return slot->instance &&
+                                slot->instance->get_hardware_platform() ==
+                                    hardware_platform::cpu;
+                       });
+  };
+
+  const bool eager_initialization =
+      application::get_settings().get<setting::eager_backend_initialization>();
+  if(!eager_initialization) {
+    for(auto& slot : _backends) {
+      if(slot->id == backend_id::omp)
+        initialize(*slot);
+    }
+  }
+  if(eager_initialization || !has_cpu_backend())
+    initialize_all_backends();
+
+  if(!has_cpu_backend())
+  {
+    HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
+    std::terminate();
+  }
+}
+
+backend_manager::~backend_manager()
+{
+  // Cached memory needs to be returned while the backend allocators
+  // still exist
+  allocation_pool::get().release_all();
+  _kernel_cache->unload();
+}
+
+backend *backend_manager::get(backend_id id) const {
+  auto has_id = [id](const std::unique_ptr<backend_slot> &slot) -> bool {
+    return slot->instance && slot->instance->get_backend_descriptor().id == id;
+  };
+
+  for(auto& slot : _backends) {
+    if(slot->id == id) {
+      initialize(*slot);
+      if(has_id(slot))
+        return slot->instance.get();
+    }
+  }
 
+  // The backend might be provided by a plugin with unexpected name
+  initialize_all_backends();
+  auto it = std::find_if(_backends.begin(), _backends.end(), has_id);
+  
+  if(it == _backends.end()){
+    register_error(
+        __acpp_here(),
+        error_info{"backend_manager: Requested backend is not available.",
+                   error_type::runtime_error});
+
+    return nullptr;
+  }
+  return (*it)->instance.get();
+}
+
+bool backend_manager::is_created(backend_id id) const {
+  for(auto& slot : _backends) {
+    if(slot->is_initialized.load(std::memory_order_acquire) && slot->instance &&
+       slot->instance->get_backend_descriptor().id == id)
+      return true;
+  }
+  return false;
+}
+
+void backend_manager::initialize(backend_slot &slot) const {
+  std::call_once(slot.init_flag, [&]() {
     HIPSYCL_DEBUG_INFO << "Registering backend: '"
-                       << _loader.get_backend_name(backend_index) << "'..."
+                       << _loader.get_backend_name(slot.loader_index) << "'..."
                        << std::endl;
-    backend *b = _loader.create(backend_index);
-    if (b) {
-      _backends.emplace_back(std::unique_ptr<backend>(b));
-    } else {
+    backend *b = _loader.create(slot.loader_index);
+    if (!b) {
       HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed" << std::endl;
+      return;
     }
-  }
-  
-  this->for_each_backend([](backend *b) {
+    slot.instance.reset(b);
+
+    // Backends might be initialized concurrently, keep their output together
+    static std::mutex output_mutex;
+    std::lock_guard<std::mutex> lock{output_mutex};
+
     HIPSYCL_DEBUG_INFO << "Discovered devices from backend '" << b->get_name()
                        << "': " << std::endl;
     backend_hardware_manager* hw_manager = b->get_hardware_manager();
@@ -58,37 +144,42 @@ backend_manager::backend_manager()
       }
     }
   });
+  slot.is_initialized.store(true, std::memory_order_release);
+}
 
-  if(std::none_of(_backends.cbegin(), _backends.cend(), 
-                  [](const std::unique_ptr<backend>& b){
-                    return b->get_hardware_platform() == hardware_platform::cpu;
-                    }))
-  {
-    HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
-    std::terminate();
+void backend_manager::initialize(const std::vector<backend_slot *> &slots) const {
+  std::vector<backend_slot*> pending;
+  for(backend_slot* slot : slots) {
+    if(!slot->is_initialized.load(std::memory_order_acquire))
+      pending.push_back(slot);
   }
-}
+  if(pending.empty())
+    return;
 
-backend_manager::~backend_manager()
-{
-  _kernel_cache->unload();
+  // Backends are independent, and their initialization is mostly
+  // spent waiting for drivers, so initialize them in parallel.
+  // Slots that are concurrently initialized by another thread
+  // wait for it in initialize().
+  std::vector<std::thread> workers;
+  for(std::size_t i = 1; i < pending.size(); ++i) {
+    backend_slot* slot = pending[i];
+    workers.emplace_back([this, slot]() { initialize(*slot); });
+  }
+  initialize(*pending.front());
+  for(auto& w : workers)
+    w.join();
 }
 
-backend *backend_manager::get(backend_id id) const {
-  auto it = std::find_if(_backends.begin(), _backends.end(),
-                         [id](const std::unique_ptr<backend> &b) -> bool {
-                           return b->get_backend_descriptor().id == id;
-                         });
-  
-  if(it == _backends.end()){
-    register_error(
-        __acpp_here(),
-        error_info{"backend_manager: Requested backend is not available.",
-                   error_type::runtime_error});
+void backend_manager::initialize_all_backends() const {
+  if(_all_backends_initialized.load(std::memory_order_acquire))
+    return;
 
-    return nullptr;
-  }
-  return it->get();
+  std::vector<backend_slot*> slots;
+  for(auto& slot : _backends)
+    slots.push_back(slot.get());
+  initialize(slots);
+
+  _all_backends_initialized.store(true, std::memory_order_release);
 }
 
 hw_model &backend_manager::hardware_model()
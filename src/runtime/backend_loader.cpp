@@ -129,19 +129,36 @@ bool is_plugin_active(const std::string& name)
   if(name == "omp") // we always need a cpu backend
     return true;
 
-  hipsycl::rt::backend_id id;
-  if(name == "cuda") {
-    id = hipsycl::rt::backend_id::cuda;
-  } else if(name == "hip") {
-    id = hipsycl::rt::backend_id::hip;
-  } else if(name == "ze") {
-    id = hipsycl::rt::backend_id::level_zero;
-  } else if(name == "ocl") {
-    id = hipsycl::rt::backend_id::ocl;
-  } else if(name == "metal") {
-    id = hipsycl::rt::backend_id::metal;
+  auto id = hipsycl::rt::backend_loader::get_backend_id(name);
+  if(!id)
+    return false;
+  return backends_active.find(*id) != backends_active.cend();
+}
+
+// Plugins are built as (lib)rt-backend-<name>, so the backend name
+// is usually known without having to load the plugin.
+bool get_backend_name_from_filename(const fs::path &p,
+                                    std::string &backend_name_out) {
+  std::string stem = p.stem().string();
+  const std::string lib_prefix = "lib";
+  const std::string plugin_prefix = "rt-backend-";
+
+  if(stem.compare(0, lib_prefix.size(), lib_prefix) == 0)
+    stem = stem.substr(lib_prefix.size());
+  if(stem.size() <= plugin_prefix.size() ||
+     stem.compare(0, plugin_prefix.size(), plugin_prefix) != 0)
+    return false;
+
+  backend_name_out = stem.substr(plugin_prefix.size());
+  return true;
+}
+
+void close_plugin(void* handle) {
+  std::string message = "";
+  close_library(handle, message);
+  if(!message.empty()) {
+    HIPSYCL_DEBUG_ERROR << "[backend_loader] " << message << std::endl;
   }
-  return backends_active.find(id) != backends_active.cend();
 }
 
 }
@@ -177,19 +194,25 @@ void backend_loader::query_backends() {
         auto p = entry.path();
         if (p.extension().string() == shared_lib_extension) {
           std::string backend_name;
+          if(get_backend_name_from_filename(p, backend_name)) {
+            if(!has_backend(backend_name) && is_plugin_active(backend_name)) {
+              HIPSYCL_DEBUG_INFO << "backend_loader: Found plugin: " << p
+                                << " for backend '" << backend_name << "'"
+                                << std::endl;
+              _plugins.push_back(plugin{backend_name, p.string(), nullptr});
+            }
+            continue;
+          }
+
           void *handle;
           if (load_plugin(p.string(), handle, backend_name)) {
             if(!has_backend(backend_name) && is_plugin_active(backend_name)){
               HIPSYCL_DEBUG_INFO << "backend_loader: Successfully opened plugin: " << p
                                 << " for backend '" << backend_name << "'"
                                 << std::endl;
-              _handles.emplace_back(std::make_pair(backend_name, handle));
+              _plugins.push_back(plugin{backend_name, p.string(), handle});
             } else {
-              std::string message = "";
-              close_library(handle, message);
-              if(!message.empty()) {
-                HIPSYCL_DEBUG_ERROR << "[backend_loader] " << message << std::endl;
-              }
+              close_plugin(handle);
             }
           }
         }
@@ -199,48 +222,79 @@ void backend_loader::query_backends() {
 }
 
 backend_loader::~backend_loader() {
-  for (auto &handle : _handles) {
-    assert(handle.second);
-
-    std::string message;
-    close_library(handle.second, message);
-    if (!message.empty()) {
-      HIPSYCL_DEBUG_ERROR << "[backend_loader] " << message << std::endl;
-    }
+  for (auto &p : _plugins) {
+    if(p.handle)
+      close_plugin(p.handle);
   }
 }
 
-std::size_t backend_loader::get_num_backends() const { return _handles.size(); }
+std::size_t backend_loader::get_num_backends() const { return _plugins.size(); }
 
 std::string backend_loader::get_backend_name(std::size_t index) const {
-  assert(index < _handles.size());
-  return _handles[index].first;
+  assert(index < _plugins.size());
+  return _plugins[index].backend_name;
 }
 
 bool backend_loader::has_backend(const std::string &name) const {
-  for (const auto &h : _handles) {
-    if (h.first == name)
+  for (const auto &p : _plugins) {
+    if (p.backend_name == name)
       return true;
   }
 
   return false;
 }
 
-backend *backend_loader::create(std::size_t index) const {
-  assert(index < _handles.size());
+backend *backend_loader::create(std::size_t index) {
+  assert(index < _plugins.size());
+  plugin& p = _plugins[index];
+
+  if(!p.handle) {
+    std::string backend_name;
+    if(!load_plugin(p.path, p.handle, backend_name)) {
+      p.handle = nullptr;
+      return nullptr;
+    }
+    HIPSYCL_DEBUG_INFO << "backend_loader: Successfully opened plugin: "
+                       << p.path << " for backend '" << backend_name << "'"
+                       << std::endl;
+    if(backend_name != p.backend_name) {
+      HIPSYCL_DEBUG_WARNING << "backend_loader: Plugin " << p.path
+                            << " implements backend '" << backend_name
+                            << "', expected '" << p.backend_name << "'"
+                            << std::endl;
+    }
+  }
   
-  return create_backend(_handles[index].second);
+  return create_backend(p.handle);
 }
 
-backend *backend_loader::create(const std::string &name) const {
+backend *backend_loader::create(const std::string &name) {
   
-  for (std::size_t i = 0; i < _handles.size(); ++i) {
-    if (_handles[i].first == name)
+  for (std::size_t i = 0; i < _plugins.size(); ++i) {
+    if (_plugins[i].backend_name == name)
       return create(i);
   }
 
   return nullptr;
 }
 
+std::optional<backend_id>
+backend_loader::get_backend_id(const std::string &backend_name) {
+  if(backend_name == "cuda") {
+    return backend_id::cuda;
+  } else if(backend_name == "hip") {
+    return backend_id::hip;
+  } else if(backend_name == "ze") {
+    return backend_id::level_zero;
+  } else if(backend_name == "ocl") {
+    return backend_id::ocl;
+  } else if(backend_name == "metal") {
+    return backend_id::metal;
+  } else if(backend_name == "omp") {
+    return backend_id::omp;
+  }
+  return {};
+}
+
 } // namespace rt
 } // namespace hipsycl
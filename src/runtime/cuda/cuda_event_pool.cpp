@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/cuda/cuda_event_pool.hpp"
 #include "hipSYCL/runtime/cuda/cuda_device_manager.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include <cuda_runtime_api.h>
 
@@ -46,7 +47,9 @@ result cuda_event_factory::destroy(cudaEvent_t evt) {
 }
 
 cuda_event_pool::cuda_event_pool(int device_id)
-: event_pool<cuda_event_factory>{cuda_event_factory{device_id}} {}
+: event_pool<cuda_event_factory>{
+      cuda_event_factory{device_id},
+      application::get_settings().get<setting::event_pool_max_size>()} {}
 
 }
 }
\ No newline at end of file
@@ -223,6 +223,13 @@ cuda_queue::cuda_queue(cuda_backend *be, device_id dev, int priority)
       _kernel_cache{kernel_cache::get()} {
   this->activate_device();
 
+  // Create some events ahead of time, so that the first submissions to
+  // this queue do not have to.
+  auto prealloc_err = _backend->get_event_pool(_dev)->preallocate(
+      application::get_settings().get<setting::event_pool_preallocation>());
+  if(!prealloc_err.is_success())
+    register_error(prealloc_err);
+
   cuda_hardware_context *ctx = static_cast<cuda_hardware_context *>(
       this->_backend->get_hardware_manager()->get_device(dev.get_id()));
   
@@ -683,7 +690,14 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
   _config.set_build_option(kernel_build_option::ptx_target_device,
                           this->_ptx_target);
 
+  auto create_translator = [](const std::vector<std::string> &kernel_names) {
+    return compiler::createLLVMToPtxTranslator(kernel_names);
+  };
+
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
+  binary_configuration_id = adaptivity_engine.defer_specialization(
+      _config, binary_configuration_id, *_kernel_cache, _reflection_map,
+      create_translator);
   auto code_object_configuration_id = binary_configuration_id;
   kernel_configuration::extend_hash(
       code_object_configuration_id,
@@ -694,27 +708,10 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    
-    std::vector<std::string> kernel_names;
-    std::string selected_image_name = get_image_and_kernel_names(kernel_names);
-
-    // Construct PTX translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      compiler::createLLVMToPtxTranslator(kernel_names);
-
-    // Lower kernels to PTX
-    bool enable_dead_arg_elimination = kernel_names.size() == 1;
-    rt::result err = glue::jit::compile_and_store_stats(
-        translator.get(), hcf_object, selected_image_name, _config,
-        binary_configuration_id, _reflection_map, compiled_image,
-        enable_dead_arg_elimination);
-
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+  auto jit_compiler = [&](std::string &compiled_image) -> bool {
+    return adaptivity_engine.make_jit_compiler(
+        _config, binary_configuration_id, _reflection_map,
+        create_translator)(compiled_image);
   };
 
   auto code_object_constructor = [&](const std::string& ptx_image) -> code_object* {
@@ -180,7 +180,7 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
     }
   };
 
-  auto operation_node = std::make_shared<dag_node>(
+  auto operation_node = make_dag_node(
       hints, requirements.get(), std::move(op), _rt);
   
   bool is_req = operation_node->get_operation()->is_requirement();
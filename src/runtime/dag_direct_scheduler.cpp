@@ -22,6 +22,8 @@
 #include "hipSYCL/runtime/generic/multi_event.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -107,56 +109,79 @@ result ensure_allocation_exists(runtime *rt,
   return make_success();
 }
 
-void for_each_explicit_operation(
-    dag_node_ptr node, std::function<void(operation *)> explicit_op_handler) {
-  if (node->is_submitted())
-    return;
-  
-  if (!node->get_operation()->is_requirement()) {
-    explicit_op_handler(node->get_operation());
-    return;
-  } else {
-    execute_if_buffer_requirement(node,
-                                  [&](buffer_memory_requirement *bmem_req) {
-          
-          device_id target_device = node->get_assigned_device();
-
-          std::vector<range_store::rect> outdated_regions;
-          bmem_req->get_data_region()->get_outdated_regions(
-              target_device, bmem_req->get_access_offset3d(),
-              bmem_req->get_access_range3d(), outdated_regions);
-
-          for (range_store::rect region : outdated_regions) {
-            std::vector<std::pair<device_id, range_store::rect>> update_sources;
-
-            bmem_req->get_data_region()->get_update_source_candidates(
-                target_device, region, update_sources);
-
-            if (update_sources.empty()) {
-              register_error(
-                  __acpp_here(),
-                  error_info{"dag_direct_scheduler: Could not obtain data "
-                             "update sources when trying to materialize "
-                             "implicit requirement"});
-              node->cancel();
-              return;
-            }
-
-            // Just use first source for now:
-            memory_location src{update_sources[0].first,
-                                update_sources[0].second.first,
-                                bmem_req->get_data_region()};
-            memory_location dest{target_device, region.first,
-                                 bmem_req->get_data_region()};
-            std::unique_ptr<operation> op =
-                std::make_unique<memcpy_operation>(src, dest, region.second);
-
-            explicit_op_handler(op.get());
-            /// TODO This has to be changed once we support multi-operation nodes
-            node->assign_effective_operation(std::move(op));
-          }
-        });
+struct data_transfer {
+  std::unique_ptr<operation> op;
+  // Index of a transfer that has to complete before this one, or -1
+  int dependency = -1;
+};
+
+// Generates the data transfers required to make the data accessed
+// by a buffer requirement available on the assigned device.
+result generate_data_transfers(runtime *rt, buffer_memory_requirement *bmem_req,
+                               device_id target_device,
+                               std::vector<data_transfer> &transfers) {
+  memcpy_model *model = rt->backends().hardware_model().get_memcpy_model();
+  auto data_region = bmem_req->get_data_region();
+
+  std::vector<range_store::rect> outdated_regions;
+  data_region->get_outdated_regions(
+      target_device, bmem_req->get_access_offset3d(),
+      bmem_req->get_access_range3d(), outdated_regions);
+
+  for (range_store::rect region : outdated_regions) {
+    std::vector<std::pair<device_id, range_store::rect>> update_sources;
+
+    data_region->get_update_source_candidates(target_device, region,
+                                              update_sources);
+
+    if (update_sources.empty()) {
+      return make_error(
+          __acpp_here(),
+          error_info{"dag_direct_scheduler: Could not obtain data "
+                     "update sources when trying to materialize "
+                     "implicit requirement"});
+    }
+
+    std::vector<device_id> source_devices;
+    for(const auto& source : update_sources)
+      source_devices.push_back(source.first);
+
+    // If several devices hold the data, the region may be
+    // split across them to transfer in parallel.
+    auto parts = model->split_transfer(rt, source_devices, target_device,
+                                       region.first, region.second,
+                                       data_region->get_element_size());
+
+    for(const auto& part : parts) {
+      device_id source_device = source_devices[part.source_index];
+
+      if(model->requires_host_staging(source_device, target_device)) {
+        device_id host_device{
+            backend_descriptor{hardware_platform::cpu, api_platform::omp}, 0};
+        // The host copy of this region is outdated, so it can be
+        // overwritten freely.
+        auto err = ensure_allocation_exists(rt, bmem_req, host_device);
+        if(!err.is_success())
+          return err;
+
+        memory_location src{source_device, part.offset, data_region};
+        memory_location staging{host_device, part.offset, data_region};
+        memory_location dest{target_device, part.offset, data_region};
+
+        transfers.push_back(data_transfer{
+            std::make_unique<memcpy_operation>(src, staging, part.extent)});
+        transfers.push_back(data_transfer{
+            std::make_unique<memcpy_operation>(staging, dest, part.extent),
+            static_cast<int>(transfers.size()) - 1});
+      } else {
+        memory_location src{source_device, part.offset, data_region};
+        memory_location dest{target_device, part.offset, data_region};
+        transfers.push_back(data_transfer{
+            std::make_unique<memcpy_operation>(src, dest, part.extent)});
+      }
+    }
   }
+  return make_success();
 }
 
 std::pair<backend_executor *, device_id>
@@ -254,48 +279,83 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
                   bmem_req->get_access_range3d());
         });
     if(has_initialized_content){
-      for_each_explicit_operation(req, [&](operation *op) {
-        if (!op->is_data_transfer()) {
-          res = make_error(
-              __acpp_here(),
-              error_info{
-                  "dag_direct_scheduler: only data transfers are supported "
-                  "as operations generated from implicit requirements.",
-                  error_type::feature_not_supported});
+      std::vector<data_transfer> transfers;
+      execute_if_buffer_requirement(
+          req, [&](buffer_memory_requirement *bmem_req) {
+            res = generate_data_transfers(rt, bmem_req,
+                                          req->get_assigned_device(), transfers);
+          });
+      if (!res.is_success())
+        return res;
+
+      // All transfers but the last one are submitted as separate nodes, such
+      // that they can run in parallel. The last transfer is carried out by
+      // the requirement node itself, which then depends on all the others.
+      node_list_t original_reqs;
+      for(const auto& weak_req : req->get_requirements())
+        if(auto r = weak_req.lock())
+          original_reqs.push_back(r);
+
+      node_list_t transfer_nodes;
+      for(std::size_t i = 0; i < transfers.size(); ++i) {
+        operation* op = transfers[i].op.get();
+        const bool is_last = (i == transfers.size() - 1);
+
+        dag_node_ptr node = req;
+        if(!is_last) {
+          node_list_t node_reqs = original_reqs;
+          if(transfers[i].dependency >= 0)
+            node_reqs.push_back(transfer_nodes[transfers[i].dependency]);
+          node = make_dag_node(execution_hints{}, node_reqs,
+                               std::move(transfers[i].op), rt);
         } else {
-          std::pair<backend_executor *, device_id> execution_config =
-              select_executor(rt, req, op);
-          // TODO What if we need to copy between two device backends through
-          // host?
-          
-          // TODO: The following is super-hacky and hints that we might
-          // have to do some larger architectural changes here:
-          //
-          // For host accessors, their target device will be set to the host
-          // device, but that might not be the correct device to carry
-          // out the memcpy, because the host device cannot access e.g. GPU memory.
-          // So we set the assigned device to the one we get from select_executor()
-          // which takes such considerations into account.
-          // Without this, since the executor tries to execute on the device
-          // assigned to the node, it might attempt to dispatch to some invalid device.
-          //
-          // However, at the end of submit() below this section, we then try to
-          // to update the data state for device assigned to the node.
-          // For a host accessor, because we have in fact updated the host memory,
-          // we need to be able to obtain the original device at this point.
-          //
-          // We solve this by ensuring that the bind_to_device hint is always present
-          // and returns the target device id. get_assigned_device() instead reaturns
-          // the device that has processed the data transfer.
-          //
-          // We CANNOT assign_to_device the original device after the submit call,
-          // since the executors need to know which device actually has processed
-          // the operation to setup dependencies correctly.
-          auto original_device = req->get_assigned_device();
-          req->assign_to_device(execution_config.second);
-          submit(execution_config.first, req, op);
+          for(const auto& transfer_node : transfer_nodes)
+            req->add_requirement(transfer_node);
         }
-      });
+
+        std::pair<backend_executor *, device_id> execution_config =
+            select_executor(rt, node, op);
+
+        // TODO: The following is super-hacky and hints that we might
+        // have to do some larger architectural changes here:
+        //
+        // For host accessors, their target device will be set to the host
+        // device, but that might not be the correct device to carry
+        // out the memcpy, because the host device cannot access e.g. GPU memory.
+        // So we set the assigned device to the one we get from select_executor()
+        // which takes such considerations into account.
+        // Without this, since the executor tries to execute on the device
+        // assigned to the node, it might attempt to dispatch to some invalid device.
+        //
+        // However, at the end of submit() below this section, we then try to
+        // to update the data state for device assigned to the node.
+        // For a host accessor, because we have in fact updated the host memory,
+        // we need to be able to obtain the original device at this point.
+        //
+        // We solve this by ensuring that the bind_to_device hint is always present
+        // and returns the target device id. get_assigned_device() instead reaturns
+        // the device that has processed the data transfer.
+        //
+        // We CANNOT assign_to_device the original device after the submit call,
+        // since the executors need to know which device actually has processed
+        // the operation to setup dependencies correctly.
+        node->assign_to_device(execution_config.second);
+        if(!is_last) {
+          node->get_execution_hints().set_hint(
+              hints::bind_to_device{execution_config.second});
+        }
+        submit(execution_config.first, node, op);
+
+        if(!is_last) {
+          // Allows waiting for the transfer, and keeps the node alive
+          // until it has completed.
+          rt->dag().register_submitted_ops(node);
+          transfer_nodes.push_back(node);
+        } else {
+          /// TODO This has to be changed once we support multi-operation nodes
+          req->assign_effective_operation(std::move(transfers[i].op));
+        }
+      }
     }
   }
   if (!res.is_success())
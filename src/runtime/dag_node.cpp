@@ -17,16 +17,18 @@
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/generic/multi_event.hpp"
+#include "hipSYCL/common/pooled_allocator.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 dag_node::dag_node(const execution_hints &hints,
                    const node_list_t &requirements,
-                   std::unique_ptr<operation> op,
+                   std::shared_ptr<operation> op,
                    runtime* rt)
     : _hints{hints},
-      _assigned_executor{nullptr}, _event{nullptr}, _operation{std::move(op)},
+      _assigned_executor{nullptr}, _assigned_execution_lane{nullptr},
+      _assigned_execution_index{0}, _event{nullptr}, _operation{std::move(op)},
       _is_submitted{false}, _is_complete{false}, _is_virtual{false},
       _is_cancelled{false}, _rt{rt} {
   
@@ -36,6 +38,23 @@ dag_node::dag_node(const execution_hints &hints,
 
 dag_node::~dag_node() {}
 
+dag_node_ptr make_dag_node(const execution_hints &hints,
+                           const node_list_t &requirements,
+                           std::unique_ptr<operation> op, runtime *rt) {
+  // Allocate the control block of the operation from the pool as well
+  std::shared_ptr<operation> shared_op{op.release(),
+                                       std::default_delete<operation>{},
+                                       common::pooled_allocator<operation>{}};
+  return make_dag_node(hints, requirements, std::move(shared_op), rt);
+}
+
+dag_node_ptr make_dag_node(const execution_hints &hints,
+                           const node_list_t &requirements,
+                           std::shared_ptr<operation> op, runtime *rt) {
+  return std::allocate_shared<dag_node>(common::pooled_allocator<dag_node>{},
+                                        hints, requirements, std::move(op), rt);
+}
+
 bool dag_node::is_submitted() const { return _is_submitted; }
 
 bool dag_node::is_complete() const {
@@ -220,6 +239,10 @@ void dag_node::add_requirement(dag_node_ptr requirement)
 
 operation *dag_node::get_operation() const { return _operation.get(); }
 
+std::shared_ptr<operation> dag_node::get_shared_operation() const {
+  return _operation;
+}
+
 const weak_node_list_t &dag_node::get_requirements() const
 {
   return _requirements;
@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include <cassert>
 #include <algorithm>
+#include <iterator>
 
 #include "hipSYCL/runtime/dag_submitted_ops.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
@@ -18,51 +19,81 @@
 namespace hipsycl {
 namespace rt {
 
-namespace {
+dag_submitted_ops::~dag_submitted_ops() {
+  std::lock_guard lock{_lock};
+  this->purge_known_completed();
+}
 
-void erase_known_completed_nodes(std::vector<dag_node_ptr> &ops) {
-  ops.erase(std::remove_if(ops.begin(), ops.end(),
-                           [&](dag_node_ptr node) -> bool {
-                             return node->is_known_complete();
-                           }),
-            ops.end());
+bool dag_submitted_ops::is_retired(const entry &e) {
+  return e.node->is_known_complete() ||
+         (e.lane->is_in_order &&
+          e.execution_index <=
+              e.lane->completed_index.load(std::memory_order_acquire));
 }
+
+void dag_submitted_ops::mark_completed(const entry &e) {
+  if(!e.lane->is_in_order)
+    return;
+  if(e.lane->completed_index.load(std::memory_order_relaxed) <
+     e.execution_index)
+    e.lane->completed_index.store(e.execution_index,
+                                  std::memory_order_release);
 }
 
-dag_submitted_ops::~dag_submitted_ops() {
-  this->purge_known_completed();
+void dag_submitted_ops::retire_lane_front(lane_ops &lane) {
+  while(!lane.ops.empty() && is_retired(lane.ops.front())) {
+    lane.ops.pop_front();
+    --_num_nodes;
+  }
 }
 
-void dag_submitted_ops::copy_node_list(std::vector<dag_node_ptr>& out) const {
-  std::lock_guard lock{_lock};
-  out = _ops;
+template<class LaneIterator>
+LaneIterator dag_submitted_ops::retire_lane(LaneIterator it) {
+  lane_ops& lane = *it->second;
+  if(lane.is_in_order) {
+    retire_lane_front(lane);
+  } else {
+    // Nodes without lane might complete in any order
+    auto &ops = lane.ops;
+    std::size_t old_size = ops.size();
+    ops.erase(std::remove_if(ops.begin(), ops.end(), is_retired), ops.end());
+    _num_nodes -= old_size - ops.size();
+  }
+  if(lane.ops.empty())
+    return _lanes.erase(it);
+  return std::next(it);
 }
 
-void dag_submitted_ops::purge_known_completed() {
-  std::lock_guard lock{_lock};
+void dag_submitted_ops::retire_group_front(std::deque<entry> &group) {
+  while(!group.empty() && is_retired(group.front()))
+    group.pop_front();
+}
 
-  erase_known_completed_nodes(_ops);
+void dag_submitted_ops::purge_known_completed() {
+  for(auto it = _lanes.begin(); it != _lanes.end();)
+    it = retire_lane(it);
+
+  for(auto it = _groups.begin(); it != _groups.end();) {
+    retire_group_front(it->second);
+    if(it->second.empty())
+      it = _groups.erase(it);
+    else
+      ++it;
+  }
 }
 
 std::size_t dag_submitted_ops::get_num_nodes() const {
   std::lock_guard lock{_lock};
-  return _ops.size();
+  return _num_nodes;
 }
 
 void dag_submitted_ops::async_wait_and_unregister() {
     
     // If the updater thread is currently not busy with anything,
-    // create a new task that waits and purges all nodes starting
-    // from the most recent node
+    // create a new task that waits for and purges all nodes
     if(_updater_thread.queue_size() == 0) {
       _updater_thread([this](){
-        std::vector<dag_node_ptr> gc_node_list;
-        this->copy_node_list(gc_node_list);
-
-        for(int i = gc_node_list.size() - 1; i >= 0; --i)
-          gc_node_list[i]->wait();
-        
-        this->purge_known_completed();
+        this->wait_for_all();
       });
     }
 }
@@ -71,30 +102,89 @@ void dag_submitted_ops::update_with_submission(dag_node_ptr single_node) {
   std::lock_guard lock{_lock};
 
   assert(single_node->is_submitted());
-  _ops.push_back(single_node);
+
+  const void *lane_id = single_node->get_assigned_execution_lane();
+  auto &lane = _lanes[lane_id];
+  if(!lane) {
+    lane = std::make_shared<lane_ops>();
+    lane->is_in_order = lane_id != nullptr;
+  }
+
+  entry e{single_node, _next_submission_id++,
+          single_node->get_assigned_execution_index(), lane};
+
+  if(lane->is_in_order) {
+    retire_lane_front(*lane);
+    // Registration order mostly matches execution order,
+    // so the position is usually found right at the end.
+    auto pos = lane->ops.end();
+    while(pos != lane->ops.begin() &&
+          std::prev(pos)->execution_index > e.execution_index)
+      --pos;
+    lane->ops.insert(pos, e);
+  } else {
+    lane->ops.push_back(e);
+  }
+  ++_num_nodes;
+
+  if (const hints::node_group *g =
+          single_node->get_execution_hints().get_hint<hints::node_group>()) {
+    auto& group = _groups[g->get_id()];
+    retire_group_front(group);
+    group.push_back(e);
+  }
 }
 
 void dag_submitted_ops::wait_for_all() {
-  std::vector<dag_node_ptr> current_ops;
+  std::vector<entry> current_ops;
   {
     std::lock_guard lock{_lock};
-    current_ops = _ops;
+    for(auto it = _lanes.begin(); it != _lanes.end();) {
+      const lane_ops& lane = *it->second;
+      if(lane.is_in_order) {
+        // Once the most recent node of the lane completes,
+        // all others have completed as well.
+        if(!lane.ops.empty() && !is_retired(lane.ops.back()))
+          current_ops.push_back(lane.ops.back());
+      } else {
+        std::copy_if(lane.ops.begin(), lane.ops.end(),
+                     std::back_inserter(current_ops),
+                     [](const entry &e) { return !is_retired(e); });
+      }
+      it = retire_lane(it);
+    }
   }
-  
-  for(dag_node_ptr node : current_ops) {
-    assert(node->is_submitted());
-    node->wait();
+
+  // Wait for the newest nodes first; waiting on them might turn waits
+  // on earlier nodes into no-ops since dag_node::wait() also marks all
+  // requirements recursively as complete.
+  std::sort(current_ops.begin(), current_ops.end(),
+            [](const entry &a, const entry &b) {
+              return a.submission_id > b.submission_id;
+            });
+  for(const entry& e : current_ops) {
+    assert(e.node->is_submitted());
+    e.node->wait();
   }
+
+  std::lock_guard lock{_lock};
+  for(const entry& e : current_ops)
+    mark_completed(e);
+  purge_known_completed();
 }
 
 void dag_submitted_ops::wait_for_group(std::size_t node_group) {
   HIPSYCL_DEBUG_INFO << "dag_submitted_ops: Waiting for node group "
                      << node_group << std::endl;
   
-  std::vector<dag_node_ptr> current_ops;
+  std::vector<entry> current_ops;
   {
-    std::lock_guard lock{_lock};  
-    current_ops = _ops;
+    std::lock_guard lock{_lock};
+    auto it = _groups.find(node_group);
+    if(it == _groups.end())
+      return;
+    retire_group_front(it->second);
+    current_ops.assign(it->second.begin(), it->second.end());
   }
 
   // Iterate in reverse order over the nodes, since current_ops
@@ -102,19 +192,28 @@ void dag_submitted_ops::wait_for_group(std::size_t node_group) {
   // This means that the last nodes will be the newest. Waiting
   // on them first might turn waits on earlier nodes into no-ops
   // since dag_node::wait() also marks all requirements recursively
-  // as complete.
+  // as complete. The same holds for earlier nodes on the same lane.
   for(int i = current_ops.size() - 1; i >= 0; --i) {
-    const dag_node_ptr& node = current_ops[i];
-    assert(node->is_submitted());
-    if (const hints::node_group *g =
-            node->get_execution_hints().get_hint<hints::node_group>()) {
-      if (g->get_id() == node_group) {
-        HIPSYCL_DEBUG_INFO
-            << "dag_submitted_ops: Waiting for node group; current node: "
-            << node.get() << std::endl;
-        node->wait();
-      }
-    }
+    const entry& e = current_ops[i];
+    assert(e.node->is_submitted());
+    if(is_retired(e))
+      continue;
+
+    HIPSYCL_DEBUG_INFO
+        << "dag_submitted_ops: Waiting for node group; current node: "
+        << e.node.get() << std::endl;
+    e.node->wait();
+
+    std::lock_guard lock{_lock};
+    mark_completed(e);
+  }
+
+  std::lock_guard lock{_lock};
+  auto it = _groups.find(node_group);
+  if(it != _groups.end()) {
+    retire_group_front(it->second);
+    if(it->second.empty())
+      _groups.erase(it);
   }
 }
 
@@ -123,13 +222,13 @@ node_list_t dag_submitted_ops::get_group(std::size_t node_group) {
   node_list_t ops;
   {
     std::lock_guard lock{_lock};
-    for(dag_node_ptr node : _ops) {
-      assert(node->is_submitted());
-      if (const hints::node_group *g =
-              node->get_execution_hints().get_hint<hints::node_group>()) {
-        if (g->get_id() == node_group) {
-          ops.push_back(node);
-        }
+    auto it = _groups.find(node_group);
+    if(it != _groups.end()) {
+      retire_group_front(it->second);
+      for(const entry& e : it->second) {
+        assert(e.node->is_submitted());
+        if(!is_retired(e))
+          ops.push_back(e.node);
       }
     }
   }
@@ -139,9 +238,10 @@ node_list_t dag_submitted_ops::get_group(std::size_t node_group) {
 bool dag_submitted_ops::contains_node(dag_node_ptr node) const {
   std::lock_guard lock{_lock};
 
-  for(dag_node_ptr n : _ops) {
-    if(n == node)
-      return true;
+  for(const auto& lane : _lanes) {
+    for(const entry& e : lane.second->ops)
+      if(e.node == node)
+        return true;
   }
   return false;
 }
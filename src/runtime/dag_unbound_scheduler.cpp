@@ -16,27 +16,199 @@
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/instrumentation.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+#include <cassert>
+#include <limits>
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Runtime that is assumed for operations for which no measurements
+// are available.
+constexpr double nominal_operation_runtime = 1.e-4; // seconds
+// Assumed bandwidth of data migrations between devices.
+constexpr double nominal_migration_bandwidth = 1.e10; // bytes/second
+// Weight of new samples in the kernel runtime moving average
+constexpr double runtime_average_weight = 0.25;
+
+template <class Handler>
+void for_each_buffer_requirement(const dag_node_ptr &node, Handler &&h) {
+  for (auto weak_req : node->get_requirements()) {
+    if (auto req = weak_req.lock()) {
+      if (req->get_operation()->is_requirement() &&
+          cast<requirement>(req->get_operation())->is_memory_requirement() &&
+          cast<memory_requirement>(req->get_operation())
+              ->is_buffer_requirement()) {
+        h(cast<buffer_memory_requirement>(req->get_operation()));
+      }
+    }
+  }
+}
+
+// Number of bytes that would need to be migrated to \c dev before
+// the requirement could be satisfied there.
+std::size_t get_num_bytes_to_migrate(buffer_memory_requirement *bmem_req,
+                                     const device_id &dev) {
+  sycl::access::mode mode = bmem_req->get_access_mode();
+  if (mode == sycl::access::mode::discard_write ||
+      mode == sycl::access::mode::discard_read_write)
+    return 0;
+
+  auto data = bmem_req->get_data_region();
+  if (!data->has_allocation(dev)) {
+    if (!data->has_initialized_content(bmem_req->get_access_offset3d(),
+                                       bmem_req->get_access_range3d()))
+      return 0;
+    return bmem_req->get_required_size();
+  }
+
+  std::vector<range_store::rect> outdated_regions;
+  data->get_outdated_regions(dev, bmem_req->get_access_offset3d(),
+                             bmem_req->get_access_range3d(), outdated_regions);
+  std::size_t num_elements = 0;
+  for (const auto &r : outdated_regions)
+    num_elements += r.second.size();
+
+  return num_elements * data->get_element_size();
+}
+
+const char* get_kernel_name(operation* op) {
+  if (dynamic_is<kernel_operation>(op))
+    return cast<kernel_operation>(op)->get_global_kernel_name();
+  return nullptr;
+}
+
+}
+
 dag_unbound_scheduler::dag_unbound_scheduler(runtime* rt)
 : _direct_scheduler{rt}, _rt{rt} {}
 
-void dag_unbound_scheduler::submit(dag_node_ptr node) {
-  if(_devices.empty()) {
-    // We cannot query this in the constructor, because
-    // when schedulers are constructed the runtime is typically
-    // locked because it is just starting up, so this would
-    // create a deadlock
-    _rt->backends().for_each_backend([this](backend *b) {
-      std::size_t num_devs = b->get_hardware_manager()->get_num_devices();
-      for (std::size_t i = 0; i < num_devs; ++i) {
-        this->_devices.push_back(b->get_hardware_manager()->get_device_id(i));
+dag_unbound_scheduler::device_state *
+dag_unbound_scheduler::get_device_state(const device_id &dev) {
+  for(auto& state : _devices)
+    if(state.dev == dev)
+      return &state;
+  return nullptr;
+}
+
+void dag_unbound_scheduler::update_device_state(device_state &state) {
+  auto &nodes = state.outstanding_nodes;
+  for (std::size_t i = 0; i < nodes.size();) {
+    dag_node_ptr node = nodes[i].node.lock();
+    if (!node || node->is_cancelled() || node->is_complete()) {
+      if (node && !node->is_cancelled() && nodes[i].kernel_name) {
+        // Node is complete, so instrumentations are available without waiting
+        const auto &instrs = node->get_operation()->get_instrumentations();
+        auto start =
+            instrs.get<instrumentations::execution_start_timestamp>();
+        auto finish =
+            instrs.get<instrumentations::execution_finish_timestamp>();
+        if (start && finish) {
+          double t = profiler_clock::seconds(finish->get_time_point()) -
+                     profiler_clock::seconds(start->get_time_point());
+          runtime_estimate &estimate =
+              state.kernel_runtimes[nodes[i].kernel_name];
+          if (estimate.num_samples == 0)
+            estimate.average = t;
+          else
+            estimate.average =
+                (1.0 - runtime_average_weight) * estimate.average +
+                runtime_average_weight * t;
+          ++estimate.num_samples;
+        }
       }
-    });
+      nodes[i] = std::move(nodes.back());
+      nodes.pop_back();
+    } else {
+      ++i;
+    }
   }
+}
 
+double dag_unbound_scheduler::estimate_runtime(const char *kernel_name,
+                                               const device_state &state) const {
+  if (!kernel_name)
+    return nominal_operation_runtime;
+
+  auto it = state.kernel_runtimes.find(kernel_name);
+  if (it != state.kernel_runtimes.end())
+    return it->second.average;
+
+  // Without measurements of the kernel on this device, assume that it
+  // behaves like the average of the devices where it has been measured.
+  double sum = 0.0;
+  std::size_t num_measured_devices = 0;
+  for (const auto &other : _devices) {
+    auto other_it = other.kernel_runtimes.find(kernel_name);
+    if (other_it != other.kernel_runtimes.end()) {
+      sum += other_it->second.average;
+      ++num_measured_devices;
+    }
+  }
+  if (num_measured_devices > 0)
+    return sum / num_measured_devices;
+  return nominal_operation_runtime;
+}
+
+double dag_unbound_scheduler::estimate_completion_time(
+    const dag_node_ptr &node, const device_state &state) const {
+  double outstanding_work = 0.0;
+  for (const auto &outstanding : state.outstanding_nodes)
+    outstanding_work += estimate_runtime(outstanding.kernel_name, state);
+
+  std::size_t num_migrated_bytes = 0;
+  for_each_buffer_requirement(node, [&](buffer_memory_requirement *bmem_req) {
+    num_migrated_bytes += get_num_bytes_to_migrate(bmem_req, state.dev);
+  });
+
+  return outstanding_work +
+         static_cast<double>(num_migrated_bytes) / nominal_migration_bandwidth +
+         estimate_runtime(get_kernel_name(node->get_operation()), state);
+}
+
+device_id
+dag_unbound_scheduler::place(const dag_node_ptr &node,
+                             const std::vector<device_id> &eligible_devices) {
+  assert(!eligible_devices.empty());
+
+  for(const auto& dev : eligible_devices) {
+    if(!get_device_state(dev)) {
+      device_state state;
+      state.dev = dev;
+      _devices.push_back(std::move(state));
+    }
+  }
+
+  device_state* target = nullptr;
+  double best_completion_time = std::numeric_limits<double>::max();
+  for(const auto& dev : eligible_devices) {
+    device_state* state = get_device_state(dev);
+    update_device_state(*state);
+
+    double completion_time = estimate_completion_time(node, *state);
+    HIPSYCL_DEBUG_INFO << "dag_unbound_scheduler: Estimated completion time "
+                       << "on device " << dev.get_id() << " of backend "
+                       << static_cast<int>(dev.get_backend()) << ": "
+                       << completion_time << "s" << std::endl;
+    if(completion_time < best_completion_time) {
+      best_completion_time = completion_time;
+      target = state;
+    }
+  }
+  assert(target);
+
+  if(!node->get_operation()->is_requirement())
+    target->outstanding_nodes.push_back(
+        outstanding_node{node, get_kernel_name(node->get_operation())});
+  return target->dev;
+}
+
+void dag_unbound_scheduler::submit(dag_node_ptr node) {
   if(!node->get_execution_hints().has_hint<hints::bind_to_device>()){
     std::vector<rt::device_id> eligible_devices;
     if(node->get_execution_hints().has_hint<hints::bind_to_device_group>()) {
@@ -44,7 +216,27 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
                              .get_hint<hints::bind_to_device_group>()
                              ->get_devices();
     } else {
-      eligible_devices = _devices;
+      if(!_all_devices_known) {
+        // We cannot query this in the constructor, because
+        // when schedulers are constructed the runtime is typically
+        // locked because it is just starting up, so this would
+        // create a deadlock. This also avoids creating all backends
+        // when nodes are already bound to devices.
+        _rt->backends().for_each_backend([this](backend *b) {
+          std::size_t num_devs = b->get_hardware_manager()->get_num_devices();
+          for (std::size_t i = 0; i < num_devs; ++i) {
+            device_id dev = b->get_hardware_manager()->get_device_id(i);
+            if(!this->get_device_state(dev)) {
+              device_state state;
+              state.dev = dev;
+              this->_devices.push_back(std::move(state));
+            }
+          }
+        });
+        _all_devices_known = true;
+      }
+      for(const auto& state : _devices)
+        eligible_devices.push_back(state.dev);
     }
 
     if(eligible_devices.empty()) {
@@ -56,13 +248,9 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
       node->cancel();
       return;
     }
-    // Round-robin as placeholder. This is not intended
-    // for anything practical, it's a _placeholder_
-    static std::size_t dev = 0;
-    ++dev;
 
-    rt::device_id target_dev = eligible_devices[dev % eligible_devices.size()];
-    node->get_execution_hints().set_hint(rt::hints::bind_to_device{target_dev});
+    node->get_execution_hints().set_hint(
+        rt::hints::bind_to_device{place(node, eligible_devices)});
   }
 
   _direct_scheduler.submit(node);
@@ -70,4 +258,3 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
 
 }
 }
-
@@ -11,14 +11,36 @@
 #include "hipSYCL/runtime/generic/async_worker.hpp"
 #include "hipSYCL/common/debug.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <mutex>
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Bounds for the number of iterations the worker thread spins for
+// new work before it goes to sleep
+constexpr int min_worker_spin_iterations = 64;
+constexpr int max_worker_spin_iterations = 1 << 14;
+// Number of iterations a thread in wait() spins before going to sleep
+constexpr int waiter_spin_iterations = 1024;
+
+inline void spin_pause() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+}
+
 worker_thread::worker_thread()
-    : _continue{true}
+    : _continue{true}, _num_pending_operations{0},
+      _num_overflow_operations{0}, _is_worker_sleeping{false},
+      _num_sleeping_waiters{0}
 {
   _worker_thread = std::thread{[this](){ work(); } };
 }
@@ -28,20 +50,22 @@ worker_thread::~worker_thread()
 {
   halt();
 
-  assert(_enqueued_operations.empty());
+  assert(queue_size() == 0);
 }
 
 void worker_thread::wait()
 {
-  std::unique_lock<std::mutex> lock(_mutex);
-  if(!_enqueued_operations.empty())
-  {
-    // Before going to sleep, wake up the other thread to avoid deadlocks
-    _condition_wait.notify_all();
-    // Wait until no operation is pending
-    _condition_wait.wait(lock, [this]{return _enqueued_operations.empty();});
+  for(int i = 0; i < waiter_spin_iterations; ++i) {
+    if(_num_pending_operations.load() == 0)
+      return;
+    spin_pause();
   }
-  assert(_enqueued_operations.empty());
+
+  std::unique_lock<std::mutex> lock(_sleep_mutex);
+  ++_num_sleeping_waiters;
+  _waiter_wakeup.wait(lock,
+                      [this] { return _num_pending_operations.load() == 0; });
+  --_num_sleeping_waiters;
 }
 
 
@@ -50,77 +74,116 @@ void worker_thread::halt()
   wait();
 
   {
-    std::unique_lock<std::mutex> lock(_mutex);
+    std::unique_lock<std::mutex> lock(_sleep_mutex);
     _continue = false;
-    _condition_wait.notify_all();
+    _worker_wakeup.notify_all();
   }
   if(_worker_thread.joinable())
     _worker_thread.join();
 }
 
+bool worker_thread::try_dequeue(async_task& out) {
+  if(_enqueued_operations.try_pop(out))
+    return true;
+
+  // Tasks only end up in the overflow queue if the ring buffer was full
+  // at the time, so they are newer than all tasks in the ring buffer.
+  if(_num_overflow_operations.load() > 0) {
+    std::lock_guard<std::mutex> lock{_overflow_mutex};
+    if(!_overflow_operations.empty()) {
+      out = std::move(_overflow_operations.front());
+      _overflow_operations.pop();
+      --_num_overflow_operations;
+      return true;
+    }
+  }
+  return false;
+}
+
 void worker_thread::work()
 {
   // This is the main function executed by the worker thread.
-  // The loop is executed as long as there are enqueued operations,
-  // (_is_operation_pending) or we should wait for new operations
-  // (_continue).
-  while(_continue || queue_size() > 0)
+  // The loop is executed as long as there are pending operations,
+  // or we should wait for new operations (_continue).
+  int spin_iterations = min_worker_spin_iterations;
+  async_task operation;
+
+  while(true)
   {
-    {
-      std::unique_lock<std::mutex> lock(_mutex);
-
-      // Before going to sleep, wake up the other thread in case it is is waiting
-      // for the queue to get empty
-      _condition_wait.notify_all();
-      // Wait until we have work, or until _continue becomes false
-      _condition_wait.wait(lock,
-                           [this](){
-        return _enqueued_operations.size()>0 || !_continue;
-      });
+    if(try_dequeue(operation)) {
+      operation();
+      operation.reset();
+
+      if(_num_pending_operations.fetch_sub(1) == 1 &&
+         _num_sleeping_waiters.load() > 0) {
+        // Taking the lock guarantees that waiters have either
+        // not yet checked their wait condition, or are already asleep.
+        std::lock_guard<std::mutex> lock{_sleep_mutex};
+        _waiter_wakeup.notify_all();
+      }
+      continue;
     }
 
-    // In any way, process the pending operations
-
-    async_function operation = [](){};
-    bool has_operation = false;
+    // An operation has been announced, but the producer has not
+    // finished inserting it yet.
+    if(_num_pending_operations.load() > 0) {
+      spin_pause();
+      continue;
+    }
 
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
+    if(!_continue)
+      break;
 
-      if(!_enqueued_operations.empty())
-      {
-        operation = _enqueued_operations.front();
-        has_operation = true;
+    bool has_new_work = false;
+    for(int i = 0; i < spin_iterations; ++i) {
+      if(_num_pending_operations.load() > 0 || !_continue) {
+        has_new_work = true;
+        break;
       }
+      spin_pause();
     }
 
-    operation();
-
-    {
-      std::lock_guard<std::mutex> lock{_mutex};
-      if(has_operation)
-        _enqueued_operations.pop();
+    if(has_new_work) {
+      // Work arrives in quick succession, so spinning longer
+      // is likely to pay off.
+      spin_iterations = std::min(2 * spin_iterations, max_worker_spin_iterations);
+    } else {
+      spin_iterations = std::max(spin_iterations / 2, min_worker_spin_iterations);
+
+      std::unique_lock<std::mutex> lock(_sleep_mutex);
+      _is_worker_sleeping = true;
+      _worker_wakeup.wait(lock, [this]() {
+        return _num_pending_operations.load() > 0 || !_continue;
+      });
+      _is_worker_sleeping = false;
     }
-
-    _condition_wait.notify_all();
-
   }
 }
 
-void worker_thread::operator()(worker_thread::async_function f)
+void worker_thread::enqueue(async_task&& f)
 {
-  std::unique_lock<std::mutex> lock(_mutex);
-
-  _enqueued_operations.push(f);
+  // Announce the operation before inserting it, so that wait()
+  // cannot return before it has been processed.
+  ++_num_pending_operations;
+
+  if(_num_overflow_operations.load() > 0 ||
+     !_enqueued_operations.try_push(std::move(f))) {
+    std::lock_guard<std::mutex> lock{_overflow_mutex};
+    _overflow_operations.push(std::move(f));
+    ++_num_overflow_operations;
+  }
 
-  lock.unlock();
-  _condition_wait.notify_all();
+  if(_is_worker_sleeping.load()) {
+    // Taking the lock guarantees that the worker has either
+    // not yet checked its wait condition, or is already asleep.
+    std::lock_guard<std::mutex> lock{_sleep_mutex};
+    _worker_wakeup.notify_one();
+  }
 }
 
 std::size_t worker_thread::queue_size() const
 {
-  std::lock_guard<std::mutex> lock(_mutex);
-  return _enqueued_operations.size();
+  return _num_pending_operations.load();
 }
 
 
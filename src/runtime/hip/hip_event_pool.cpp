@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/hip/hip_event_pool.hpp"
 #include "hipSYCL/runtime/hip/hip_device_manager.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 
 namespace hipsycl {
@@ -44,7 +45,9 @@ result hip_event_factory::destroy(hipEvent_t evt) {
 }
 
 hip_event_pool::hip_event_pool(int device_id)
-: event_pool<hip_event_factory>{hip_event_factory{device_id}} {}
+: event_pool<hip_event_factory>{
+      hip_event_factory{device_id},
+      application::get_settings().get<setting::event_pool_max_size>()} {}
 
 
 }
@@ -9,32 +9,131 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/hw_model/memcpy.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <numeric>
+#include <string>
 
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+device_id get_host_device() {
+  return device_id{backend_descriptor{hardware_platform::cpu, api_platform::omp},
+                   0};
+}
+
+std::string get_link_id(device_id source, device_id dest) {
+  auto get_device_id = [](device_id dev) {
+    return std::to_string(static_cast<int>(dev.get_backend())) + "." +
+           std::to_string(dev.get_id());
+  };
+  return get_device_id(source) + "->" + get_device_id(dest);
+}
+
+}
+
+memcpy_model::memcpy_model(backend_manager* mgr)
+: _backends{mgr} {}
+
+bool memcpy_model::lookup_link(const std::string &link_id,
+                               link_properties &out) const {
+  auto it = _links.find(link_id);
+  if(it != _links.end()) {
+    out = it->second;
+    return true;
+  }
+  if(_unknown_links.count(link_id))
+    return false;
+
+  bool found = false;
+  common::filesystem::persistent_storage::get().get_this_app_db().read_access(
+      [&](const common::db::appdb_data &appdb) {
+        auto entry = appdb.transfer_links.find(link_id);
+        if (entry != appdb.transfer_links.end() &&
+            entry->second.bytes_per_sec > 0) {
+          out.latency = entry->second.latency_ns * 1.e-9;
+          out.bandwidth = static_cast<double>(entry->second.bytes_per_sec);
+          found = true;
+        }
+      });
+  if(found)
+    _links[link_id] = out;
+  else
+    _unknown_links.insert(link_id);
+  return found;
+}
+
+memcpy_model::link_properties
+memcpy_model::get_default_link(device_id source, device_id dest) {
+  // Rough estimates if no measurements are available; these only need to
+  // order the different kinds of links correctly.
+  if(source == dest) {
+    if(source.is_host())
+      return link_properties{1.e-6, 10.e9};
+    return link_properties{5.e-6, 300.e9};
+  }
+  if(source.is_host() || dest.is_host())
+    return link_properties{10.e-6, 12.e9};
+  return link_properties{10.e-6, 20.e9};
+}
+
+memcpy_model::link_properties
+memcpy_model::get_link(device_id source, device_id dest) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  link_properties link;
+  if(lookup_link(get_link_id(source, dest), link))
+    return link;
+  return get_default_link(source, dest);
+}
+
+bool memcpy_model::requires_host_staging(device_id source,
+                                         device_id dest) const {
+  return !source.is_host() && !dest.is_host() &&
+         source.get_backend() != dest.get_backend();
+}
+
+double memcpy_model::estimate_transfer_time(device_id source, device_id dest,
+                                            std::size_t num_bytes) const {
+  auto time = [&](device_id from, device_id to) {
+    link_properties link = get_link(from, to);
+    return link.latency + static_cast<double>(num_bytes) / link.bandwidth;
+  };
+
+  if(requires_host_staging(source, dest)) {
+    device_id host = get_host_device();
+    return time(source, host) + time(host, dest);
+  }
+  return time(source, dest);
+}
 
 cost_type
 memcpy_model::estimate_runtime_cost(const memory_location &source,
                                     const memory_location &dest,
                                     range<3> num_elements) const
 {
-  // Strongly prefer transfers from the same device to the same device
-  if(source.get_device() == dest.get_device())
-    return 1.0;
-
-  if (source.get_device().get_full_backend_descriptor().hw_platform ==
-      dest.get_device().get_full_backend_descriptor().hw_platform)
-    return 2.0;
-
-  return 3.0;
+  return estimate_transfer_time(source.get_device(), dest.get_device(),
+                                num_elements.size() * source.get_element_size());
 }
 
 memory_location memcpy_model::choose_source(
     const std::vector<memory_location> &candidate_sources,
-    const memory_location &target, range<3> num_elements) const 
+    const memory_location &target, range<3> num_elements) const
 {
   std::size_t best_transfer_index = 0;
   cost_type best_cost = std::numeric_limits<cost_type>::max();
@@ -50,5 +149,241 @@ memory_location memcpy_model::choose_source(
   return candidate_sources[best_transfer_index];
 }
 
+std::vector<memcpy_model::transfer_part> memcpy_model::split_transfer(
+    runtime *rt, const std::vector<device_id> &candidate_sources,
+    device_id target, id<3> offset, range<3> extent, std::size_t element_size) {
+
+  if(candidate_sources.empty())
+    return {};
+  if(candidate_sources.size() == 1)
+    return {transfer_part{0, offset, extent}};
+
+  if(application::get_settings().get<setting::memcpy_calibration>()) {
+    for(const auto& source : candidate_sources) {
+      if(requires_host_staging(source, target)) {
+        ensure_calibrated(rt, source, get_host_device());
+        ensure_calibrated(rt, get_host_device(), target);
+      } else {
+        ensure_calibrated(rt, source, target);
+      }
+    }
+  }
+
+  // Effective latency and bandwidth of each candidate, taking into account
+  // that staged transfers run sequentially over two links.
+  std::vector<link_properties> links;
+  for(const auto& source : candidate_sources) {
+    if(requires_host_staging(source, target)) {
+      link_properties first = get_link(source, get_host_device());
+      link_properties second = get_link(get_host_device(), target);
+      links.push_back(link_properties{
+          first.latency + second.latency,
+          1.0 / (1.0 / first.bandwidth + 1.0 / second.bandwidth)});
+    } else {
+      links.push_back(get_link(source, target));
+    }
+  }
+
+  const std::size_t num_bytes = extent.size() * element_size;
+  std::vector<std::size_t> order(candidate_sources.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    auto time = [&](std::size_t i) {
+      return links[i].latency + num_bytes / links[i].bandwidth;
+    };
+    return time(a) < time(b);
+  });
+
+  int split_dim = -1;
+  for(int i = 0; i < 3 && split_dim < 0; ++i)
+    if(extent[i] > 1)
+      split_dim = i;
+  if(split_dim < 0)
+    return {transfer_part{order[0], offset, extent}};
+
+  const std::size_t num_slices = extent[split_dim];
+  const double slice_bytes = static_cast<double>(num_bytes) / num_slices;
+
+  // Slices assigned to the fastest num_sources sources
+  auto distribute = [&](std::size_t num_sources) {
+    double total_bandwidth = 0.0;
+    for(std::size_t i = 0; i < num_sources; ++i)
+      total_bandwidth += links[order[i]].bandwidth;
+
+    std::vector<std::size_t> slices(num_sources);
+    std::size_t assigned = 0;
+    for(std::size_t i = 0; i < num_sources; ++i) {
+      slices[i] = std::max(
+          std::size_t{1},
+          static_cast<std::size_t>(num_slices * links[order[i]].bandwidth /
+                                   total_bandwidth));
+      slices[i] = std::min(slices[i], num_slices - assigned -
+                                          (num_sources - i - 1));
+      assigned += slices[i];
+    }
+    slices[0] += num_slices - assigned;
+    return slices;
+  };
+
+  auto estimate_time = [&](const std::vector<std::size_t>& slices) {
+    double t = 0.0;
+    for(std::size_t i = 0; i < slices.size(); ++i) {
+      const link_properties& link = links[order[i]];
+      t = std::max(t, link.latency + slices[i] * slice_bytes / link.bandwidth);
+    }
+    return t;
+  };
+
+  std::vector<std::size_t> best_slices = distribute(1);
+  double best_time = estimate_time(best_slices);
+  const std::size_t max_sources = std::min(order.size(), num_slices);
+  for(std::size_t n = 2; n <= max_sources; ++n) {
+    auto slices = distribute(n);
+    double t = estimate_time(slices);
+    // Only split if this is a clear improvement, since the model is
+    // not aware of contention e.g. on the target device.
+    if(t < 0.9 * best_time) {
+      best_time = t;
+      best_slices = slices;
+    }
+  }
+
+  std::vector<transfer_part> parts;
+  std::size_t slice_offset = 0;
+  for(std::size_t i = 0; i < best_slices.size(); ++i) {
+    transfer_part part{order[i], offset, extent};
+    part.offset[split_dim] += slice_offset;
+    part.extent[split_dim] = best_slices[i];
+    slice_offset += best_slices[i];
+    parts.push_back(part);
+  }
+  return parts;
+}
+
+void memcpy_model::ensure_calibrated(runtime *rt, device_id source,
+                                     device_id dest) {
+  std::string link_id = get_link_id(source, dest);
+
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    link_properties link;
+    if(lookup_link(link_id, link))
+      return;
+    // Some other thread is already measuring; use estimates until then.
+    if(!_links_in_calibration.insert(link_id).second)
+      return;
+  }
+
+  // Measuring waits for transfers to complete, so it must not block
+  // cost estimates of other threads.
+  link_properties link;
+  bool success = measure_link(rt, source, dest, link);
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  _links_in_calibration.erase(link_id);
+  if(!success) {
+    HIPSYCL_DEBUG_WARNING << "memcpy_model: Could not measure transfers "
+                          << link_id << ", using estimates" << std::endl;
+    // Do not attempt again
+    _links[link_id] = get_default_link(source, dest);
+    return;
+  }
+  HIPSYCL_DEBUG_INFO << "memcpy_model: Measured link " << link_id
+                     << ": latency " << link.latency * 1.e6 << " us, bandwidth "
+                     << link.bandwidth * 1.e-9 << " GB/s" << std::endl;
+  _links[link_id] = link;
+
+  common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_write_access([&](common::db::appdb_data &appdb) {
+        auto &entry = appdb.transfer_links[link_id];
+        entry.latency_ns = static_cast<uint64_t>(link.latency * 1.e9);
+        entry.bytes_per_sec = static_cast<uint64_t>(link.bandwidth);
+      });
+}
+
+bool memcpy_model::measure_link(runtime *rt, device_id source, device_id dest,
+                                link_properties &out) const {
+  constexpr std::size_t small_size = 4096;
+  constexpr std::size_t large_size = 32 * 1024 * 1024;
+  constexpr int num_repetitions = 3;
+
+  backend* source_backend = _backends->get(source.get_backend());
+  backend* dest_backend = _backends->get(dest.get_backend());
+  if(!source_backend || !dest_backend)
+    return false;
+
+  backend_allocator *source_allocator = source_backend->get_allocator(source);
+  backend_allocator *dest_allocator = dest_backend->get_allocator(dest);
+  void *source_ptr = allocate_device(source_allocator, 0, large_size);
+  void *dest_ptr = allocate_device(dest_allocator, 0, large_size);
+
+  auto time_transfer = [&](std::size_t num_bytes, double &seconds_out) {
+    range<3> shape{1, 1, large_size};
+    memory_location source_location{source, source_ptr, id<3>{}, shape, 1};
+    memory_location dest_location{dest, dest_ptr, id<3>{}, shape, 1};
+    auto op = std::make_unique<memcpy_operation>(source_location, dest_location,
+                                                 range<3>{1, 1, num_bytes});
+
+    backend_id executor_backend;
+    device_id executor_device;
+    op->has_preferred_backend(executor_backend, executor_device);
+    backend_executor *executor =
+        _backends->get(executor_backend)->get_executor(executor_device);
+
+    execution_hints hints;
+    hints.set_hint(hints::bind_to_device{executor_device});
+    dag_node_ptr node = make_dag_node(hints, node_list_t{}, std::move(op), rt);
+    node->assign_to_device(executor_device);
+    node->assign_to_executor(executor);
+
+    auto start = std::chrono::steady_clock::now();
+    executor->submit_directly(node, node->get_operation(), node_list_t{});
+    if(!node->is_submitted())
+      return false;
+    node->wait();
+    auto end = std::chrono::steady_clock::now();
+
+    seconds_out = std::chrono::duration<double>(end - start).count();
+    return true;
+  };
+
+  auto min_time = [&](std::size_t num_bytes, double &seconds_out) {
+    seconds_out = std::numeric_limits<double>::max();
+    for(int i = 0; i < num_repetitions; ++i) {
+      double t = 0.0;
+      if(!time_transfer(num_bytes, t))
+        return false;
+      seconds_out = std::min(seconds_out, t);
+    }
+    return true;
+  };
+
+  bool success = false;
+  double small_time = 0.0;
+  double large_time = 0.0;
+  if(source_ptr && dest_ptr) {
+    // The first transfer also includes one-time initialization costs
+    success = time_transfer(small_size, small_time) &&
+              min_time(small_size, small_time) &&
+              min_time(large_size, large_time);
+  }
+
+  if(source_ptr)
+    deallocate(source_allocator, source_ptr);
+  if(dest_ptr)
+    deallocate(dest_allocator, dest_ptr);
+
+  if(!success)
+    return false;
+
+  out.latency = small_time;
+  if(large_time > small_time)
+    out.bandwidth = (large_size - small_size) / (large_time - small_time);
+  else
+    out.bandwidth = large_size / large_time;
+  return true;
+}
+
 }
 }
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <mutex>
 
@@ -47,8 +48,10 @@ void for_each_exported_symbol_list(const common::hcf_container& hcf, F&& handler
 }
 
 extern "C" void __acpp_register_hcf(const char* hcf, std::size_t size) {
-  std::string hcf_data{hcf, size};
-  hcf_cache::get().register_hcf_object(common::hcf_container{hcf_data});
+  // The HCF data is embedded in the module that registers it, and remains
+  // valid until the module unregisters it.
+  hcf_cache::get().register_hcf_object(
+      common::hcf_container::create_non_owning(hcf, size));
 }
 
 extern "C" void __acpp_unregister_hcf(std::size_t hcf_object_id) {
@@ -265,7 +268,7 @@ hcf_cache& hcf_cache::get() {
   return c;
 }
 
-hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
+hcf_object_id hcf_cache::register_hcf_object(common::hcf_container obj) {
 
   std::lock_guard<std::mutex> lock{_mutex};
 
@@ -279,13 +282,16 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
   hcf_object_id id = std::stoull(*data);
   HIPSYCL_DEBUG_INFO << "hcf_cache: Registering HCF object " << id << "..." << std::endl;
 
+  const common::hcf_container* registered_obj = &obj;
   if (_hcf_objects.count(id) > 0) {
     HIPSYCL_DEBUG_ERROR
         << "hcf_cache: Detected hcf object id collision " << id
         << ", this should not happen. Some kernels might be unavailable."
         << std::endl;
   } else {
-    common::hcf_container* stored_obj = new common::hcf_container{obj};
+    common::hcf_container* stored_obj =
+        new common::hcf_container{std::move(obj)};
+    registered_obj = stored_obj;
     _hcf_objects[id] = std::unique_ptr<common::hcf_container>{stored_obj};
     // Check if the HCF exports some symbols
     for_each_exported_symbol_list(
@@ -363,7 +369,8 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
                           << " for writing." << std::endl;
 
     } else {
-      std::string hcf_data = obj.serialize();
+      // Dumps are meant to be inspected, so use the text format
+      std::string hcf_data = registered_obj->serialize_text();
       out_file.write(hcf_data.c_str(), hcf_data.size());
     }
   }
@@ -451,9 +458,72 @@ std::shared_ptr<kernel_cache> kernel_cache::get() {
 }
 
 void kernel_cache::unload() {
+  std::unique_ptr<worker_thread> background_jit_worker;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    background_jit_worker = std::move(_background_jit_worker);
+  }
+  // Wait for outstanding background compilations outside of the lock,
+  // since they need to access the cache upon completion.
+  if(background_jit_worker)
+    background_jit_worker->halt();
+
+  flush_persistent_cache_recency();
+
   std::lock_guard<std::mutex> lock{_mutex};
 
   _code_objects.clear();
+  _background_binaries.clear();
+}
+
+bool kernel_cache::is_jit_binary_available(code_object_id id_of_binary) const {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(_available_binaries.contains(id_of_binary) ||
+       _background_binaries.contains(id_of_binary))
+      return true;
+  }
+  return persistent_cache_contains(id_of_binary);
+}
+
+bool kernel_cache::is_background_jit_queued(code_object_id id_of_binary) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _queued_background_binaries.contains(id_of_binary);
+}
+
+void kernel_cache::background_jit_compile(
+    code_object_id id_of_binary,
+    std::function<bool(std::string &)> jit_compile) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  if(_queued_background_binaries.contains(id_of_binary))
+    return;
+  _queued_background_binaries.insert(id_of_binary);
+
+  if(!_background_jit_worker)
+    _background_jit_worker = std::make_unique<worker_thread>();
+
+  HIPSYCL_DEBUG_INFO << "kernel_cache: Enqueuing background JIT compilation of "
+                        "binary "
+                     << kernel_configuration::to_string(id_of_binary)
+                     << std::endl;
+
+  (*_background_jit_worker)([this, id_of_binary,
+                             jit_compile = std::move(jit_compile)]() mutable {
+    binary_ptr binary;
+    try {
+      binary = get_or_compile_jit_binary(id_of_binary, jit_compile);
+    } catch(const std::exception& e) {
+      HIPSYCL_DEBUG_ERROR << "kernel_cache: Background JIT compilation of binary "
+                          << kernel_configuration::to_string(id_of_binary)
+                          << " failed: " << e.what() << std::endl;
+    }
+
+    if(binary) {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _background_binaries[id_of_binary] = binary;
+    }
+  });
 }
 
 const code_object* kernel_cache::get_code_object(code_object_id id) const {
@@ -474,65 +544,102 @@ std::string kernel_cache::get_persistent_cache_file(code_object_id id_of_binary)
   return join_path(cache_dir, kernel_configuration::to_string(id_of_binary)+".jit");
 }
 
-bool kernel_cache::persistent_cache_lookup(code_object_id id_of_binary,
-                                           std::string &out) const {
-  std::string filename;
-
-  bool filename_lookup_succeeded =
-      common::filesystem::persistent_storage::get()
+std::string kernel_cache::get_persistent_cache_archive_path() {
+  using namespace common::filesystem;
+  std::string cache_dir = persistent_storage::get().get_jit_cache_dir();
+  return join_path(cache_dir, "binaries.archive");
+}
+
+kernel_cache_archive* kernel_cache::get_persistent_cache() const {
+  std::call_once(_persistent_cache_init_flag, [this]() {
+    std::size_t max_size =
+        application::get_settings().get<setting::jit_cache_max_size>() *
+        1024 * 1024;
+    auto recency = [this](const kernel_cache_archive::binary_id &id) -> uint64_t {
+      {
+        // Binaries used in this run, whose recency has not been flushed yet
+        std::lock_guard<std::mutex> lock{_persistent_cache_hits_mutex};
+        if(_persistent_cache_hits.contains(id))
+          return std::numeric_limits<uint64_t>::max();
+      }
+      return common::filesystem::persistent_storage::get()
           .get_this_app_db()
-          .read_access([&](const common::db::appdb_data &appdb) {
-            auto binary = appdb.binaries.find(id_of_binary);
-            if (binary == appdb.binaries.end())
-              return false;
-
-            filename = binary->second.jit_cache_filename;
-            return true;
+          .read_access([&](const common::db::appdb_data &appdb) -> uint64_t {
+            auto binary = appdb.binaries.find(id);
+            if(binary == appdb.binaries.end())
+              return 0;
+            return binary->second.last_used;
           });
+    };
+    _persistent_cache = std::make_unique<kernel_cache_archive>(
+        get_persistent_cache_archive_path(), max_size, recency);
+  });
+  return _persistent_cache.get();
+}
 
-  if(!filename_lookup_succeeded)
-    return false;
+bool kernel_cache::persistent_cache_contains(code_object_id id_of_binary) const {
+  return get_persistent_cache()->contains(id_of_binary);
+}
 
-  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
-  
-  if(!file.is_open())
+bool kernel_cache::persistent_cache_lookup(code_object_id id_of_binary,
+                                           std::string &out) const {
+  kernel_cache_archive* archive = get_persistent_cache();
+  if(!archive->lookup(id_of_binary, out))
     return false;
 
   HIPSYCL_DEBUG_INFO << "kernel_cache: Persistent cache hit for id "
                      << kernel_configuration::to_string(id_of_binary)
-                     << " in file " << filename << std::endl;
+                     << " in archive " << archive->get_path() << std::endl;
 
-  std::streamsize file_size = file.tellg();
-  file.seekg(0, std::ios::beg);
-  out.resize(file_size);
-  file.read(out.data(), file_size);
-  
+  // Recency is written to the appdb in bulk when the cache is unloaded,
+  // so that cache hits do not need to lock the appdb.
+  std::lock_guard<std::mutex> lock{_persistent_cache_hits_mutex};
+  _persistent_cache_hits.insert(id_of_binary);
   return true;
 }
 
+void kernel_cache::flush_persistent_cache_recency() {
+  ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash> hits;
+  {
+    std::lock_guard<std::mutex> lock{_persistent_cache_hits_mutex};
+    std::swap(hits, _persistent_cache_hits);
+  }
+  if(hits.empty())
+    return;
+
+  common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_write_access([&](common::db::appdb_data &appdb) {
+        for(const auto& id : hits)
+          appdb.binaries[id].last_used = appdb.content_version;
+      });
+}
+
 void kernel_cache::persistent_cache_store(code_object_id id_of_binary,
                                           const std::string &data) const {
   if(application::get_settings().get<setting::no_jit_cache_population>())
     return;
 
-  std::string filename = get_persistent_cache_file(id_of_binary);
+  kernel_cache_archive* archive = get_persistent_cache();
 
   HIPSYCL_DEBUG_INFO << "kernel_cache: Storing compiled binary with id "
                      << kernel_configuration::to_string(id_of_binary)
-                     << " in persistent cache file " << filename << std::endl;
-  
-
-  if(!common::filesystem::atomic_write(filename, data)) {
-    HIPSYCL_DEBUG_ERROR
-        << "Could not store JIT result in persistent kernel cache in file "
-        << filename << std::endl;
-  }
+                     << " in persistent cache archive " << archive->get_path()
+                     << std::endl;
 
+  // Update the recency first, so that the binary is not immediately
+  // evicted in case storing it triggers a compaction.
   common::filesystem::persistent_storage::get()
       .get_this_app_db()
       .read_write_access([&](common::db::appdb_data &appdb) {
-        appdb.binaries[id_of_binary].jit_cache_filename = filename;
+        appdb.binaries[id_of_binary].last_used = appdb.content_version;
       });
+
+  if(!archive->store(id_of_binary, data)) {
+    HIPSYCL_DEBUG_ERROR
+        << "Could not store JIT result in persistent kernel cache archive "
+        << archive->get_path() << std::endl;
+  }
 }
 
 } // rt
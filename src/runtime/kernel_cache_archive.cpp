@@ -0,0 +1,471 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/kernel_cache_archive.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr char archive_magic[8] = {'A', 'C', 'P', 'P', 'J', 'C', 'A', '1'};
+constexpr uint64_t record_magic = 0x4143505052454331ull; // "ACPPREC1"
+constexpr std::size_t archive_header_size = sizeof(archive_magic);
+
+struct record_header {
+  uint64_t magic;
+  uint64_t id[2];
+  // Payload size in bytes, excluding null terminator and padding
+  uint64_t size;
+  // Hash of the fields above to detect incomplete or corrupted records
+  uint64_t header_hash;
+};
+
+static_assert(kernel_configuration::id_type{}.size() == 2,
+              "Record header layout assumes two-component binary ids");
+
+uint64_t hash_header(const record_header& h) {
+  common::stable_running_hash hash;
+  hash(&h, offsetof(record_header, header_hash));
+  return hash.get_current_hash();
+}
+
+// Payloads are followed by a null terminator, and padded such that
+// record headers are 8-byte aligned.
+std::size_t get_padded_payload_size(std::size_t size) {
+  return (size + 1 + 7) & ~std::size_t{7};
+}
+
+#ifndef _WIN32
+
+uint64_t get_identity(const struct stat& s) {
+  return static_cast<uint64_t>(s.st_ino) ^
+         (static_cast<uint64_t>(s.st_dev) << 32);
+}
+
+bool write_all(int fd, const char* data, std::size_t size) {
+  while(size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if(written < 0) {
+      if(errno == EINTR)
+        continue;
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+#endif
+
+}
+
+kernel_cache_archive::kernel_cache_archive(const std::string &path,
+                                           std::size_t max_size,
+                                           recency_function recency)
+    : _path{path}, _max_size{max_size}, _recency{std::move(recency)} {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(open_archive())
+    refresh();
+}
+
+kernel_cache_archive::~kernel_cache_archive() {
+  std::lock_guard<std::mutex> lock{_mutex};
+  close_archive();
+}
+
+std::string kernel_cache_archive::get_lock_path() const {
+  return _path + ".lock";
+}
+
+#ifndef _WIN32
+
+bool kernel_cache_archive::open_archive() {
+  _fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(_fd < 0) {
+    HIPSYCL_DEBUG_WARNING << "kernel_cache_archive: Could not open " << _path
+                          << ", persistent kernel cache is unavailable."
+                          << std::endl;
+    return false;
+  }
+
+  struct stat s;
+  if(fstat(_fd, &s) != 0) {
+    close_archive();
+    return false;
+  }
+  _file_identity = get_identity(s);
+
+  // Initialize new archives, and reset archives that have an unknown format
+  char magic[archive_header_size] = {};
+  if (s.st_size < static_cast<off_t>(archive_header_size) ||
+      ::pread(_fd, magic, archive_header_size, 0) !=
+          static_cast<ssize_t>(archive_header_size) ||
+      std::memcmp(magic, archive_magic, archive_header_size) != 0) {
+    common::filesystem::file_lock flock{get_lock_path()};
+    if(!flock.is_locked()) {
+      close_archive();
+      return false;
+    }
+    // Someone else might have initialized the archive in the meantime
+    if (::pread(_fd, magic, archive_header_size, 0) !=
+            static_cast<ssize_t>(archive_header_size) ||
+        std::memcmp(magic, archive_magic, archive_header_size) != 0) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache_archive: Initializing new archive "
+                         << _path << std::endl;
+      if (ftruncate(_fd, 0) != 0 ||
+          ::pwrite(_fd, archive_magic, archive_header_size, 0) !=
+              static_cast<ssize_t>(archive_header_size)) {
+        close_archive();
+        return false;
+      }
+    }
+  }
+  _scanned_until = archive_header_size;
+  return true;
+}
+
+void kernel_cache_archive::close_archive() {
+  if(_mapping)
+    munmap(const_cast<char*>(_mapping), _mapped_size);
+  if(_fd >= 0)
+    ::close(_fd);
+  _mapping = nullptr;
+  _mapped_size = 0;
+  _fd = -1;
+  _scanned_until = 0;
+  _index.clear();
+}
+
+bool kernel_cache_archive::is_replaced_on_disk() const {
+  struct stat s;
+  if(stat(_path.c_str(), &s) != 0)
+    return true;
+  return get_identity(s) != _file_identity;
+}
+
+bool kernel_cache_archive::refresh() {
+  if(_fd >= 0 && is_replaced_on_disk()) {
+    HIPSYCL_DEBUG_INFO << "kernel_cache_archive: Archive " << _path
+                       << " was replaced, reloading index" << std::endl;
+    close_archive();
+  }
+  if(_fd < 0 && !open_archive())
+    return false;
+
+  struct stat s;
+  if(fstat(_fd, &s) != 0)
+    return false;
+  std::size_t file_size = static_cast<std::size_t>(s.st_size);
+
+  if(file_size != _mapped_size) {
+    if(_mapping)
+      munmap(const_cast<char*>(_mapping), _mapped_size);
+    _mapping = nullptr;
+    _mapped_size = 0;
+
+    void* ptr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, _fd, 0);
+    if(ptr == MAP_FAILED)
+      return false;
+    _mapping = static_cast<const char*>(ptr);
+    _mapped_size = file_size;
+  }
+
+  scan_records();
+  return true;
+}
+
+bool kernel_cache_archive::store(const binary_id &id, const std::string &data) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(!refresh())
+    return false;
+
+  bool needs_compaction = false;
+  {
+    common::filesystem::file_lock flock{get_lock_path()};
+    if(!flock.is_locked())
+      return false;
+    // Another process might have compacted the archive before we obtained
+    // the lock, in which case we would append to a file that is no longer
+    // in use. Skipping the store is harmless - we will just have to JIT
+    // again in the next run.
+    if(is_replaced_on_disk())
+      return false;
+    // ... or it might have stored the same binary.
+    refresh();
+    if(_index.contains(id))
+      return true;
+
+    record_header header;
+    header.magic = record_magic;
+    header.id[0] = id[0];
+    header.id[1] = id[1];
+    header.size = data.size();
+    header.header_hash = hash_header(header);
+
+    std::vector<char> record(sizeof(record_header) +
+                             get_padded_payload_size(data.size()), 0);
+    std::memcpy(record.data(), &header, sizeof(record_header));
+    std::memcpy(record.data() + sizeof(record_header), data.data(),
+                data.size());
+
+    // Since writers hold the lock, anything beyond the last complete record
+    // is a torn record from a process that was interrupted while writing.
+    // Appending after it would make all subsequent records unreachable.
+    std::size_t end = _scanned_until;
+    if(end < _mapped_size) {
+      HIPSYCL_DEBUG_WARNING << "kernel_cache_archive: Discarding incomplete "
+                               "record at the end of archive "
+                            << _path << std::endl;
+      if(ftruncate(_fd, static_cast<off_t>(end)) != 0)
+        return false;
+    }
+    if(lseek(_fd, static_cast<off_t>(end), SEEK_SET) < 0 ||
+       !write_all(_fd, record.data(), record.size()))
+      return false;
+
+    if(_max_size > 0 && end + record.size() > _max_size)
+      needs_compaction = true;
+  }
+
+  refresh();
+  if(needs_compaction)
+    compact_locked(_max_size / 4 * 3);
+  return true;
+}
+
+void kernel_cache_archive::compact_locked(std::size_t target_size) {
+  if(_fd < 0)
+    return;
+
+  common::filesystem::file_lock flock{get_lock_path()};
+  if(!flock.is_locked() || is_replaced_on_disk())
+    return;
+  refresh();
+
+  struct candidate {
+    binary_id id;
+    index_entry entry;
+    uint64_t recency;
+  };
+  std::vector<candidate> candidates;
+  candidates.reserve(_index.size());
+  for(const auto& entry : _index) {
+    candidates.push_back(
+        {entry.first, entry.second, _recency ? _recency(entry.first) : 0});
+  }
+  // Most recently used first; for binaries with equal recency, prefer
+  // the ones that were added more recently.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const candidate &a, const candidate &b) {
+              if(a.recency != b.recency)
+                return a.recency > b.recency;
+              return a.entry.offset > b.entry.offset;
+            });
+
+  std::string tmp_path = _path + "." + std::to_string(getpid()) + ".tmp";
+  int out = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if(out < 0)
+    return;
+
+  bool success = write_all(out, archive_magic, archive_header_size);
+  std::size_t new_size = archive_header_size;
+  std::size_t num_retained = 0;
+  for(const auto& c : candidates) {
+    std::size_t record_size =
+        sizeof(record_header) + get_padded_payload_size(c.entry.size);
+    if(new_size + record_size > target_size)
+      continue;
+    const char* record = _mapping + c.entry.offset - sizeof(record_header);
+    success = success && write_all(out, record, record_size);
+    new_size += record_size;
+    ++num_retained;
+  }
+  ::close(out);
+
+  if(!success || ::rename(tmp_path.c_str(), _path.c_str()) != 0) {
+    ::unlink(tmp_path.c_str());
+    return;
+  }
+  HIPSYCL_DEBUG_INFO << "kernel_cache_archive: Compacted archive " << _path
+                     << ", retained " << num_retained << " of "
+                     << candidates.size() << " binaries" << std::endl;
+  // flock is released when it goes out of scope; the next refresh()
+  // will notice that the archive has been replaced.
+}
+
+#else
+
+// Fallback for platforms without mmap and flock: The archive is loaded
+// into memory, and concurrent access from multiple processes is not
+// supported. No file descriptor is kept open, so _fd remains -1 and
+// _mapping indicates whether the archive has been loaded.
+bool kernel_cache_archive::open_archive() {
+  std::ifstream file{_path, std::ios::in | std::ios::binary | std::ios::ate};
+  if(file.is_open()) {
+    _file_contents.resize(file.tellg());
+    file.seekg(0, std::ios::beg);
+    file.read(_file_contents.data(), _file_contents.size());
+  }
+  if (_file_contents.size() < archive_header_size ||
+      std::memcmp(_file_contents.data(), archive_magic, archive_header_size) != 0) {
+    std::ofstream out{_path, std::ios::out | std::ios::binary | std::ios::trunc};
+    if(!out.is_open())
+      return false;
+    out.write(archive_magic, archive_header_size);
+    _file_contents.assign(archive_magic, archive_magic + archive_header_size);
+  }
+  _mapping = _file_contents.data();
+  _mapped_size = _file_contents.size();
+  _scanned_until = archive_header_size;
+  return true;
+}
+
+void kernel_cache_archive::close_archive() {
+  _file_contents.clear();
+  _mapping = nullptr;
+  _mapped_size = 0;
+  _fd = -1;
+  _scanned_until = 0;
+  _index.clear();
+}
+
+bool kernel_cache_archive::is_replaced_on_disk() const {
+  return false;
+}
+
+bool kernel_cache_archive::refresh() {
+  if(!_mapping && !open_archive())
+    return false;
+  scan_records();
+  return true;
+}
+
+bool kernel_cache_archive::store(const binary_id &id, const std::string &data) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(!refresh())
+    return false;
+  if(_index.contains(id))
+    return true;
+
+  record_header header;
+  header.magic = record_magic;
+  header.id[0] = id[0];
+  header.id[1] = id[1];
+  header.size = data.size();
+  header.header_hash = hash_header(header);
+
+  std::vector<char> record(sizeof(record_header) +
+                           get_padded_payload_size(data.size()), 0);
+  std::memcpy(record.data(), &header, sizeof(record_header));
+  std::memcpy(record.data() + sizeof(record_header), data.data(), data.size());
+
+  // Drop a torn record at the end of the archive, which would otherwise
+  // make all subsequently appended records unreachable.
+  bool is_truncated = _scanned_until < _file_contents.size();
+  _file_contents.resize(_scanned_until);
+  _file_contents.insert(_file_contents.end(), record.begin(), record.end());
+
+  auto mode = std::ios::out | std::ios::binary |
+              (is_truncated ? std::ios::trunc : std::ios::app);
+  std::ofstream out{_path, mode};
+  if(!out.is_open())
+    return false;
+  if(is_truncated)
+    out.write(_file_contents.data(), _file_contents.size());
+  else
+    out.write(record.data(), record.size());
+
+  _mapping = _file_contents.data();
+  _mapped_size = _file_contents.size();
+  scan_records();
+  return true;
+}
+
+void kernel_cache_archive::compact_locked(std::size_t target_size) {
+  // Not supported without mmap/flock; the archive grows without bound.
+}
+
+#endif
+
+void kernel_cache_archive::scan_records() {
+  const char* data = _mapping;
+  while(_scanned_until + sizeof(record_header) <= _mapped_size) {
+    record_header header;
+    std::memcpy(&header, data + _scanned_until, sizeof(record_header));
+
+    if(header.magic != record_magic || header.header_hash != hash_header(header))
+      // Either a record that another process is currently writing, or
+      // a corrupted archive. In both cases, there's nothing more we can read.
+      break;
+
+    std::size_t payload_offset = _scanned_until + sizeof(record_header);
+    std::size_t record_end =
+        payload_offset + get_padded_payload_size(header.size);
+    if(record_end > _mapped_size)
+      break;
+
+    _index[binary_id{header.id[0], header.id[1]}] =
+        index_entry{payload_offset, header.size};
+    _scanned_until = record_end;
+  }
+}
+
+bool kernel_cache_archive::contains(const binary_id &id) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(_index.contains(id))
+    return true;
+  if(!refresh())
+    return false;
+  return _index.contains(id);
+}
+
+bool kernel_cache_archive::lookup(const binary_id &id, std::string &out) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _index.find(id);
+  if(it == _index.end()) {
+    // Maybe another process has added it in the meantime
+    if(!refresh())
+      return false;
+    it = _index.find(id);
+    if(it == _index.end())
+      return false;
+  }
+
+  out.assign(_mapping + it->second.offset, it->second.size);
+  return true;
+}
+
+void kernel_cache_archive::compact(std::size_t target_size) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  compact_locked(target_size);
+  refresh();
+}
+
+}
+}
@@ -642,8 +642,15 @@ result metal_inorder_queue::submit_sscp_kernel_from_code_object(hcf_object_id hc
 
   _config.set_build_option(kernel_build_option::metal_max_args_for_flat_mode, metal_max_args_for_flat_mode);
 
+  auto create_translator = [](const std::vector<std::string> &kernel_names) {
+    return compiler::createLLVMToMetalTranslator(kernel_names);
+  };
+
   // Generate configuration IDs for caching
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
+  binary_configuration_id = adaptivity_engine.defer_specialization(
+      _config, binary_configuration_id, *_kernel_cache, _reflection_map,
+      create_translator);
   auto code_object_configuration_id = binary_configuration_id;
   kernel_configuration::extend_hash(
     code_object_configuration_id,
@@ -656,30 +663,10 @@ result metal_inorder_queue::submit_sscp_kernel_from_code_object(hcf_object_id hc
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  // JIT compiler function - invoked on cache miss to compile LLVM IR to Metal shader
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    std::vector<std::string> kernel_names;
-    std::string selected_image_name = get_image_and_kernel_names(kernel_names);
-
-    HIPSYCL_DEBUG_INFO << "[Metal] JIT compiling kernels from image: "
-                       << selected_image_name << std::endl;
-
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
-      compiler::createLLVMToMetalTranslator(kernel_names);
-
-    bool enable_dead_arg_elimination = kernel_names.size() == 1;
-
-    rt::result err = glue::jit::compile_and_store_stats(
-      translator.get(), hcf_object, selected_image_name, _config,
-      binary_configuration_id, _reflection_map, compiled_image,
-      enable_dead_arg_elimination);
-
-    if (!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-
-    return true;
+  auto jit_compiler = [&](std::string &compiled_image) -> bool {
+    return adaptivity_engine.make_jit_compiler(
+        _config, binary_configuration_id, _reflection_map,
+        create_translator)(compiled_image);
   };
 
   // Code object constructor - creates executable object from compiled shader
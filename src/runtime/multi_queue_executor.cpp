@@ -263,5 +263,22 @@ bool multi_queue_executor::find_assigned_lane_index(
 
   return false;
 }
+
+inorder_executor *
+multi_queue_executor::get_lane_executor(const dag_node_ptr &node) const {
+  if(!node->is_submitted() ||
+     node->get_assigned_device().get_backend() != _backend)
+    return nullptr;
+
+  std::size_t dev_id = node->get_assigned_device().get_id();
+  if(dev_id >= _device_data.size())
+    return nullptr;
+
+  for(const auto& executor : _device_data[dev_id].executors) {
+    if(executor->get_queue() == node->get_assigned_execution_lane())
+      return executor.get();
+  }
+  return nullptr;
+}
 }
 }
@@ -13,6 +13,7 @@
 #include "hipSYCL/runtime/omp/omp_backend.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/omp/omp_queue.hpp"
+#include "hipSYCL/runtime/omp/omp_work_group_pool.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -39,14 +40,15 @@ namespace rt {
 
 namespace {
 
-std::unique_ptr<inorder_queue> make_omp_queue(omp_backend* be, device_id dev) {
-  return std::make_unique<omp_queue>(be, dev.get_id());
+std::unique_ptr<inorder_queue> make_omp_queue(omp_backend *be, device_id dev,
+                                              int priority) {
+  return std::make_unique<omp_queue>(be, dev.get_id(), priority);
 }
 
 std::unique_ptr<multi_queue_executor>
 create_multi_queue_executor(omp_backend *b) {
   return std::make_unique<multi_queue_executor>(*b, [b](device_id dev) {
-    return make_omp_queue(b, dev);
+    return make_omp_queue(b, dev, omp_work_group_pool::default_priority);
   });
 }
 
@@ -56,6 +58,9 @@ omp_backend::omp_backend()
     : _allocator{device_id{
           backend_descriptor{omp_backend::get_hardware_platform(), omp_backend::get_api_platform()}, 0}},
       _hw{},
+      _work_group_pool([](){
+        return std::make_unique<omp_work_group_pool>();
+      }),
       _executor([this](){
         return create_multi_queue_executor(this);
       }) {}
@@ -101,9 +106,13 @@ std::string omp_backend::get_name() const {
   return "OpenMP";
 }
 
+omp_work_group_pool& omp_backend::get_work_group_pool() const {
+  return *_work_group_pool.get();
+}
+
 std::unique_ptr<backend_executor>
 omp_backend::create_inorder_executor(device_id dev, int priority){
-  std::unique_ptr<inorder_queue> q = make_omp_queue(this, dev);
+  std::unique_ptr<inorder_queue> q = make_omp_queue(this, dev, priority);
   return std::make_unique<inorder_executor>(std::move(q));
 }
 
@@ -16,6 +16,7 @@
 
 #include "hipSYCL/runtime/backend.hpp"
 #include "hipSYCL/runtime/omp/omp_code_object.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJIT.hpp"
 
 #include "hipSYCL/common/config.hpp"
 #include "hipSYCL/common/debug.hpp"
@@ -72,6 +73,11 @@ omp_sscp_executable_object::omp_sscp_executable_object(
 }
 
 omp_sscp_executable_object::~omp_sscp_executable_object() {
+  if (_jit_dylib) {
+    // Nothing was written to the kernel cache directory
+    _jit_dylib.reset();
+    return;
+  }
   if (_module){
     std::string message;
     common::close_library(_module, message);
@@ -124,21 +130,30 @@ result omp_sscp_executable_object::build(
   if (_module != nullptr)
     return make_success();
 
-  if (auto result = make_shared_library_from_blob(_module, source, _kernel_cache_path);
-      !result.is_success())
+  if (compiler::isHostRelocatableObject(source)) {
+    // Link the object into the process directly, without
+    // going through the filesystem.
+    std::string message;
+    _jit_dylib = compiler::loadHostRelocatableObject(source, message);
+    if (!_jit_dylib) {
+      HIPSYCL_DEBUG_ERROR << "[omp_sscp_executable_object] " << message << std::endl;
+      return make_error(__acpp_here(),
+                        error_info{"omp_sscp_executable_object: could not link "
+                                   "JIT kernel object"});
+    }
+    _module = _jit_dylib.get();
+  } else if (auto result = make_shared_library_from_blob(
+                 _module, source, _kernel_cache_path);
+             !result.is_success()) {
     return result;
+  }
 
   _kernel_names = kernel_names;
   // find all kernel symbols
   for (const auto &kernel_name : _kernel_names) {
-    std::string message;
-    if (auto kernel = (omp_sscp_kernel *)common::get_symbol_from_library(
-            _module, kernel_name, message)) {
+    if (auto kernel = (omp_sscp_kernel *)get_symbol(kernel_name)) {
       _kernels.emplace(kernel_name, kernel);
     } else {
-      if (!message.empty()) {
-        HIPSYCL_DEBUG_WARNING << "[omp_sscp_executable_object] " << message << std::endl;
-      }
       return make_error(__acpp_here(),
                         error_info{"omp_sscp_executable_object: could not load "
                                    "kernel from shared library"});
@@ -147,6 +162,18 @@ result omp_sscp_executable_object::build(
   return make_success();
 }
 
+void *omp_sscp_executable_object::get_symbol(const std::string &name) const {
+  if (_jit_dylib)
+    return _jit_dylib->getSymbol(name);
+
+  std::string message;
+  void *symbol = common::get_symbol_from_library(_module, name, message);
+  if (!message.empty()) {
+    HIPSYCL_DEBUG_WARNING << "[omp_sscp_executable_object] " << message << std::endl;
+  }
+  return symbol;
+}
+
 bool omp_sscp_executable_object::contains(
     const std::string &backend_kernel_name) const {
   for (const auto &[kernel_name, kernel] : _kernels) {
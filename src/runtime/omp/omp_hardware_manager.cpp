@@ -11,14 +11,51 @@
 #include <omp.h>
 #include <limits>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/runtime/omp/omp_work_group_pool.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/omp/omp_phys_mem.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+std::size_t get_cache_line_size() {
+#if !defined(_WIN32) && defined(_SC_LEVEL1_DCACHE_LINESIZE)
+  long line_size = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+  if(line_size > 0)
+    return static_cast<std::size_t>(line_size);
+#endif
+  return 64;
+}
+
+}
+
+std::size_t get_host_simd_subgroup_size() {
+  static const std::size_t width = []() -> std::size_t {
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+    if (__builtin_cpu_supports("avx512f"))
+      return 16;
+    if (__builtin_cpu_supports("avx"))
+      return 8;
+    return 4;
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+    return 4;
+#else
+    return 1;
+#endif
+  }();
+  return width;
+}
 
 bool omp_hardware_context::is_cpu() const {
   return true;
@@ -269,10 +306,10 @@ omp_hardware_context::get_property(device_uint_property prop) const {
     return 8; // TODO
     break;
   case device_uint_property::global_mem_cache_line_size:
-    return 64; //TODO
+    return get_cache_line_size();
     break;
   case device_uint_property::global_mem_cache_size:
-    return 1; // TODO
+    return get_host_cache_size();
     break;
   case device_uint_property::global_mem_size:
     return phys_mem_or_max();
@@ -303,8 +340,10 @@ omp_hardware_context::get_property(device_uint_property prop) const {
     return static_cast<int>(backend_id::omp);
     break;
   case device_uint_property::queue_priority_range_low:
+    return omp_work_group_pool::lowest_priority;
+    break;
   case device_uint_property::queue_priority_range_high:
-    return 0;
+    return omp_work_group_pool::highest_priority;
     break;
   }
   assert(false && "Invalid device property");
@@ -315,6 +354,11 @@ std::vector<std::size_t> omp_hardware_context::get_property(device_uint_list_pro
 {
   switch(prop) {
   case device_uint_list_property::sub_group_sizes:
+    // Without SIMD sub-groups, as well as for kernels from the
+    // library-only OpenMP compilation flow, sub-groups have size 1.
+    if (application::get_settings().get<setting::jitopt_host_simd_subgroups>() &&
+        get_host_simd_subgroup_size() > 1)
+      return std::vector<std::size_t>{1, get_host_simd_subgroup_size()};
     return std::vector<std::size_t>{1};
     break;
   }
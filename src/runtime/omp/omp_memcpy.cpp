@@ -0,0 +1,233 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/omp/omp_memcpy.hpp"
+#include "hipSYCL/runtime/omp/omp_work_group_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HIPSYCL_OMP_MEMCPY_NONTEMPORAL_STORES
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Granularity at which work is distributed across workers. Must be
+// a multiple of the page size, such that each page of the destination
+// is written by a single worker.
+constexpr std::size_t block_size = 1024 * 1024;
+// Below this size, the overhead of waking up the workers
+// outweighs the gain from copying in parallel.
+constexpr std::size_t min_parallel_size = 4 * 1024 * 1024;
+
+std::size_t get_nontemporal_threshold() {
+  static const std::size_t threshold = []() -> std::size_t {
+    std::size_t cache_size = 32 * 1024 * 1024;
+#if !defined(_WIN32) && defined(_SC_LEVEL3_CACHE_SIZE)
+    long l3_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if(l3_size > 0)
+      cache_size = static_cast<std::size_t>(l3_size);
+#endif
+    return cache_size;
+  }();
+  return threshold;
+}
+
+#ifdef HIPSYCL_OMP_MEMCPY_NONTEMPORAL_STORES
+// Writes [dest, dest+n) either from src, or with the given pattern
+// if src is nullptr, bypassing the cache for the aligned part.
+void write_nontemporal(char *dest, const char *src, unsigned char pattern,
+                       std::size_t n) {
+  auto write_regular = [&](char* d, std::size_t offset, std::size_t count) {
+    if(src)
+      std::memcpy(d, src + offset, count);
+    else
+      std::memset(d, pattern, count);
+  };
+
+  std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(dest) % 16) % 16;
+  head = std::min(head, n);
+  write_regular(dest, 0, head);
+
+  std::size_t num_vectors = (n - head) / 16;
+  __m128i *vdest = reinterpret_cast<__m128i *>(dest + head);
+  if(src) {
+    const __m128i *vsrc = reinterpret_cast<const __m128i *>(src + head);
+    std::size_t i = 0;
+    for(; i + 4 <= num_vectors; i += 4) {
+      __m128i v0 = _mm_loadu_si128(vsrc + i);
+      __m128i v1 = _mm_loadu_si128(vsrc + i + 1);
+      __m128i v2 = _mm_loadu_si128(vsrc + i + 2);
+      __m128i v3 = _mm_loadu_si128(vsrc + i + 3);
+      _mm_stream_si128(vdest + i, v0);
+      _mm_stream_si128(vdest + i + 1, v1);
+      _mm_stream_si128(vdest + i + 2, v2);
+      _mm_stream_si128(vdest + i + 3, v3);
+    }
+    for(; i < num_vectors; ++i)
+      _mm_stream_si128(vdest + i, _mm_loadu_si128(vsrc + i));
+  } else {
+    __m128i v = _mm_set1_epi8(static_cast<char>(pattern));
+    for(std::size_t i = 0; i < num_vectors; ++i)
+      _mm_stream_si128(vdest + i, v);
+  }
+
+  std::size_t processed = head + 16 * num_vectors;
+  write_regular(dest + processed, processed, n - processed);
+  // Streaming stores are weakly ordered; make them visible before
+  // completion of the operation is signalled.
+  _mm_sfence();
+}
+#endif
+
+void write(char *dest, const char *src, unsigned char pattern, std::size_t n,
+           bool use_nontemporal_stores) {
+#ifdef HIPSYCL_OMP_MEMCPY_NONTEMPORAL_STORES
+  if(use_nontemporal_stores) {
+    write_nontemporal(dest, src, pattern, n);
+    return;
+  }
+#endif
+  if(src)
+    std::memcpy(dest, src, n);
+  else
+    std::memset(dest, pattern, n);
+}
+
+// Copies the region, or fills it if region.src is nullptr.
+void process(omp_work_group_pool &pool, const omp_copy_region &region,
+             unsigned char pattern, int priority) {
+  std::size_t num_rows = region.num_rows * region.num_surfaces;
+  std::size_t total_size = region.row_size * num_rows;
+  if(total_size == 0)
+    return;
+
+  bool is_parallel =
+      total_size >= min_parallel_size && pool.get_num_workers() > 1;
+  // The C library already picks the best strategy for large contiguous
+  // writes from a single thread, but cannot know that the pieces handed
+  // to workers are part of a larger write.
+  bool use_nontemporal_stores =
+      is_parallel && total_size >= get_nontemporal_threshold();
+
+  auto row_dest = [&](std::size_t row) {
+    return region.dest + (row / region.num_rows) * region.dest_surface_pitch +
+           (row % region.num_rows) * region.dest_row_pitch;
+  };
+  auto row_src = [&](std::size_t row) -> const char * {
+    if(!region.src)
+      return nullptr;
+    return region.src + (row / region.num_rows) * region.src_surface_pitch +
+           (row % region.num_rows) * region.src_row_pitch;
+  };
+
+  auto process_rows = [&](std::size_t begin, std::size_t end) {
+    for(std::size_t row = begin; row < end; ++row)
+      write(row_dest(row), row_src(row), pattern, region.row_size,
+            use_nontemporal_stores);
+  };
+
+  if(!is_parallel) {
+    process_rows(0, num_rows);
+    return;
+  }
+
+  if(region.row_size < block_size) {
+    // Distribute groups of rows
+    std::size_t rows_per_unit = block_size / region.row_size;
+    std::size_t num_units = (num_rows + rows_per_unit - 1) / rows_per_unit;
+    pool.run(num_units, [&](std::size_t begin, std::size_t end) {
+      process_rows(begin * rows_per_unit,
+                   std::min(num_rows, end * rows_per_unit));
+    }, priority);
+  } else {
+    // Distribute pieces of rows. Pieces are aligned to block boundaries
+    // of the destination address, so that pieces never share pages.
+    // Depending on the alignment of the row, the first and last piece
+    // might be partial, and the last one might be empty.
+    std::size_t pieces_per_row = (region.row_size + block_size - 1) / block_size + 1;
+    pool.run(num_rows * pieces_per_row, [&](std::size_t begin, std::size_t end) {
+      for(std::size_t unit = begin; unit < end; ++unit) {
+        std::size_t row = unit / pieces_per_row;
+        std::size_t piece = unit % pieces_per_row;
+
+        char *dest = row_dest(row);
+        const char *src = row_src(row);
+        std::size_t misalignment =
+            reinterpret_cast<std::uintptr_t>(dest) % block_size;
+
+        std::size_t piece_begin = piece * block_size;
+        std::size_t piece_end = piece_begin + block_size;
+        piece_begin = piece_begin > misalignment ? piece_begin - misalignment : 0;
+        piece_end = std::min(region.row_size, piece_end - misalignment);
+
+        if(piece_begin < piece_end)
+          write(dest + piece_begin, src ? src + piece_begin : nullptr, pattern,
+                piece_end - piece_begin, use_nontemporal_stores);
+      }
+    }, priority);
+  }
+}
+
+// Merges all rows of each surface into a single row if they are adjacent
+// in both source and destination, and then treats surfaces as rows.
+bool merge_rows(omp_copy_region &region) {
+  if (region.num_rows != 1 && (region.src_row_pitch != region.row_size ||
+                               region.dest_row_pitch != region.row_size))
+    return false;
+
+  region.row_size *= region.num_rows;
+  region.num_rows = region.num_surfaces;
+  region.src_row_pitch = region.src_surface_pitch;
+  region.dest_row_pitch = region.dest_surface_pitch;
+  region.num_surfaces = 1;
+  region.src_surface_pitch = region.src_row_pitch * region.num_rows;
+  region.dest_surface_pitch = region.dest_row_pitch * region.num_rows;
+  return true;
+}
+
+omp_copy_region collapse_contiguous_dimensions(omp_copy_region region) {
+  if(merge_rows(region))
+    merge_rows(region);
+  return region;
+}
+
+}
+
+void omp_memcpy_engine::copy(omp_work_group_pool &pool,
+                             const omp_copy_region &region, int priority) {
+  process(pool, collapse_contiguous_dimensions(region), 0, priority);
+}
+
+void omp_memcpy_engine::fill(omp_work_group_pool &pool, void *ptr, int pattern,
+                             std::size_t num_bytes, int priority) {
+  omp_copy_region region;
+  region.src = nullptr;
+  region.dest = static_cast<char *>(ptr);
+  region.row_size = num_bytes;
+  region.num_rows = 1;
+  region.num_surfaces = 1;
+  region.src_row_pitch = region.dest_row_pitch = num_bytes;
+  region.src_surface_pitch = region.dest_surface_pitch = num_bytes;
+  process(pool, region, static_cast<unsigned char>(pattern), priority);
+}
+
+}
+}
@@ -22,6 +22,7 @@
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "hipSYCL/runtime/omp/omp_event.hpp"
 #include "hipSYCL/runtime/omp/omp_backend.hpp"
+#include "hipSYCL/runtime/omp/omp_memcpy.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
 #include "hipSYCL/runtime/signal_channel.hpp"
@@ -33,12 +34,8 @@
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
 #include "hipSYCL/runtime/omp/omp_code_object.hpp"
-
-#ifndef WIN32 // MSVC might not have #warning?
-#ifndef _OPENMP
-#warning Building omp backend with JIT support, but OpenMP parallelization is not available - kernels will run sequentially! This points to an issue in the build system.
-#endif
-#endif
+#include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/runtime/omp/omp_work_group_pool.hpp"
 
 #ifndef WIN32
 #include <unistd.h>
@@ -57,34 +54,6 @@ namespace rt {
 
 namespace {
 
-bool is_contigous(id<3> offset, range<3> r, range<3> allocation_shape) {
-  if (r.size() == 0)
-    return true;
-
-  int dim = 3;
-  if (r.get(0) == 1)
-    dim = 2;
-  if (r.get(1) == 1)
-    dim = 1;
-
-  // 1D data transfers are always contiguous
-  if (dim == 1)
-    return true;
-
-  // The slowest index does not need to be of 0 offset and
-  // full size => start at
-  // * 2 for dim == 2 (slowest index is 1)
-  // * 1 for dim == 3 (slowest index is 0)
-  for (int i = 4 - dim; i <= 2; ++i) {
-    if (offset.get(i) != 0)
-      return false;
-    if (r.get(i) != allocation_shape.get(i))
-      return false;
-  }
-
-  return true;
-}
-
 class instrumentation_task_guard;
 
 template <class BaseInstrumentation>
@@ -137,9 +106,35 @@ private:
   std::shared_ptr<omp_execution_finish_timestamp> _finish;
 };
 
+class omp_transfer_bandwidth : public instrumentations::transfer_bandwidth {
+public:
+  virtual std::size_t get_num_bytes() const override { return _num_bytes; }
+
+  virtual double get_bytes_per_second() const override {
+    return _bytes_per_second;
+  }
+
+  virtual void wait() const override { _signal.wait(); }
+
+  void record(std::size_t num_bytes, profiler_clock::time_point start,
+              profiler_clock::time_point finish) {
+    assert(!_signal.has_signalled());
+    _num_bytes = num_bytes;
+    double seconds = profiler_clock::seconds(finish) - profiler_clock::seconds(start);
+    _bytes_per_second = seconds > 0.0 ? num_bytes / seconds : 0.0;
+    _signal.signal();
+  }
+
+private:
+  std::size_t _num_bytes = 0;
+  double _bytes_per_second = 0.0;
+  mutable signal_channel _signal;
+};
+
 class omp_instrumentation_setup {
 public:
-  omp_instrumentation_setup(operation &op, dag_node_ptr node) {
+  omp_instrumentation_setup(operation &op, dag_node_ptr node,
+                            bool is_transfer = false) {
     if (!node)
       return;
 
@@ -169,6 +164,15 @@ public:
       op.get_instrumentations()
           .add_instrumentation<instrumentations::execution_finish_timestamp>(
               _finish);
+
+      // Profiled transfers also report their bandwidth
+      if (is_transfer) {
+        _bandwidth = std::make_shared<omp_transfer_bandwidth>();
+
+        op.get_instrumentations()
+            .add_instrumentation<instrumentations::transfer_bandwidth>(
+                _bandwidth);
+      }
     }
   }
 
@@ -176,7 +180,22 @@ public:
     return instrumentation_task_guard{_start, _finish};
   }
 
+  // Runs the given transfer of num_bytes, and records its bandwidth
+  // if requested.
+  template <class F>
+  void instrument_transfer(std::size_t num_bytes, F &&transfer) const {
+    if (!_bandwidth) {
+      transfer();
+      return;
+    }
+    auto start = profiler_clock::now();
+    transfer();
+    auto finish = profiler_clock::now();
+    _bandwidth->record(num_bytes, start, finish);
+  }
+
 private:
+  std::shared_ptr<omp_transfer_bandwidth> _bandwidth;
   std::shared_ptr<omp_execution_start_timestamp> _start;
   std::shared_ptr<omp_execution_finish_timestamp> _finish;
 };
@@ -209,10 +228,11 @@ void *resize_and_strongly_align(std::vector<char> &data, std::size_t size) {
 }
 
 result
-launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
+launch_kernel_from_so(omp_work_group_pool &pool,
+                      omp_sscp_executable_object::omp_sscp_kernel *kernel,
                       const rt::range<3> &num_groups,
                       const rt::range<3> &local_size, unsigned shared_memory,
-                      void **kernel_args) {
+                      void **kernel_args, int priority) {
   // *** Do NOT change these values without changing also on the compiler side
   //     in host/StaticLocalMemoryPass.cpp ***
   // for internal use in group algorithms
@@ -242,44 +262,40 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
     return make_success();
   }
 
-#ifndef _OPENMP
-  HIPSYCL_DEBUG_WARNING << "omp_queue: SSCP kernel launching was built without OpenMP "
-                          "support, the kernel will execute sequentially!"
-                        << std::endl;
-#endif
+  // Work-groups are independent, so they can be distributed freely
+  // across the workers of the shared pool.
+  std::size_t num_groups_x = num_groups.get(0);
+  std::size_t num_groups_xy = num_groups_x * num_groups.get(1);
+  pool.run(
+      num_groups.size(), [&](std::size_t begin, std::size_t end) {
+        // get page aligned local memory from heap
+        static thread_local std::vector<char> local_memory;
+        static thread_local std::vector<char> internal_local_memory;
+        auto aligned_local_memory =
+            resize_and_strongly_align(local_memory, shared_memory);
+        auto aligned_internal_local_memory = resize_and_strongly_align(
+            internal_local_memory, total_internal_local_mem_size);
+
+        for (std::size_t group = begin; group < end; ++group) {
+          std::size_t i = group % num_groups_x;
+          std::size_t j = (group / num_groups_x) % num_groups.get(1);
+          std::size_t k = group / num_groups_xy;
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-  {
-    // get page aligned local memory from heap
-    static thread_local std::vector<char> local_memory;
-    static thread_local std::vector<char> internal_local_memory;
-    auto aligned_local_memory =
-        resize_and_strongly_align(local_memory, shared_memory);
-    auto aligned_internal_local_memory = resize_and_strongly_align(
-        internal_local_memory, total_internal_local_mem_size);
-#ifdef _OPENMP
-#pragma omp for collapse(3)
-#endif
-    for (std::size_t k = 0; k < num_groups.get(2); ++k) {
-      for (std::size_t j = 0; j < num_groups.get(1); ++j) {
-        for (std::size_t i = 0; i < num_groups.get(0); ++i) {
           omp_sscp_executable_object::work_group_info info{
               num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory,
               aligned_internal_local_memory};
           kernel(&info, kernel_args);
         }
-      }
-    }
-  }
+      }, priority);
   return make_success();
 }
 #endif
 } // namespace
 
-omp_queue::omp_queue(omp_backend* be, int dev)
-    : _backend_id{be->get_unique_backend_id()}, _sscp_code_object_invoker{this},
+omp_queue::omp_queue(omp_backend* be, int dev, int priority)
+    : _backend_id{be->get_unique_backend_id()},
+      _work_group_pool{be->get_work_group_pool()}, _priority{priority},
+      _sscp_code_object_invoker{this},
       _kernel_cache{kernel_cache::get()} {
   _reflection_map = glue::jit::construct_default_reflection_map(
       be->get_hardware_manager()->get_device(dev));
@@ -332,69 +348,48 @@ result omp_queue::submit_memcpy(memcpy_operation &op, const dag_node_ptr& node)
 
   std::size_t total_num_bytes = op.get_num_transferred_bytes();
 
-  bool is_src_contiguous =
-      is_contigous(src_offset, transferred_range, src_allocation_shape);
-  bool is_dest_contiguous =
-      is_contigous(dest_offset, transferred_range, dest_allocation_shape);
+  auto linear_index = [](id<3> id, range<3> allocation_shape) {
+    return id[2] + allocation_shape[2] * id[1] +
+           allocation_shape[2] * allocation_shape[1] * id[0];
+  };
 
-  omp_instrumentation_setup instrumentation_setup{op, node};
+  omp_copy_region region;
+  region.src = reinterpret_cast<const char *>(base_src) +
+               linear_index(src_offset, src_allocation_shape) * src_element_size;
+  region.dest = reinterpret_cast<char *>(base_dest) +
+                linear_index(dest_offset, dest_allocation_shape) *
+                    dest_element_size;
+  region.row_size = transferred_range[2] * src_element_size;
+  region.num_rows = transferred_range[1];
+  region.num_surfaces = transferred_range[0];
+  region.src_row_pitch = src_allocation_shape[2] * src_element_size;
+  region.src_surface_pitch = src_allocation_shape[1] * region.src_row_pitch;
+  region.dest_row_pitch = dest_allocation_shape[2] * dest_element_size;
+  region.dest_surface_pitch = dest_allocation_shape[1] * region.dest_row_pitch;
+
+  assert(total_num_bytes == 0 ||
+         region.src + (region.num_surfaces - 1) * region.src_surface_pitch +
+                 (region.num_rows - 1) * region.src_row_pitch +
+                 region.row_size <=
+             reinterpret_cast<char *>(base_src) +
+                 src_allocation_shape.size() * src_element_size);
+  assert(total_num_bytes == 0 ||
+         region.dest + (region.num_surfaces - 1) * region.dest_surface_pitch +
+                 (region.num_rows - 1) * region.dest_row_pitch +
+                 region.row_size <=
+             reinterpret_cast<char *>(base_dest) +
+                 dest_allocation_shape.size() * dest_element_size);
+
+  omp_instrumentation_setup instrumentation_setup{op, node, true};
+  int priority = _priority;
+  omp_work_group_pool* pool = &_work_group_pool;
 
   _worker([=]() {
     auto instrumentation_guard = instrumentation_setup.instrument_task();
 
-    auto linear_index = [](id<3> id, range<3> allocation_shape) {
-      return id[2] + allocation_shape[2] * id[1] +
-             allocation_shape[2] * allocation_shape[1] * id[0];
-    };
-
-    if (is_src_contiguous && is_dest_contiguous) {
-      char *current_src = reinterpret_cast<char *>(base_src);
-      char *current_dest = reinterpret_cast<char *>(base_dest);
-
-      current_src +=
-          linear_index(src_offset, src_allocation_shape) * src_element_size;
-      current_dest +=
-          linear_index(dest_offset, dest_allocation_shape) * dest_element_size;
-
-      memcpy(current_dest, current_src, total_num_bytes);
-    } else {
-      id<3> current_src_offset = src_offset;
-      id<3> current_dest_offset = dest_offset;
-      std::size_t row_size = transferred_range[2] * src_element_size;
-
-      for (std::size_t surface = 0; surface < transferred_range[0]; ++surface) {
-        for (std::size_t row = 0; row < transferred_range[1]; ++row) {
-
-          char *current_src = reinterpret_cast<char *>(base_src);
-          char *current_dest = reinterpret_cast<char *>(base_dest);
-
-          current_src +=
-              linear_index(current_src_offset, src_allocation_shape) *
-              src_element_size;
-
-          current_dest +=
-              linear_index(current_dest_offset, dest_allocation_shape) *
-              dest_element_size;
-
-          assert(current_src + row_size <=
-                 reinterpret_cast<char *>(base_src) +
-                     src_allocation_shape.size() * src_element_size);
-          assert(current_dest + row_size <=
-                 reinterpret_cast<char *>(base_dest) +
-                     dest_allocation_shape.size() * dest_element_size);
-
-          memcpy(current_dest, current_src, row_size);
-
-          ++current_src_offset[1];
-          ++current_dest_offset[1];
-        }
-        current_src_offset[1] = src_offset[1];
-        current_dest_offset[1] = dest_offset[1];
-
-        ++current_dest_offset[0];
-        ++current_src_offset[0];
-      }
-    }
+    instrumentation_setup.instrument_transfer(total_num_bytes, [&]() {
+      omp_memcpy_engine::copy(*pool, region, priority);
+    });
   });
 
   return make_success();
@@ -475,9 +470,28 @@ result omp_queue::submit_sscp_kernel_from_code_object(
   if(host_veclib.has_value())
     _config.set_build_option(kernel_build_option::host_vector_math_library,
         static_cast<int>(*host_veclib));
+  if(application::get_settings().get<setting::jitopt_host_simd_subgroups>()) {
+    _config.set_build_flag(kernel_build_flag::host_simd_subgroups);
+    // Select the width here instead of leaving it to the JIT compiler, so
+    // that it matches the sub_group_sizes reported by the device.
+    bool has_subgroup_size = false;
+    for(const auto& opt : kernel_info->get_compilation_options())
+      if(opt.first == kernel_build_option::desired_subgroup_size)
+        has_subgroup_size = true;
+    if(!has_subgroup_size)
+      _config.set_build_option(kernel_build_option::desired_subgroup_size,
+                               get_host_simd_subgroup_size());
+  }
+
+  auto create_translator = [](const std::vector<std::string> &kernel_names) {
+    return compiler::createLLVMToHostTranslator(kernel_names);
+  };
 
   auto binary_configuration_id =
       adaptivity_engine.finalize_binary_configuration(_config);
+  binary_configuration_id = adaptivity_engine.defer_specialization(
+      _config, binary_configuration_id, *_kernel_cache, _reflection_map,
+      create_translator, false);
   auto code_object_configuration_id = binary_configuration_id;
 
   auto get_image_and_kernel_names =
@@ -486,26 +500,9 @@ result omp_queue::submit_sscp_kernel_from_code_object(
   };
 
   auto jit_compiler = [&](std::string &compiled_image) -> bool {
-    const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_object);
-
-    std::vector<std::string> kernel_names;
-    std::string selected_image_name = get_image_and_kernel_names(kernel_names);
-
-    // Construct Host translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
-        compiler::createLLVMToHostTranslator(kernel_names);
-
-    // Lower kernels to binary
-    rt::result err = glue::jit::compile_and_store_stats(
-        translator.get(), hcf_object, selected_image_name, _config,
-        binary_configuration_id, _reflection_map, compiled_image,
-        false);
-
-    if (!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+    return adaptivity_engine.make_jit_compiler(
+        _config, binary_configuration_id, _reflection_map,
+        create_translator, false)(compiled_image);
   };
 
   auto code_object_constructor =
@@ -546,8 +543,9 @@ result omp_queue::submit_sscp_kernel_from_code_object(
       static_cast<const omp_sscp_executable_object *>(obj)->get_kernel(
           kernel_name);
 
-  auto err = launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
-                                   _arg_mapper.get_mapped_args());
+  auto err = launch_kernel_from_so(_work_group_pool, kernel, num_groups,
+                                   group_size, local_mem_size,
+                                   _arg_mapper.get_mapped_args(), _priority);
   on_kernel_launch_complete(kernel_name, obj);
   return err;
 
@@ -587,11 +585,15 @@ result omp_queue::submit_memset(memset_operation &op, const dag_node_ptr& node)
             "omp_queue: submit_memset(): Invalid argument, pointer is null."});
   }
 
-  omp_instrumentation_setup instrumentation_setup{op, node};
+  omp_instrumentation_setup instrumentation_setup{op, node, true};
+  int priority = _priority;
+  omp_work_group_pool* pool = &_work_group_pool;
   _worker([=]() {
     auto instrumentation_guard = instrumentation_setup.instrument_task();
 
-    memset(ptr, pattern, bytes);
+    instrumentation_setup.instrument_transfer(bytes, [&]() {
+      omp_memcpy_engine::fill(*pool, ptr, pattern, bytes, priority);
+    });
   });
 
   return make_success();
@@ -0,0 +1,359 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/omp/omp_work_group_pool.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/spin_lock.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if defined(LIB_NUMA_AVAILABLE) && defined(__linux__)
+#include <numa.h>
+#include <pthread.h>
+#include <sched.h>
+#define HIPSYCL_OMP_WORK_GROUP_POOL_NUMA_BINDING
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Each worker processes its own range in chunks of roughly
+// 1/chunks_per_worker of its initial share
+constexpr std::size_t chunks_per_worker = 16;
+
+struct alignas(64) range_slot {
+  common::spin_lock lock;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+};
+
+std::size_t get_default_num_workers() {
+#ifdef _OPENMP
+  int n = omp_get_max_threads();
+#else
+  int n = static_cast<int>(std::thread::hardware_concurrency());
+#endif
+  return static_cast<std::size_t>(std::max(n, 1));
+}
+
+#ifdef HIPSYCL_OMP_WORK_GROUP_POOL_NUMA_BINDING
+// Returns the CPUs this process may run on, grouped by NUMA node.
+std::map<int, std::vector<int>> get_cpus_per_numa_node() {
+  std::map<int, std::vector<int>> result;
+  if(numa_available() == -1)
+    return result;
+
+  cpu_set_t allowed_cpus;
+  CPU_ZERO(&allowed_cpus);
+  if(sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus) != 0)
+    return result;
+
+  for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if(CPU_ISSET(cpu, &allowed_cpus)) {
+      int node = numa_node_of_cpu(cpu);
+      if(node >= 0)
+        result[node].push_back(cpu);
+    }
+  }
+  return result;
+}
+
+void bind_to_cpus(const std::vector<int>& cpus) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for(int cpu : cpus)
+    CPU_SET(cpu, &set);
+  if(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    HIPSYCL_DEBUG_WARNING << "omp_work_group_pool: Could not bind worker "
+                             "thread to NUMA node"
+                          << std::endl;
+  }
+}
+#endif
+
+}
+
+struct omp_work_group_pool::job {
+  range_function f;
+  void* user_data;
+  std::size_t chunk_size;
+  // One range per worker
+  std::unique_ptr<range_slot[]> slots;
+  int priority;
+
+  // The following are protected by the pool's _mutex
+  int num_participants = 0;
+  bool is_exhausted = false;
+  // The time since which no worker participates in the job
+  std::chrono::steady_clock::time_point starved_since;
+};
+
+omp_work_group_pool::omp_work_group_pool()
+: omp_work_group_pool{get_default_num_workers()} {}
+
+omp_work_group_pool::omp_work_group_pool(std::size_t num_workers)
+: _num_active_jobs{0}, _shutdown{false} {
+  num_workers = std::max(num_workers, std::size_t{1});
+  _workers.resize(num_workers);
+
+#ifdef HIPSYCL_OMP_WORK_GROUP_POOL_NUMA_BINDING
+  std::vector<std::vector<int>> node_cpus;
+  {
+    auto cpus_per_node = get_cpus_per_numa_node();
+    // Binding only makes a difference if there are multiple nodes
+    if(cpus_per_node.size() > 1)
+      for(auto& entry : cpus_per_node)
+        node_cpus.push_back(std::move(entry.second));
+  }
+
+  if(!node_cpus.empty()) {
+    std::size_t total_cpus = 0;
+    for(const auto& cpus : node_cpus)
+      total_cpus += cpus.size();
+
+    // Distribute workers across nodes proportionally to their number of
+    // CPUs, such that consecutive workers are on the same node.
+    std::size_t node = 0;
+    std::size_t cpus_before_node = 0;
+    for(std::size_t i = 0; i < num_workers; ++i) {
+      while (node + 1 < node_cpus.size() &&
+             i * total_cpus >=
+                 (cpus_before_node + node_cpus[node].size()) * num_workers) {
+        cpus_before_node += node_cpus[node].size();
+        ++node;
+      }
+      _workers[i].numa_node = static_cast<int>(node);
+    }
+  }
+#endif
+
+  for(std::size_t i = 0; i < num_workers; ++i) {
+    auto& victims = _workers[i].victims;
+    for(std::size_t offset = 1; offset < num_workers; ++offset) {
+      std::size_t v = (i + offset) % num_workers;
+      if(_workers[v].numa_node == _workers[i].numa_node)
+        victims.push_back(v);
+    }
+    for(std::size_t offset = 1; offset < num_workers; ++offset) {
+      std::size_t v = (i + offset) % num_workers;
+      if(_workers[v].numa_node != _workers[i].numa_node)
+        victims.push_back(v);
+    }
+  }
+
+  for(std::size_t i = 0; i < num_workers; ++i) {
+#ifdef HIPSYCL_OMP_WORK_GROUP_POOL_NUMA_BINDING
+    std::vector<int> cpus;
+    if(!node_cpus.empty())
+      cpus = node_cpus[_workers[i].numa_node];
+    _workers[i].thread = std::thread{[this, i, cpus]() {
+      if(!cpus.empty())
+        bind_to_cpus(cpus);
+      work(i);
+    }};
+#else
+    _workers[i].thread = std::thread{[this, i]() { work(i); }};
+#endif
+  }
+
+  HIPSYCL_DEBUG_INFO << "omp_work_group_pool: Started " << num_workers
+                     << " worker threads" << std::endl;
+}
+
+omp_work_group_pool::~omp_work_group_pool() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _shutdown = true;
+    _work_available.notify_all();
+  }
+  for(auto& w : _workers)
+    if(w.thread.joinable())
+      w.thread.join();
+}
+
+void omp_work_group_pool::run(std::size_t num_work_groups, range_function f,
+                              void *user_data, int priority) {
+  if(num_work_groups == 0)
+    return;
+
+  std::size_t num_workers = _workers.size();
+
+  job j;
+  j.f = f;
+  j.user_data = user_data;
+  j.chunk_size =
+      std::max(std::size_t{1}, num_work_groups / (num_workers * chunks_per_worker));
+  j.slots = std::make_unique<range_slot[]>(num_workers);
+  for(std::size_t i = 0; i < num_workers; ++i) {
+    j.slots[i].begin = i * num_work_groups / num_workers;
+    j.slots[i].end = (i + 1) * num_work_groups / num_workers;
+  }
+  j.priority = priority;
+  j.starved_since = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock{_mutex};
+  _active_jobs.push_back(&j);
+  ++_num_active_jobs;
+  _work_available.notify_all();
+  // All work has been claimed once the job is exhausted, and all claimed
+  // work has completed once no worker participates anymore.
+  _job_completed.wait(
+      lock, [&]() { return j.is_exhausted && j.num_participants == 0; });
+}
+
+int omp_work_group_pool::get_effective_priority(
+    const job &j, std::chrono::steady_clock::time_point now) const {
+  int top_priority = j.priority;
+  for(const job* other : _active_jobs)
+    top_priority = std::min(top_priority, other->priority);
+
+  // Only jobs without workers age, so that long-running jobs cannot catch
+  // up with new jobs of higher priority while they are being processed.
+  if(j.num_participants > 0)
+    return j.priority;
+
+  // Starved jobs can at most catch up with the highest priority, until a
+  // worker joins them. This bounds the time for which work can be starved,
+  // without reordering jobs of equal priority.
+  auto num_intervals = (now - j.starved_since) / aging_interval;
+  return std::max(top_priority, j.priority - static_cast<int>(num_intervals));
+}
+
+omp_work_group_pool::job* omp_work_group_pool::select_job() const {
+  auto now = std::chrono::steady_clock::now();
+
+  job* selected = nullptr;
+  int selected_priority = 0;
+  for(job* j : _active_jobs) {
+    int priority = get_effective_priority(*j, now);
+    if (!selected || priority < selected_priority ||
+        (priority == selected_priority &&
+         j->num_participants < selected->num_participants)) {
+      selected = j;
+      selected_priority = priority;
+    }
+  }
+  return selected;
+}
+
+bool omp_work_group_pool::should_switch_job(const job &j) const {
+  auto now = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  int priority = get_effective_priority(j, now);
+  for(const job* other : _active_jobs) {
+    int other_priority = get_effective_priority(*other, now);
+    if(other_priority < priority)
+      return true;
+    if (other_priority == priority &&
+        other->num_participants + 1 < j.num_participants)
+      return true;
+  }
+  return false;
+}
+
+bool omp_work_group_pool::claim(job &j, std::size_t worker_id,
+                                std::size_t &begin, std::size_t &end) {
+  range_slot& own = j.slots[worker_id];
+  {
+    common::spin_lock_guard lock{own.lock};
+    if(own.begin < own.end) {
+      begin = own.begin;
+      end = std::min(own.end, begin + j.chunk_size);
+      own.begin = end;
+      return true;
+    }
+  }
+
+  for(std::size_t v : _workers[worker_id].victims) {
+    range_slot& victim = j.slots[v];
+    std::size_t stolen_begin = 0;
+    std::size_t stolen_end = 0;
+    {
+      common::spin_lock_guard lock{victim.lock};
+      std::size_t remaining = victim.end - victim.begin;
+      if(remaining == 0)
+        continue;
+      if(remaining <= j.chunk_size) {
+        stolen_begin = victim.begin;
+      } else {
+        // Steal the upper half, so that the victim can continue
+        // working on contiguous work-groups.
+        stolen_begin = victim.begin + remaining / 2;
+      }
+      stolen_end = victim.end;
+      victim.end = stolen_begin;
+    }
+
+    begin = stolen_begin;
+    end = std::min(stolen_end, begin + j.chunk_size);
+    if(end < stolen_end) {
+      common::spin_lock_guard lock{own.lock};
+      own.begin = end;
+      own.end = stolen_end;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool omp_work_group_pool::process(job &j, std::size_t worker_id) {
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  while(true) {
+    if(_num_active_jobs.load(std::memory_order_relaxed) > 1 &&
+       should_switch_job(j))
+      return false;
+
+    if(!claim(j, worker_id, begin, end))
+      return true;
+
+    j.f(j.user_data, begin, end);
+  }
+}
+
+void omp_work_group_pool::work(std::size_t worker_id) {
+  std::unique_lock<std::mutex> lock{_mutex};
+  while(true) {
+    _work_available.wait(
+        lock, [this]() { return _shutdown || !_active_jobs.empty(); });
+    if(_active_jobs.empty())
+      // Shutdown was requested
+      return;
+
+    job* j = select_job();
+    ++j->num_participants;
+    lock.unlock();
+
+    bool is_exhausted = process(*j, worker_id);
+
+    lock.lock();
+    if(--j->num_participants == 0)
+      j->starved_since = std::chrono::steady_clock::now();
+    if(is_exhausted && !j->is_exhausted) {
+      j->is_exhausted = true;
+      _active_jobs.erase(std::find(_active_jobs.begin(), _active_jobs.end(), j));
+      --_num_active_jobs;
+    }
+    if(j->is_exhausted && j->num_participants == 0)
+      _job_completed.notify_all();
+  }
+}
+
+}
+}
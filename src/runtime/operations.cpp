@@ -52,7 +52,7 @@ kernel_operation::get_launcher() const
 
 void requirements_list::add_requirement(std::unique_ptr<requirement> req)
 {
-  auto node = std::make_shared<dag_node>(
+  auto node = make_dag_node(
     execution_hints{}, 
     node_list_t{},
     std::move(req),
@@ -837,8 +837,9 @@ ACPP_PCUDA_API pcudaError_t pcudaStreamWaitEvent(pcudaStream_t stream,
 
   // TODO Create new API that does not need dag_node_ptr?
   dag_node_ptr node =
-      std::make_shared<dag_node>(execution_hints{}, node_list_t{}, nullptr,
-                                 pcuda_application::get().pcuda_rt().get_rt());
+      make_dag_node(execution_hints{}, node_list_t{},
+                    std::unique_ptr<operation>{},
+                    pcuda_application::get().pcuda_rt().get_rt());
   node->mark_submitted(event->get_event_shared_ptr());
   node->assign_to_device(event->get_device());
 
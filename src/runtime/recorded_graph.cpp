@@ -0,0 +1,256 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
+#include <unordered_map>
+
+#include "hipSYCL/runtime/recorded_graph.hpp"
+#include "hipSYCL/runtime/dag_manager.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Only hints that affect execution are retained; in particular,
+// instrumentation requests are dropped since instrumentations are
+// stored in the shared operation.
+execution_hints get_replay_hints(const dag_node_ptr& node) {
+  const execution_hints& original = node->get_execution_hints();
+  execution_hints hints;
+
+  if(auto* h = original.get_hint<hints::bind_to_device>())
+    hints.set_hint(hints::bind_to_device{*h});
+  else
+    hints.set_hint(hints::bind_to_device{node->get_assigned_device()});
+  if(auto* h = original.get_hint<hints::prefer_executor>())
+    hints.set_hint(hints::prefer_executor{*h});
+  if(original.has_hint<hints::coarse_grained_synchronization>())
+    hints.set_hint(hints::coarse_grained_synchronization{});
+  // Replayed nodes are never processed by the DAG builder
+  hints.set_hint(hints::instant_execution{});
+
+  return hints;
+}
+
+inorder_executor* get_lane_executor(const dag_node_ptr& node) {
+  backend_executor* executor = node->get_assigned_executor();
+  if(!executor)
+    return nullptr;
+
+  if(auto* inorder = dynamic_cast<inorder_executor *>(executor))
+    return inorder;
+  if(auto* mqe = dynamic_cast<multi_queue_executor *>(executor))
+    return mqe->get_lane_executor(node);
+  return nullptr;
+}
+
+bool is_same_operation_type(operation* a, operation* b) {
+  return (dynamic_cast<kernel_operation *>(a) != nullptr) ==
+             (dynamic_cast<kernel_operation *>(b) != nullptr) &&
+         a->is_data_transfer() == b->is_data_transfer();
+}
+
+}
+
+result recorded_graph::create(const node_list_t &nodes,
+                              std::shared_ptr<recorded_graph> &graph_out) {
+  std::shared_ptr<recorded_graph> graph{new recorded_graph{}};
+  graph->_entries.reserve(nodes.size());
+
+  std::unordered_map<dag_node*, std::size_t> node_indices;
+  for(std::size_t i = 0; i < nodes.size(); ++i)
+    node_indices[nodes[i].get()] = i;
+
+  std::vector<bool> has_dependents(nodes.size(), false);
+
+  for(const auto& node : nodes) {
+    if(!node->is_submitted() || node->is_virtual() ||
+       node->get_operation()->is_requirement()) {
+      return make_error(
+          __acpp_here(),
+          error_info{"recorded_graph: Graph can only be created from submitted "
+                     "nodes that do not process buffer requirements",
+                     error_type::feature_not_supported});
+    }
+
+    entry e;
+    e.op = node->get_shared_operation();
+    e.dev = node->get_assigned_device();
+    e.executor = node->get_assigned_executor();
+    e.lane = get_lane_executor(node);
+    e.hints = get_replay_hints(node);
+    e.has_external_dependencies = node->get_requirements().empty();
+
+    for(const auto& weak_req : node->get_requirements()) {
+      auto req = weak_req.lock();
+      if(req && req->get_operation()->is_requirement()) {
+        return make_error(
+            __acpp_here(),
+            error_info{"recorded_graph: Buffer requirements cannot be recorded",
+                       error_type::feature_not_supported});
+      }
+      auto it = req ? node_indices.find(req.get()) : node_indices.end();
+      if(it != node_indices.end()) {
+        if(std::find(e.dependencies.begin(), e.dependencies.end(),
+                     it->second) == e.dependencies.end())
+          e.dependencies.push_back(it->second);
+        has_dependents[it->second] = true;
+      } else {
+        e.has_external_dependencies = true;
+      }
+    }
+
+    if(!e.executor) {
+      return make_error(
+          __acpp_here(),
+          error_info{"recorded_graph: Node was not assigned to an executor"});
+    }
+
+    graph->_entries.push_back(std::move(e));
+  }
+
+  for(std::size_t i = 0; i < has_dependents.size(); ++i)
+    if(!has_dependents[i])
+      graph->_sinks.push_back(i);
+
+  graph_out = graph;
+  return make_success();
+}
+
+result recorded_graph::replay(const node_list_t &external_deps,
+                              std::size_t node_group_id, runtime *rt,
+                              node_list_t &nodes_out) {
+  node_list_t external_reqs;
+  bool requires_flush = false;
+  for(const auto& dep : external_deps) {
+    if(!dep->is_submitted())
+      requires_flush = true;
+  }
+  // Executors can only synchronize with submitted nodes
+  if(requires_flush)
+    rt->dag().flush_and_gc();
+
+  for(const auto& dep : external_deps) {
+    if(dep->is_known_complete())
+      continue;
+    if(dep->is_virtual()) {
+      dep->for_each_nonvirtual_requirement([&](dag_node_ptr req) {
+        if(std::find(external_reqs.begin(), external_reqs.end(), req) ==
+           external_reqs.end())
+          external_reqs.push_back(req);
+      });
+    } else if(std::find(external_reqs.begin(), external_reqs.end(), dep) ==
+              external_reqs.end()) {
+      external_reqs.push_back(dep);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  nodes_out.clear();
+  for(const entry& e : _entries) {
+    node_list_t reqs;
+    for(std::size_t dep : e.dependencies)
+      reqs.push_back(nodes_out[dep]);
+    if(e.has_external_dependencies)
+      for(const auto& req : external_reqs)
+        reqs.push_back(req);
+
+    execution_hints hints = e.hints;
+    hints.set_hint(hints::node_group{node_group_id});
+
+    dag_node_ptr node = make_dag_node(hints, reqs, e.op, rt);
+    node->assign_to_device(e.dev);
+    node->assign_to_executor(e.executor);
+
+    if(e.lane)
+      e.lane->submit_directly(node, node->get_operation(), reqs);
+    else
+      e.executor->submit_directly(node, node->get_operation(), reqs);
+
+    if(!node->is_submitted()) {
+      return make_error(
+          __acpp_here(),
+          error_info{"recorded_graph: Submission of replayed node failed"});
+    }
+    // Allows waiting for the node group
+    rt->dag().register_submitted_ops(node);
+    nodes_out.push_back(node);
+  }
+
+  return make_success();
+}
+
+result recorded_graph::update_operation(std::size_t index,
+                                        const dag_node_ptr &node) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  if(index >= _entries.size()) {
+    return make_error(
+        __acpp_here(),
+        error_info{"recorded_graph: Operation index out of range",
+                   error_type::invalid_parameter_error});
+  }
+
+  entry& e = _entries[index];
+  operation* op = node->get_operation();
+  if(op->is_requirement() || !is_same_operation_type(op, e.op.get())) {
+    return make_error(
+        __acpp_here(),
+        error_info{"recorded_graph: Operation can only be replaced by an "
+                   "operation of the same type",
+                   error_type::invalid_parameter_error});
+  }
+  // For data transfers, the device that has processed the operation
+  // might not be the device that the operation was bound to.
+  auto* bound_device =
+      node->get_execution_hints().get_hint<hints::bind_to_device>();
+  if(!bound_device || !(bound_device->get_device_id() ==
+                        e.hints.get_hint<hints::bind_to_device>()->get_device_id())) {
+    return make_error(
+        __acpp_here(),
+        error_info{"recorded_graph: Replacement operation must target the "
+                   "device of the original operation",
+                   error_type::invalid_parameter_error});
+  }
+
+  // The node has only been captured, so assign it like the scheduler would
+  // have: To the executor it prefers, or otherwise to the executor of the
+  // recorded operation.
+  backend_executor* executor = e.executor;
+  if(auto* h = node->get_execution_hints().get_hint<hints::prefer_executor>())
+    executor = h->get_executor();
+  node->assign_to_device(e.dev);
+  node->assign_to_executor(executor);
+
+  e.op = node->get_shared_operation();
+  e.executor = executor;
+  e.lane = get_lane_executor(node);
+  e.hints = get_replay_hints(node);
+  return make_success();
+}
+
+std::size_t recorded_graph::get_num_operations() const {
+  return _entries.size();
+}
+
+const std::vector<std::size_t>& recorded_graph::get_sink_indices() const {
+  return _sinks;
+}
+
+}
+}
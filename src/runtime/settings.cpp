@@ -202,6 +202,20 @@ std::istream &operator>>(std::istream &istr, default_selector_behavior& out) {
   return istr;
 }
 
+std::istream &operator>>(std::istream &istr, omp_parallel_for_tiling& out) {
+  std::string str;
+  istr >> str;
+  if (str == "none")
+    out = omp_parallel_for_tiling::none;
+  else if (str == "row_major")
+    out = omp_parallel_for_tiling::row_major;
+  else if (str == "morton")
+    out = omp_parallel_for_tiling::morton;
+  else
+    istr.setstate(std::ios_base::failbit);
+  return istr;
+}
+
 std::istream &operator>>(std::istream &istr, std::optional<jitopt_host_vector_math_library>& out) {
   std::string str;
   istr >> str;
@@ -481,7 +481,14 @@ result ze_queue::submit_sscp_kernel_from_code_object(
   _config.set_build_flag(
       kernel_build_flag::spirv_enable_intel_llvm_spirv_options);
 
+  auto create_translator = [](const std::vector<std::string> &kernel_names) {
+    return compiler::createLLVMToSpirvTranslator(kernel_names);
+  };
+
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
+  binary_configuration_id = adaptivity_engine.defer_specialization(
+      _config, binary_configuration_id, *_kernel_cache, _reflection_map,
+      create_translator);
   auto code_object_configuration_id = binary_configuration_id;
   
   kernel_configuration::extend_hash(
@@ -491,28 +498,10 @@ result ze_queue::submit_sscp_kernel_from_code_object(
       code_object_configuration_id,
       kernel_base_config_parameter::runtime_context, ctx);
 
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-
-    std::vector<std::string> kernel_names;
-    std::string selected_image_name =
-        adaptivity_engine.select_image_and_kernels(&kernel_names);
-
-    // Construct SPIR-V translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
-    
-    // Lower kernels to SPIR-V
-    bool enable_dead_arg_elimination = kernel_names.size() == 1;
-    rt::result err = glue::jit::compile_and_store_stats(
-        translator.get(), hcf_object, selected_image_name, _config,
-        binary_configuration_id, _reflection_map, compiled_image,
-        enable_dead_arg_elimination);
-    
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+  auto jit_compiler = [&](std::string &compiled_image) -> bool {
+    return adaptivity_engine.make_jit_compiler(
+        _config, binary_configuration_id, _reflection_map,
+        create_translator)(compiled_image);
   };
 
   auto code_object_constructor = [&](const std::string& compiled_image) -> code_object* {
@@ -191,7 +191,7 @@ int main(int argc, char** argv) {
 
     if(!current->has_binary_data_attached()) {
       hcf.attach_binary_content(current, content);
-      std::cout << hcf.serialize();
+      std::cout << hcf.serialize_text();
     } else {
       hipsycl::common::hcf_container new_container;
 
@@ -218,7 +218,7 @@ int main(int argc, char** argv) {
         return -1;
       }
 
-      std::cout << new_container.serialize();
+      std::cout << new_container.serialize_text();
     }
   }
 
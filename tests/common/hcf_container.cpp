@@ -0,0 +1,214 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "../runtime/runtime_test_suite.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <hipSYCL/common/hcf_container.hpp>
+
+using hipsycl::common::hcf_container;
+
+namespace {
+
+// Offsets within the binary format: magic, u32 version, root node
+constexpr std::size_t magic_size = 8;
+constexpr std::size_t version_offset = magic_size;
+constexpr std::size_t root_node_offset = version_offset + sizeof(uint32_t);
+
+std::string make_binary(std::size_t size, char seed) {
+  std::string result(size, '\0');
+  for(std::size_t i = 0; i < size; ++i)
+    result[i] = static_cast<char>(seed + i * 7);
+  return result;
+}
+
+// Resembles the containers emitted by the SSCP compiler: Kernel
+// metadata, lists and binary attachments containing arbitrary bytes.
+hcf_container make_container() {
+  hcf_container hcf;
+  auto* root = hcf.root_node();
+  root->set("object-id", "12345");
+  root->set("generator", "test");
+
+  auto* images = root->add_subnode("images");
+  images->add_subnode("llvm-ir.global")->set("format", "llvm-ir");
+  images->add_subnode("spirv")->set("format", "spirv");
+  hcf.attach_binary_content(hcf.root_node()->get_subnode("images")
+                                ->get_subnode("llvm-ir.global"),
+                            make_binary(1000, 'a'));
+  hcf.attach_binary_content(hcf.root_node()->get_subnode("images")
+                                ->get_subnode("spirv"),
+                            make_binary(10, '\0'));
+
+  auto* kernels = hcf.root_node()->add_subnode("kernels");
+  auto* kernel = kernels->add_subnode("kernel_a");
+  kernel->set_as_list("image-providers", {"llvm-ir.global", "spirv"});
+  kernel->set("param-count", "3");
+  return hcf;
+}
+
+void check_equal(const hcf_container::node& a, const hcf_container::node& b) {
+  BOOST_CHECK_EQUAL(a.node_id, b.node_id);
+  BOOST_REQUIRE_EQUAL(a.key_value_pairs.size(), b.key_value_pairs.size());
+  for(std::size_t i = 0; i < a.key_value_pairs.size(); ++i) {
+    BOOST_CHECK_EQUAL(a.key_value_pairs[i].first, b.key_value_pairs[i].first);
+    BOOST_CHECK_EQUAL(a.key_value_pairs[i].second, b.key_value_pairs[i].second);
+  }
+  BOOST_REQUIRE_EQUAL(a.subnodes.size(), b.subnodes.size());
+  for(std::size_t i = 0; i < a.subnodes.size(); ++i)
+    check_equal(a.subnodes[i], b.subnodes[i]);
+}
+
+void check_attachments(const hcf_container& hcf) {
+  auto* images = hcf.root_node()->get_subnode("images");
+  BOOST_TEST_REQUIRE(images);
+  std::string data;
+  BOOST_CHECK(hcf.get_binary_attachment(images->get_subnode("llvm-ir.global"),
+                                        data));
+  BOOST_CHECK(data == make_binary(1000, 'a'));
+  BOOST_CHECK(hcf.get_binary_attachment(images->get_subnode("spirv"), data));
+  BOOST_CHECK(data == make_binary(10, '\0'));
+}
+
+bool is_empty(const hcf_container& hcf) {
+  return hcf.root_node()->key_value_pairs.empty() &&
+         hcf.root_node()->subnodes.empty();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(hcf_container_tests)
+
+BOOST_AUTO_TEST_CASE(binary_round_trip) {
+  hcf_container original = make_container();
+  const std::string serialized = original.serialize();
+  BOOST_CHECK_EQUAL(serialized.substr(0, magic_size), "ACPPHCFB");
+
+  hcf_container parsed{serialized};
+  check_equal(*original.root_node(), *parsed.root_node());
+  check_attachments(parsed);
+  BOOST_CHECK(parsed.serialize() == serialized);
+
+  // Attachments can also be referenced in place
+  hcf_container non_owning =
+      hcf_container::create_non_owning(serialized.data(), serialized.size());
+  check_equal(*original.root_node(), *non_owning.root_node());
+  check_attachments(non_owning);
+}
+
+BOOST_AUTO_TEST_CASE(text_and_binary_are_equivalent) {
+  hcf_container original = make_container();
+  hcf_container from_text{original.serialize_text()};
+  hcf_container from_binary{original.serialize()};
+
+  check_equal(*from_text.root_node(), *from_binary.root_node());
+  check_attachments(from_text);
+  check_attachments(from_binary);
+  BOOST_CHECK(from_text.serialize() == from_binary.serialize());
+  BOOST_CHECK(from_text.serialize_text() == from_binary.serialize_text());
+}
+
+BOOST_AUTO_TEST_CASE(truncated_input_is_rejected) {
+  const std::string serialized = make_container().serialize();
+  // Copies of each prefix, so that reads beyond the end are detected
+  // by sanitizers.
+  for(std::size_t size = 0; size < serialized.size(); ++size) {
+    BOOST_TEST_INFO("size: " << size);
+    hcf_container parsed{serialized.substr(0, size)};
+    BOOST_CHECK(is_empty(parsed));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_input_is_rejected) {
+  const std::string serialized = make_container().serialize();
+
+  // Without the magic, the data is treated as text, which it is not
+  std::string bad_magic = serialized;
+  bad_magic[0] = 'X';
+  BOOST_CHECK(is_empty(hcf_container{bad_magic}));
+
+  std::string bad_version = serialized;
+  bad_version[version_offset] = 2;
+  BOOST_CHECK(is_empty(hcf_container{bad_version}));
+
+  // Entry counts and string lengths beyond the end of the data
+  std::string bad_count = serialized;
+  bad_count[root_node_offset + 3] = '\x7f';
+  BOOST_CHECK(is_empty(hcf_container{bad_count}));
+
+  std::string bad_length = serialized;
+  bad_length[root_node_offset + sizeof(uint32_t) + 3] = '\x7f';
+  BOOST_CHECK(is_empty(hcf_container{bad_length}));
+
+  std::string bad_appendix_size = serialized;
+  std::size_t appendix_size_offset = serialized.size() - 1010 - sizeof(uint64_t);
+  bad_appendix_size[appendix_size_offset + 7] = '\x7f';
+  BOOST_CHECK(is_empty(hcf_container{bad_appendix_size}));
+
+  // Flipping single bytes must never read out of bounds
+  for(std::size_t i = 0; i < serialized.size(); ++i) {
+    std::string corrupted = serialized;
+    corrupted[i] ^= 0xff;
+    hcf_container parsed{corrupted};
+    std::string data;
+    if(auto* images = parsed.root_node()->get_subnode("images"))
+      for(const auto& image : images->subnodes)
+        parsed.get_binary_attachment(&image, data);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(indexed_lookup) {
+  constexpr int num_entries = 20;
+  hcf_container hcf;
+  auto* root = hcf.root_node();
+  for(int i = 0; i < num_entries; ++i) {
+    root->set("key" + std::to_string(i), "value" + std::to_string(i));
+    root->add_subnode("node" + std::to_string(i))
+        ->set("id", std::to_string(i));
+  }
+  // Duplicate keys resolve to the first entry, with or without index
+  root->set("key3", "duplicate");
+
+  auto check_lookup = [&](const hcf_container::node& n) {
+    for(int i = 0; i < num_entries; ++i) {
+      auto* value = n.get_value("key" + std::to_string(i));
+      BOOST_TEST_REQUIRE(value);
+      BOOST_CHECK_EQUAL(*value, "value" + std::to_string(i));
+      auto* subnode = n.get_subnode("node" + std::to_string(i));
+      BOOST_TEST_REQUIRE(subnode);
+      BOOST_CHECK_EQUAL(*subnode->get_value("id"), std::to_string(i));
+    }
+    BOOST_CHECK(!n.has_key("key20"));
+    BOOST_CHECK(!n.has_subnode("node20"));
+    // Existing names cannot be added again
+    BOOST_CHECK(!hcf_container::node{n}.add_subnode("node7"));
+  };
+
+  // Index built incrementally while adding entries
+  check_lookup(*root);
+  // Index built when parsing
+  check_lookup(*hcf_container{hcf.serialize()}.root_node());
+  check_lookup(*hcf_container{hcf.serialize_text()}.root_node());
+
+  // Modifying entries directly invalidates the index, and lookups
+  // fall back to linear search until it is rebuilt.
+  root->key_value_pairs.erase(root->key_value_pairs.begin());
+  BOOST_CHECK(!root->has_key("key0"));
+  BOOST_CHECK_EQUAL(*root->get_value("key1"), "value1");
+  root->build_index();
+  BOOST_CHECK(!root->has_key("key0"));
+  BOOST_CHECK_EQUAL(*root->get_value("key19"), "value19");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "../runtime/runtime_test_suite.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <hipSYCL/common/pooled_allocator.hpp>
+
+using hipsycl::common::block_pool;
+using hipsycl::common::pooled_allocator;
+
+// Pools are global per block size, so each test uses its own block size
+// to start out with empty pools and thread caches.
+BOOST_AUTO_TEST_SUITE(pooled_allocator_tests)
+
+BOOST_AUTO_TEST_CASE(same_thread_reuse) {
+  using pool = block_pool<1000>;
+  void* a = pool::allocate();
+  void* b = pool::allocate();
+  BOOST_CHECK_NE(a, b);
+  pool::deallocate(a);
+  BOOST_CHECK_EQUAL(pool::allocate(), a);
+  pool::deallocate(a);
+  pool::deallocate(b);
+}
+
+BOOST_AUTO_TEST_CASE(cross_thread_reuse) {
+  using pool = block_pool<1001>;
+  // Enough blocks to exceed the thread cache, so that blocks are handed
+  // over in batches while freeing as well as when the thread exits.
+  constexpr std::size_t num_blocks = 1000;
+
+  std::vector<void*> blocks(num_blocks);
+  std::thread producer{[&]() {
+    for(auto& ptr : blocks) {
+      ptr = pool::allocate();
+      std::memset(ptr, 0xab, 1001);
+    }
+  }};
+  producer.join();
+  BOOST_CHECK_EQUAL(std::set<void*>(blocks.begin(), blocks.end()).size(),
+                    num_blocks);
+
+  std::thread consumer{[&]() {
+    for(void* ptr : blocks)
+      pool::deallocate(ptr);
+  }};
+  consumer.join();
+
+  // All blocks have been returned to the global list by now
+  std::set<void*> reallocated;
+  for(std::size_t i = 0; i < num_blocks; ++i)
+    reallocated.insert(pool::allocate());
+  BOOST_CHECK(reallocated == std::set<void*>(blocks.begin(), blocks.end()));
+
+  for(void* ptr : reallocated)
+    pool::deallocate(ptr);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_allocation) {
+  using pool = block_pool<1002>;
+  constexpr std::size_t num_threads = 8;
+  constexpr std::size_t num_iterations = 2000;
+
+  // Threads free the blocks of their neighbor, so that blocks
+  // continuously move between threads.
+  std::vector<std::vector<unsigned char*>> handed_over(num_threads);
+  std::atomic<std::size_t> num_errors = 0;
+  std::vector<std::thread> threads;
+  for(std::size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<unsigned char*> live;
+      for(std::size_t i = 0; i < num_iterations; ++i) {
+        auto* ptr = static_cast<unsigned char*>(pool::allocate());
+        std::memset(ptr, static_cast<int>(t), 1002);
+        live.push_back(ptr);
+        if(i % 2 == 0) {
+          unsigned char* p = live[live.size() / 2];
+          live.erase(live.begin() + live.size() / 2);
+          for(std::size_t j = 0; j < 1002; ++j)
+            if(p[j] != t)
+              ++num_errors;
+          pool::deallocate(p);
+        }
+      }
+      handed_over[t] = std::move(live);
+    });
+  }
+  for(auto& t : threads)
+    t.join();
+  BOOST_CHECK_EQUAL(num_errors.load(), 0);
+
+  threads.clear();
+  for(std::size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for(void* ptr : handed_over[(t + 1) % num_threads])
+        pool::deallocate(ptr);
+    });
+  }
+  for(auto& t : threads)
+    t.join();
+}
+
+BOOST_AUTO_TEST_CASE(allocate_shared) {
+  struct object {
+    char data[200];
+  };
+  pooled_allocator<object> alloc;
+  object* first = nullptr;
+  {
+    auto ptr = std::allocate_shared<object>(alloc);
+    first = ptr.get();
+  }
+  // The control block and object are allocated together, and reused
+  auto ptr = std::allocate_shared<object>(alloc);
+  BOOST_CHECK_EQUAL(ptr.get(), first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <algorithm>
+#include <cstdint>
 #include <execution>
 #include <utility>
 #include <vector>
@@ -23,13 +24,14 @@
 
 BOOST_FIXTURE_TEST_SUITE(pstl_sort, enable_unified_shared_memory)
 
-template <class Policy, class Generator, class Comp = std::less<>>
+template <class T = int, class Policy, class Generator,
+          class Comp = std::less<>>
 void test_sort(Policy &&pol, std::size_t problem_size, Generator gen,
                Comp comp = {}) {
-  std::vector<int> data(problem_size);
+  std::vector<T> data(problem_size);
   for(int i = 0; i < problem_size; ++i)
     data[i] = gen(i);
-  std::vector<int> host_data = data;
+  std::vector<T> host_data = data;
 
   std::sort(pol, data.begin(), data.end(), comp);
   
@@ -63,4 +65,41 @@ BOOST_AUTO_TEST_CASE(par_unseq_non_pow2_ascending) {
   test_sort(std::execution::par_unseq, 1000, [](int i){return i;});
 }
 
+// Large problem sizes use radix sort for arithmetic types
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_random) {
+  test_sort(std::execution::par_unseq, 1 << 18,
+            [](int i) { return static_cast<int>((i * 2654435761u) % 100003) - 50000; });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_random_greater) {
+  test_sort(std::execution::par_unseq, 100000,
+            [](int i) { return static_cast<int>((i * 2654435761u) % 1000); },
+            std::greater<>{});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_float) {
+  test_sort<float>(std::execution::par_unseq, 100000, [](int i) {
+    return static_cast<float>((i * 2654435761u) % 20001) * 0.5f - 5000.f;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_uint64) {
+  test_sort<uint64_t>(std::execution::par_unseq, 100000, [](int i) {
+    return static_cast<uint64_t>(i) * 11400714819323198485ull;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_custom_comp) {
+  test_sort(std::execution::par_unseq, 100000,
+            [](int i) { return static_cast<int>((i * 2654435761u) % 100003); },
+            [](int a, int b) { return (a % 1000) < (b % 1000) ||
+                                      ((a % 1000) == (b % 1000) && a < b); });
+}
+
+BOOST_AUTO_TEST_CASE(par_large_random) {
+  test_sort(std::execution::par, 1 << 18,
+            [](int i) { return static_cast<int>((i * 2654435761u) % 100003) - 50000; });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
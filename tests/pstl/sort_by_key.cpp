@@ -0,0 +1,105 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sycl/sycl.hpp>
+#include "hipSYCL/algorithms/algorithm.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+#include "pstl_test_suite.hpp"
+
+BOOST_AUTO_TEST_SUITE(pstl_sort_by_key)
+
+namespace algorithms = hipsycl::algorithms;
+
+template<class T>
+using shared_vector =
+    std::vector<T, sycl::usm_allocator<T, sycl::usm::alloc::shared>>;
+
+template <class Generator, class Comp = std::less<>>
+void test_sort_by_key(std::size_t problem_size, Generator gen, Comp comp = {}) {
+  sycl::queue q;
+  algorithms::util::allocation_cache cache{
+      algorithms::util::allocation_type::device};
+
+  shared_vector<int> keys(problem_size, q);
+  // Values carry the original position, so that stability can be verified.
+  shared_vector<non_trivial_copy> values(problem_size, q);
+  std::vector<std::pair<int, int>> reference(problem_size);
+  for(int i = 0; i < problem_size; ++i) {
+    keys[i] = gen(i);
+    values[i] = non_trivial_copy{i};
+    reference[i] = std::make_pair(keys[i], i);
+  }
+
+  {
+    algorithms::util::allocation_group scratch{&cache, q.get_device()};
+    algorithms::sort_by_key(q, scratch, keys.begin(), keys.end(),
+                            values.begin(), comp)
+        .wait_and_throw();
+  }
+
+  std::stable_sort(reference.begin(), reference.end(),
+                   [&](const auto &a, const auto &b) {
+                     return comp(a.first, b.first);
+                   });
+
+  for(std::size_t i = 0; i < problem_size; ++i) {
+    BOOST_CHECK_EQUAL(keys[i], reference[i].first);
+    BOOST_CHECK_EQUAL(values[i].x, reference[i].second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(empty) {
+  test_sort_by_key(0, [](int i){ return 0; });
+}
+
+BOOST_AUTO_TEST_CASE(single_element) {
+  test_sort_by_key(1, [](int i){ return 42; });
+}
+
+BOOST_AUTO_TEST_CASE(small_duplicate_keys) {
+  test_sort_by_key(1000, [](int i){ return i % 7; });
+}
+
+BOOST_AUTO_TEST_CASE(small_all_equal_keys) {
+  test_sort_by_key(777, [](int i){ return 3; });
+}
+
+BOOST_AUTO_TEST_CASE(large_duplicate_keys) {
+  test_sort_by_key(1 << 17, [](int i) {
+    return static_cast<int>((i * 2654435761u) % 97) - 48;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(large_duplicate_keys_descending) {
+  test_sort_by_key(1 << 17, [](int i) {
+    return static_cast<int>((i * 2654435761u) % 97) - 48;
+  }, std::greater<>{});
+}
+
+BOOST_AUTO_TEST_CASE(custom_comparator_duplicate_keys) {
+  // Orders by absolute value, so that keys of different sign compare equal
+  auto abs_less = [](int a, int b) {
+    return (a < 0 ? -a : a) < (b < 0 ? -b : b);
+  };
+  test_sort_by_key(50000, [](int i) {
+    return static_cast<int>((i * 2654435761u) % 201) - 100;
+  }, abs_less);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <utility>
+#include <vector>
+#include <functional>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_stable_sort, enable_unified_shared_memory)
+
+struct key_value {
+  int key;
+  int value;
+
+  friend bool operator==(const key_value &a, const key_value &b) {
+    return a.key == b.key && a.value == b.value;
+  }
+};
+
+template <class Policy, class Generator, class Comp = std::less<>>
+void test_stable_sort(Policy &&pol, std::size_t problem_size, Generator gen,
+                      Comp comp = {}) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+  std::vector<int> host_data = data;
+
+  std::stable_sort(pol, data.begin(), data.end(), comp);
+
+  std::stable_sort(host_data.begin(), host_data.end(), comp);
+  BOOST_CHECK(host_data == data);
+}
+
+template <class Policy, class Generator>
+void test_stable_sort_key_value(Policy &&pol, std::size_t problem_size,
+                                Generator gen) {
+  std::vector<key_value> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = key_value{gen(i), i};
+  std::vector<key_value> host_data = data;
+
+  auto comp = [](const key_value &a, const key_value &b) {
+    return a.key < b.key;
+  };
+  std::stable_sort(pol, data.begin(), data.end(), comp);
+
+  std::stable_sort(host_data.begin(), host_data.end(), comp);
+  BOOST_CHECK(host_data == data);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_stable_sort(std::execution::par_unseq, 0, [](int i){return 0;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_stable_sort(std::execution::par_unseq, 1, [](int i){return i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_non_pow2_descending) {
+  test_stable_sort(std::execution::par_unseq, 1000, [](int i){return -i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_random) {
+  test_stable_sort(std::execution::par_unseq, 1 << 18, [](int i) {
+    return static_cast<int>((i * 2654435761u) % 100003);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_key_value_small) {
+  test_stable_sort_key_value(std::execution::par_unseq, 1000,
+                             [](int i) { return i % 7; });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_key_value_large) {
+  test_stable_sort_key_value(std::execution::par_unseq, 100000, [](int i) {
+    return static_cast<int>((i * 2654435761u) % 97);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(par_key_value_large) {
+  test_stable_sort_key_value(std::execution::par, 100000, [](int i) {
+    return static_cast<int>((i * 2654435761u) % 97);
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
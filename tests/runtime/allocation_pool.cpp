@@ -0,0 +1,220 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <cstdlib>
+#include <unordered_map>
+
+#include <hipSYCL/runtime/allocation_pool.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+using allocation_kind = rt::allocation_pool::allocation_kind;
+
+// Allocates from the host heap and keeps track of the memory handed out.
+// Fails allocations that would exceed the capacity.
+class test_allocator : public rt::backend_allocator {
+public:
+  test_allocator(std::size_t capacity = std::size_t(-1))
+  : _capacity{capacity} {}
+
+  ~test_allocator() {
+    for(auto& allocation : _allocations)
+      std::free(allocation.first);
+  }
+
+  void *raw_allocate(size_t min_alignment, size_t size_bytes,
+                     const rt::allocation_hints &hints) override {
+    if(num_allocated_bytes + size_bytes > _capacity)
+      return nullptr;
+    void* ptr = std::malloc(size_bytes);
+    _allocations[ptr] = size_bytes;
+    num_allocated_bytes += size_bytes;
+    ++num_allocations;
+    return ptr;
+  }
+
+  void *raw_allocate_optimized_host(size_t min_alignment, size_t bytes,
+                                    const rt::allocation_hints &hints) override {
+    return raw_allocate(min_alignment, bytes, hints);
+  }
+
+  void raw_free(void *mem) override {
+    auto it = _allocations.find(mem);
+    BOOST_REQUIRE(it != _allocations.end());
+    num_allocated_bytes -= it->second;
+    _allocations.erase(it);
+    std::free(mem);
+    ++num_frees;
+  }
+
+  void *raw_allocate_usm(size_t bytes,
+                         const rt::allocation_hints &hints) override {
+    return raw_allocate(0, bytes, hints);
+  }
+
+  rt::device_id get_device() const override {
+    return rt::device_id{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                                rt::api_platform::omp},
+                         0};
+  }
+
+  bool is_usm_accessible_from(rt::backend_descriptor b) const override {
+    return true;
+  }
+
+  rt::result query_pointer(const void *ptr,
+                           rt::pointer_info &out) const override {
+    return rt::make_success();
+  }
+
+  rt::result mem_advise(const void *addr, std::size_t num_bytes,
+                        int advise) const override {
+    return rt::make_success();
+  }
+
+  std::size_t num_allocated_bytes = 0;
+  std::size_t num_allocations = 0;
+  std::size_t num_frees = 0;
+
+private:
+  std::size_t _capacity;
+  std::unordered_map<void*, std::size_t> _allocations;
+};
+
+void *allocate(rt::allocation_pool &pool, test_allocator &alloc,
+               std::size_t size, allocation_kind kind = allocation_kind::device) {
+  return pool.allocate(&alloc, kind, 0, size, rt::allocation_hints{});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(allocation_pool)
+
+BOOST_AUTO_TEST_CASE(size_class_reuse) {
+  test_allocator alloc;
+  rt::allocation_pool pool{1024 * 1024};
+
+  // 1000 and 1010 bytes both round up to the 1024 byte class
+  void* a = allocate(pool, alloc, 1000);
+  BOOST_TEST_REQUIRE(a);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 1024);
+  pool.free(&alloc, a);
+  BOOST_CHECK_EQUAL(alloc.num_frees, 0);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 1024);
+
+  void* b = allocate(pool, alloc, 1010);
+  BOOST_CHECK_EQUAL(b, a);
+  BOOST_CHECK_EQUAL(alloc.num_allocations, 1);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 0);
+  pool.free(&alloc, b);
+
+  // Neither a different size class nor a different kind of memory
+  // may reuse the block.
+  void* c = allocate(pool, alloc, 1200);
+  void* d = allocate(pool, alloc, 1000, allocation_kind::host);
+  BOOST_CHECK_NE(c, a);
+  BOOST_CHECK_NE(d, a);
+  BOOST_CHECK_EQUAL(alloc.num_allocations, 3);
+
+  pool.free(&alloc, c);
+  pool.free(&alloc, d);
+  pool.release_all();
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(free_through_other_allocator) {
+  test_allocator first;
+  test_allocator second;
+  rt::allocation_pool pool{1024 * 1024};
+
+  void* a = allocate(pool, first, 4096);
+  void* b = allocate(pool, second, 4096);
+  // The block returns to the allocator it came from
+  pool.free(&second, a);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&first), 4096);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&second), 0);
+  BOOST_CHECK_EQUAL(allocate(pool, first, 4096), a);
+
+  pool.free(&first, a);
+  pool.free(&second, b);
+  pool.release_all();
+  BOOST_CHECK_EQUAL(first.num_allocated_bytes, 0);
+  BOOST_CHECK_EQUAL(second.num_allocated_bytes, 0);
+}
+
+BOOST_AUTO_TEST_CASE(max_cached_bytes) {
+  test_allocator alloc;
+  rt::allocation_pool pool{4096};
+
+  void* blocks[5];
+  for(auto& ptr : blocks)
+    ptr = allocate(pool, alloc, 1024);
+  for(auto* ptr : blocks)
+    pool.free(&alloc, ptr);
+  // Only four blocks fit into the cache, the last one is returned
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 4096);
+  BOOST_CHECK_EQUAL(alloc.num_frees, 1);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 4096);
+
+  // Allocations larger than the cache bypass the pool
+  void* large = allocate(pool, alloc, 8192);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 4096 + 8192);
+  pool.free(&alloc, large);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 4096);
+
+  pool.release(&alloc);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 0);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 0);
+  pool.release_all();
+}
+
+BOOST_AUTO_TEST_CASE(no_caching) {
+  test_allocator alloc;
+  rt::allocation_pool pool{0};
+
+  void* a = allocate(pool, alloc, 1000);
+  // Sizes are not rounded up to size classes
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 1000);
+  pool.free(&alloc, a);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 0);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 0);
+}
+
+BOOST_AUTO_TEST_CASE(release_and_retry_on_oom) {
+  test_allocator alloc{8192};
+  rt::allocation_pool pool{1024 * 1024};
+
+  void* blocks[4];
+  for(auto& ptr : blocks)
+    ptr = allocate(pool, alloc, 2048);
+  for(auto* ptr : blocks)
+    pool.free(&alloc, ptr);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 8192);
+
+  // Does not fit next to the cached blocks, so they need to be released
+  void* large = allocate(pool, alloc, 4096);
+  BOOST_TEST_REQUIRE(large);
+  BOOST_CHECK_EQUAL(pool.get_num_cached_bytes(&alloc), 0);
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 4096);
+
+  // Fails even without cached memory
+  BOOST_CHECK(!allocate(pool, alloc, 8192));
+
+  pool.free(&alloc, large);
+  pool.release_all();
+  BOOST_CHECK_EQUAL(alloc.num_allocated_bytes, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
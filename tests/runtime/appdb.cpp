@@ -0,0 +1,242 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <hipSYCL/common/appdb.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+using kernel_id = rt::kernel_configuration::id_type;
+
+const kernel_id test_kernel{1, 2};
+
+// Provides a fresh app db path in the temporary directory, and removes
+// all files belonging to the app db afterwards.
+struct appdb_fixture {
+  appdb_fixture() {
+    db_path = (std::filesystem::temp_directory_path() /
+               ("acpp-appdb-test-" + std::to_string(std::random_device{}())))
+                  .string();
+    common::db::appdb::clear(db_path);
+  }
+
+  ~appdb_fixture() {
+    common::db::appdb::clear(db_path);
+    std::error_code ec;
+    std::filesystem::remove(db_path + ".lock", ec);
+  }
+
+  std::string journal_path() const { return db_path + ".journal"; }
+
+  std::string db_path;
+};
+
+void add_invocations(common::db::appdb &db, std::size_t num_invocations) {
+  db.read_write_access([&](common::db::appdb_data &data) {
+    data.kernels[test_kernel].num_registered_invocations += num_invocations;
+  });
+}
+
+void track_value(common::db::appdb &db, uint64_t value, uint64_t count) {
+  db.read_write_access([&](common::db::appdb_data &data) {
+    auto &entry = data.kernels[test_kernel];
+    if (entry.kernel_args.empty())
+      entry.kernel_args.resize(1);
+    auto &arg = entry.kernel_args[0];
+    for (auto &stats : arg.common_values) {
+      if (stats.count > 0 && stats.value == value) {
+        stats.count += count;
+        return;
+      }
+    }
+    for (auto &stats : arg.common_values) {
+      if (stats.count == 0) {
+        stats.value = value;
+        stats.count = count;
+        return;
+      }
+    }
+  });
+}
+
+std::size_t get_invocations(const std::string &db_path) {
+  common::db::appdb db{db_path};
+  return db.read_access([&](const common::db::appdb_data &data) {
+    auto it = data.kernels.find(test_kernel);
+    return it == data.kernels.end() ? std::size_t{0}
+                                    : it->second.num_registered_invocations;
+  });
+}
+
+uint64_t get_value_count(const std::string &db_path, uint64_t value) {
+  common::db::appdb db{db_path};
+  return db.read_access([&](const common::db::appdb_data &data) {
+    auto it = data.kernels.find(test_kernel);
+    if (it == data.kernels.end() || it->second.kernel_args.empty())
+      return uint64_t{0};
+    for (const auto &stats : it->second.kernel_args[0].common_values)
+      if (stats.count > 0 && stats.value == value)
+        return stats.count;
+    return uint64_t{0};
+  });
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(appdb, appdb_fixture)
+
+BOOST_AUTO_TEST_CASE(journal_replay) {
+  for (int i = 0; i < 3; ++i) {
+    common::db::appdb db{db_path};
+    add_invocations(db, 10);
+  }
+  BOOST_CHECK(std::filesystem::exists(journal_path()));
+  BOOST_CHECK_EQUAL(get_invocations(db_path), 30);
+}
+
+BOOST_AUTO_TEST_CASE(unmodified_db_is_not_written) {
+  { common::db::appdb db{db_path}; }
+  BOOST_CHECK(!std::filesystem::exists(journal_path()));
+  BOOST_CHECK(!std::filesystem::exists(db_path));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_instances_are_merged) {
+  {
+    common::db::appdb db{db_path};
+    add_invocations(db, 5);
+    track_value(db, 42, 5);
+  }
+  {
+    // Both instances load the same state, as concurrently running
+    // processes of the same application would.
+    common::db::appdb first{db_path};
+    common::db::appdb second{db_path};
+    add_invocations(first, 3);
+    track_value(first, 42, 3);
+    add_invocations(second, 7);
+    track_value(second, 42, 7);
+    track_value(second, 100, 1);
+  }
+  BOOST_CHECK_EQUAL(get_invocations(db_path), 15);
+  BOOST_CHECK_EQUAL(get_value_count(db_path, 42), 15);
+  BOOST_CHECK_EQUAL(get_value_count(db_path, 100), 1);
+}
+
+BOOST_AUTO_TEST_CASE(journal_is_merged_into_snapshot) {
+  const int num_runs = 100;
+  for (int i = 0; i < num_runs; ++i) {
+    common::db::appdb db{db_path};
+    add_invocations(db, 1);
+  }
+  // The journal is merged into the snapshot after a bounded number
+  // of records, so a snapshot must exist by now.
+  BOOST_CHECK(std::filesystem::exists(db_path));
+  BOOST_CHECK_EQUAL(get_invocations(db_path), num_runs);
+
+  uint64_t content_version = 0;
+  {
+    common::db::appdb db{db_path};
+    content_version = db.read_access(
+        [](const common::db::appdb_data &data) { return data.content_version; });
+  }
+  BOOST_CHECK_EQUAL(content_version, num_runs);
+}
+
+BOOST_AUTO_TEST_CASE(stale_journal_is_ignored) {
+  const std::string journal_copy = journal_path() + ".copy";
+  {
+    common::db::appdb db{db_path};
+    add_invocations(db, 1);
+  }
+  // Run until the journal is merged into the snapshot, keeping a copy of
+  // the journal as it was before the merge.
+  for (int i = 0; i < 100 && std::filesystem::exists(journal_path()); ++i) {
+    std::filesystem::copy_file(
+        journal_path(), journal_copy,
+        std::filesystem::copy_options::overwrite_existing);
+    common::db::appdb db{db_path};
+    add_invocations(db, 1);
+  }
+  BOOST_TEST_REQUIRE(!std::filesystem::exists(journal_path()));
+  const std::size_t compacted_invocations = get_invocations(db_path);
+
+  // Simulate a process that has crashed during compaction after writing
+  // the snapshot, but before removing the journal. The journal is already
+  // contained in the snapshot, and must not be applied a second time.
+  std::filesystem::rename(journal_copy, journal_path());
+  BOOST_CHECK_EQUAL(get_invocations(db_path), compacted_invocations);
+  {
+    common::db::appdb db{db_path};
+    add_invocations(db, 1);
+  }
+  BOOST_CHECK_EQUAL(get_invocations(db_path), compacted_invocations + 1);
+}
+
+BOOST_AUTO_TEST_CASE(torn_journal_record_is_discarded) {
+  {
+    common::db::appdb db{db_path};
+    add_invocations(db, 10);
+  }
+  {
+    // Record size prefix without payload, as left behind by a process
+    // that was interrupted while appending.
+    std::ofstream journal{journal_path(),
+                          std::ios::out | std::ios::binary | std::ios::app};
+    uint64_t record_size = 1000;
+    journal.write(reinterpret_cast<const char *>(&record_size),
+                  sizeof(record_size));
+    journal.write("garbage", 7);
+  }
+  BOOST_CHECK_EQUAL(get_invocations(db_path), 10);
+  {
+    common::db::appdb db{db_path};
+    add_invocations(db, 5);
+  }
+  // The new record must not be hidden behind the torn one
+  BOOST_CHECK_EQUAL(get_invocations(db_path), 15);
+}
+
+BOOST_AUTO_TEST_CASE(transfer_links_use_latest_measurement) {
+  for (uint64_t bandwidth : {100, 200}) {
+    common::db::appdb db{db_path};
+    db.read_write_access([&](common::db::appdb_data &data) {
+      data.transfer_links["a->b"].bytes_per_sec = bandwidth;
+    });
+  }
+  common::db::appdb db{db_path};
+  uint64_t bandwidth =
+      db.read_access([](const common::db::appdb_data &data) {
+        auto it = data.transfer_links.find("a->b");
+        return it == data.transfer_links.end() ? uint64_t{0}
+                                               : it->second.bytes_per_sec;
+      });
+  BOOST_CHECK_EQUAL(bandwidth, 200);
+}
+
+BOOST_AUTO_TEST_CASE(clear) {
+  {
+    common::db::appdb db{db_path};
+    add_invocations(db, 1);
+  }
+  common::db::appdb::clear(db_path);
+  BOOST_CHECK(!std::filesystem::exists(journal_path()));
+  BOOST_CHECK_EQUAL(get_invocations(db_path), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
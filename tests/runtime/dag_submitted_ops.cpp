@@ -0,0 +1,66 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <sycl/sycl.hpp>
+#include <hipSYCL/runtime/application.hpp>
+#include <hipSYCL/runtime/dag_manager.hpp>
+#include <hipSYCL/runtime/runtime.hpp>
+
+namespace rt = hipsycl::rt;
+
+BOOST_FIXTURE_TEST_SUITE(dag_submitted_ops, reset_device_fixture)
+
+// In-order queues that are created after others have been destroyed might
+// reuse their addresses. Their nodes must not be considered complete
+// based on what has been completed on the destroyed queue.
+BOOST_AUTO_TEST_CASE(recreated_inorder_queues) {
+  rt::runtime_keep_alive_token rt;
+
+  constexpr int num_iterations = 64;
+  std::vector<std::atomic<int>> done(num_iterations);
+  for(auto& d : done)
+    d.store(0);
+
+  for(int i = 0; i < num_iterations; ++i) {
+    sycl::buffer<int> buff{sycl::range<1>{1}};
+    sycl::queue q{sycl::property::queue::in_order{}};
+    // Alternate between many submissions, which advance the execution
+    // index of the queue, and a single slow one. Accessors prevent
+    // instant submission, so that the nodes are tracked by the runtime.
+    const int num_submissions = (i % 2 == 0) ? 32 : 1;
+    std::atomic<int>* flag = &done[i];
+    for(int j = 0; j < num_submissions; ++j) {
+      const bool is_last = (j == num_submissions - 1);
+      q.submit([&](sycl::handler& cgh) {
+        sycl::accessor acc{buff, cgh, sycl::read_write};
+        cgh.AdaptiveCpp_enqueue_custom_operation([=](sycl::interop_handle&) {
+          (void)acc;
+          if(is_last) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+            flag->store(1);
+          }
+        });
+      });
+    }
+    rt.get()->dag().flush_and_gc();
+    rt.get()->dag().wait();
+    BOOST_CHECK_EQUAL(flag->load(), 1);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
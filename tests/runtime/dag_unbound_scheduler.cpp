@@ -0,0 +1,157 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <hipSYCL/runtime/dag_node.hpp>
+#include <hipSYCL/runtime/dag_unbound_scheduler.hpp>
+#include <hipSYCL/runtime/event.hpp>
+#include <hipSYCL/runtime/instrumentation.hpp>
+#include <hipSYCL/runtime/operations.hpp>
+
+namespace rt = hipsycl::rt;
+
+namespace {
+
+const char* short_kernel = "short_kernel";
+const char* long_kernel = "long_kernel";
+
+const rt::device_id first_device{
+    rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+    0};
+const rt::device_id second_device{
+    rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+    1};
+
+template <class Instr> class test_timestamp : public Instr {
+public:
+  test_timestamp(rt::profiler_clock::time_point t) : _time{t} {}
+
+  rt::profiler_clock::time_point get_time_point() const override {
+    return _time;
+  }
+
+  void wait() const override {}
+
+private:
+  rt::profiler_clock::time_point _time;
+};
+
+class completed_event : public rt::dag_node_event {
+public:
+  bool is_complete() const override { return true; }
+  void wait() override {}
+};
+
+rt::dag_node_ptr make_kernel_node(const char* kernel_name) {
+  return rt::make_dag_node(
+      rt::execution_hints{}, rt::node_list_t{},
+      std::make_unique<rt::kernel_operation>(
+          kernel_name, rt::kernel_launcher({}, {}),
+          rt::requirements_list{nullptr}),
+      nullptr);
+}
+
+// Runs the kernel on the device with the given measured runtime. The node
+// needs to be kept alive until the scheduler has observed its completion.
+rt::dag_node_ptr run_kernel(rt::dag_unbound_scheduler &scheduler,
+                            const rt::device_id &dev, const char *kernel_name,
+                            double seconds) {
+  auto node = make_kernel_node(kernel_name);
+  BOOST_CHECK(scheduler.place(node, {dev}) == dev);
+
+  auto start = rt::profiler_clock::now();
+  auto finish = start + std::chrono::duration_cast<rt::profiler_clock::duration>(
+                            std::chrono::duration<double>{seconds});
+  auto &instrs = node->get_operation()->get_instrumentations();
+  instrs.add_instrumentation<rt::instrumentations::execution_start_timestamp>(
+      std::make_shared<
+          test_timestamp<rt::instrumentations::execution_start_timestamp>>(
+          start));
+  instrs.add_instrumentation<rt::instrumentations::execution_finish_timestamp>(
+      std::make_shared<
+          test_timestamp<rt::instrumentations::execution_finish_timestamp>>(
+          finish));
+  instrs.mark_set_complete();
+  node->mark_submitted(std::make_shared<completed_event>());
+  return node;
+}
+
+rt::device_id place_kernel(rt::dag_unbound_scheduler &scheduler,
+                           const char *kernel_name) {
+  return scheduler.place(make_kernel_node(kernel_name),
+                         {first_device, second_device});
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(dag_unbound_scheduler)
+
+// Kernels are placed on the device where they have run fastest, even if
+// other kernels run faster on another device.
+BOOST_AUTO_TEST_CASE(placement_by_kernel_runtime) {
+  rt::dag_unbound_scheduler scheduler{nullptr};
+
+  std::vector<rt::dag_node_ptr> completed_nodes{
+      run_kernel(scheduler, first_device, short_kernel, 1.e-3),
+      run_kernel(scheduler, second_device, short_kernel, 2.e-3),
+      run_kernel(scheduler, first_device, long_kernel, 1.0),
+      run_kernel(scheduler, second_device, long_kernel, 0.5)};
+
+  BOOST_CHECK(place_kernel(scheduler, short_kernel) == first_device);
+  BOOST_CHECK(place_kernel(scheduler, long_kernel) == second_device);
+  completed_nodes.clear();
+  // Measurements persist after the nodes are gone
+  BOOST_CHECK(place_kernel(scheduler, short_kernel) == first_device);
+  BOOST_CHECK(place_kernel(scheduler, long_kernel) == second_device);
+}
+
+BOOST_AUTO_TEST_CASE(placement_by_outstanding_work) {
+  rt::dag_unbound_scheduler scheduler{nullptr};
+
+  std::vector<rt::dag_node_ptr> completed_nodes{
+      run_kernel(scheduler, first_device, long_kernel, 1.0),
+      run_kernel(scheduler, second_device, long_kernel, 0.5)};
+  BOOST_CHECK(place_kernel(scheduler, long_kernel) == second_device);
+
+  // Work that is queued on the faster device outweighs its advantage
+  std::vector<rt::dag_node_ptr> outstanding_nodes;
+  for(int i = 0; i < 3; ++i) {
+    outstanding_nodes.push_back(make_kernel_node(long_kernel));
+    scheduler.place(outstanding_nodes.back(), {second_device});
+  }
+  BOOST_CHECK(place_kernel(scheduler, long_kernel) == first_device);
+
+  // The scheduler does not keep outstanding nodes alive, and does not
+  // consider them anymore once they have been destroyed.
+  std::weak_ptr<rt::dag_node> outstanding_node = outstanding_nodes.front();
+  outstanding_nodes.clear();
+  BOOST_CHECK(outstanding_node.expired());
+  BOOST_CHECK(place_kernel(scheduler, long_kernel) == second_device);
+}
+
+// Kernels without measurements on a device are assumed to take as long as
+// on the devices where they have been measured.
+BOOST_AUTO_TEST_CASE(placement_of_unmeasured_kernel) {
+  rt::dag_unbound_scheduler scheduler{nullptr};
+
+  std::vector<rt::dag_node_ptr> nodes{
+      run_kernel(scheduler, first_device, long_kernel, 1.0)};
+  nodes.push_back(make_kernel_node(long_kernel));
+  scheduler.place(nodes.back(), {second_device});
+  BOOST_CHECK(place_kernel(scheduler, long_kernel) == first_device);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
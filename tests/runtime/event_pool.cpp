@@ -0,0 +1,193 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <hipSYCL/runtime/event_pool.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+// Hands out increasing ids as events, and counts how many are alive.
+struct test_event_factory {
+  using event_type = std::size_t;
+
+  struct counters {
+    std::atomic<std::size_t> num_created = 0;
+    std::atomic<std::size_t> num_destroyed = 0;
+    std::atomic<std::size_t> num_errors = 0;
+
+    std::size_t num_alive() const {
+      return num_created.load() - num_destroyed.load();
+    }
+  };
+
+  rt::result create(event_type& out) {
+    out = ++c->num_created;
+    return rt::make_success();
+  }
+
+  // Might be called concurrently, so errors are only counted
+  rt::result destroy(event_type evt) {
+    if(evt == event_type{})
+      ++c->num_errors;
+    ++c->num_destroyed;
+    return rt::make_success();
+  }
+
+  counters* c;
+};
+
+using test_event_pool = rt::event_pool<test_event_factory>;
+
+}
+
+BOOST_AUTO_TEST_SUITE(event_pool)
+
+BOOST_AUTO_TEST_CASE(reuse) {
+  test_event_factory::counters c;
+  {
+    test_event_pool pool{test_event_factory{&c}, 64};
+    std::size_t first = 0;
+    BOOST_CHECK(pool.obtain_event(first).is_success());
+    pool.release_event(first);
+
+    std::size_t second = 0;
+    BOOST_CHECK(pool.obtain_event(second).is_success());
+    BOOST_CHECK_EQUAL(second, first);
+    BOOST_CHECK_EQUAL(c.num_created.load(), 1);
+    pool.release_event(second);
+
+    auto stats = pool.get_statistics();
+    BOOST_CHECK_EQUAL(stats.misses, 1);
+    BOOST_CHECK_EQUAL(stats.magazine_hits + stats.depot_hits, 1);
+    BOOST_CHECK_EQUAL(stats.num_discarded, 0);
+  }
+  // Cached events are destroyed with the pool
+  BOOST_CHECK_EQUAL(c.num_alive(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(max_size_under_concurrent_release) {
+  constexpr std::size_t max_size = 100;
+  constexpr std::size_t num_threads = 8;
+  constexpr std::size_t events_per_thread = 50;
+
+  test_event_factory::counters c;
+  {
+    test_event_pool pool{test_event_factory{&c}, max_size};
+
+    std::vector<std::vector<std::size_t>> events(num_threads);
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        for(std::size_t i = 0; i < events_per_thread; ++i) {
+          std::size_t evt = 0;
+          if(!pool.obtain_event(evt).is_success())
+            ++c.num_errors;
+          events[t].push_back(evt);
+        }
+      });
+    }
+    for(auto& t : threads)
+      t.join();
+    std::set<std::size_t> distinct;
+    for(const auto& e : events)
+      distinct.insert(e.begin(), e.end());
+    BOOST_CHECK_EQUAL(distinct.size(), num_threads * events_per_thread);
+
+    // Each thread returns the events obtained by another one
+    threads.clear();
+    std::atomic<bool> start = false;
+    for(std::size_t t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() {
+        while(!start.load())
+          ;
+        for(std::size_t evt : events[(t + 1) % num_threads])
+          pool.release_event(evt);
+      });
+    }
+    start = true;
+    for(auto& t : threads)
+      t.join();
+
+    BOOST_CHECK_LE(c.num_alive(), max_size);
+    BOOST_CHECK_EQUAL(pool.get_statistics().num_discarded,
+                      c.num_destroyed.load());
+
+    // Events in the pool are handed out again without creating new ones
+    std::size_t num_created = c.num_created.load();
+    std::size_t num_pooled = c.num_alive();
+    std::set<std::size_t> reobtained;
+    for(std::size_t i = 0; i < num_pooled; ++i) {
+      std::size_t evt = 0;
+      BOOST_CHECK(pool.obtain_event(evt).is_success());
+      reobtained.insert(evt);
+    }
+    BOOST_CHECK_EQUAL(reobtained.size(), num_pooled);
+    BOOST_CHECK_EQUAL(c.num_created.load(), num_created);
+    for(std::size_t evt : reobtained)
+      pool.release_event(evt);
+  }
+  BOOST_CHECK_EQUAL(c.num_alive(), 0);
+  BOOST_CHECK_EQUAL(c.num_errors.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(preallocation) {
+  constexpr std::size_t max_size = 64;
+  test_event_factory::counters c;
+  {
+    test_event_pool pool{test_event_factory{&c}, max_size};
+    BOOST_CHECK(pool.preallocate(10).is_success());
+    BOOST_CHECK_EQUAL(c.num_created.load(), 10);
+
+    std::vector<std::size_t> events(10);
+    for(auto& evt : events)
+      BOOST_CHECK(pool.obtain_event(evt).is_success());
+    BOOST_CHECK_EQUAL(c.num_created.load(), 10);
+    BOOST_CHECK_EQUAL(pool.get_statistics().misses, 0);
+    for(auto evt : events)
+      pool.release_event(evt);
+
+    // Preallocation is bounded by the capacity of the pool
+    BOOST_CHECK(pool.preallocate(1000).is_success());
+    BOOST_CHECK_LE(c.num_alive(), max_size);
+  }
+  BOOST_CHECK_EQUAL(c.num_alive(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(no_pooling) {
+  test_event_factory::counters c;
+  {
+    test_event_pool pool{test_event_factory{&c}, 0};
+    BOOST_CHECK(pool.preallocate(5).is_success());
+    BOOST_CHECK_EQUAL(c.num_alive(), 0);
+
+    std::size_t evt = 0;
+    BOOST_CHECK(pool.obtain_event(evt).is_success());
+    pool.release_event(evt);
+    BOOST_CHECK_EQUAL(c.num_alive(), 0);
+
+    BOOST_CHECK(pool.obtain_event(evt).is_success());
+    pool.release_event(evt);
+    BOOST_CHECK_EQUAL(pool.get_statistics().misses, 2);
+    BOOST_CHECK_EQUAL(pool.get_statistics().num_discarded, 2);
+  }
+  BOOST_CHECK_EQUAL(c.num_alive(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
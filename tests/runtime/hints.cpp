@@ -0,0 +1,171 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <hipSYCL/runtime/hints.hpp>
+
+using namespace hipsycl;
+namespace hints = hipsycl::rt::hints;
+
+namespace {
+
+rt::device_id make_device(int id) {
+  return rt::device_id{
+      rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+      id};
+}
+
+// Only used as distinct pointer values, never dereferenced
+rt::backend_executor *make_executor(std::uintptr_t id) {
+  return reinterpret_cast<rt::backend_executor *>(id * 64);
+}
+
+template<class... Hints>
+std::size_t count_hints(const rt::execution_hints& h, hints::hint_list<Hints...>) {
+  return (std::size_t{h.has_hint<Hints>()} + ...);
+}
+
+std::size_t count_hints(const rt::execution_hints& h) {
+  return count_hints(h, hints::all_hints{});
+}
+
+// Hints with data, as set by set_all_hints()
+void check_all_hints(const rt::execution_hints &h, int seed) {
+  BOOST_TEST_REQUIRE(h.get_hint<hints::bind_to_device>());
+  BOOST_CHECK(h.get_hint<hints::bind_to_device>()->get_device_id() ==
+              make_device(seed));
+
+  BOOST_TEST_REQUIRE(h.get_hint<hints::bind_to_device_group>());
+  const auto &devs = h.get_hint<hints::bind_to_device_group>()->get_devices();
+  BOOST_REQUIRE_EQUAL(devs.size(), 2);
+  BOOST_CHECK(devs[0] == make_device(seed));
+  BOOST_CHECK(devs[1] == make_device(seed + 1));
+
+  BOOST_TEST_REQUIRE(h.get_hint<hints::prefer_execution_lane>());
+  BOOST_CHECK_EQUAL(h.get_hint<hints::prefer_execution_lane>()->get_lane_id(),
+                    seed);
+
+  BOOST_TEST_REQUIRE(h.get_hint<hints::node_group>());
+  BOOST_CHECK_EQUAL(h.get_hint<hints::node_group>()->get_id(), seed);
+
+  BOOST_TEST_REQUIRE(h.get_hint<hints::prefer_executor>());
+  BOOST_CHECK_EQUAL(h.get_hint<hints::prefer_executor>()->get_executor(),
+                    make_executor(seed));
+}
+
+void set_all_hints(rt::execution_hints &h, int seed) {
+  h.set_hint(hints::bind_to_device{make_device(seed)});
+  h.set_hint(hints::bind_to_device_group{
+      std::vector<rt::device_id>{make_device(seed), make_device(seed + 1)}});
+  h.set_hint(hints::prefer_execution_lane{static_cast<std::size_t>(seed)});
+  h.set_hint(hints::node_group{static_cast<std::size_t>(seed)});
+  h.set_hint(hints::prefer_executor{make_executor(seed)});
+  h.set_hint(hints::coarse_grained_synchronization{});
+  h.set_hint(hints::instant_execution{});
+  h.set_hint(hints::request_instrumentation_submission_timestamp{});
+  h.set_hint(hints::request_instrumentation_start_timestamp{});
+  h.set_hint(hints::request_instrumentation_finish_timestamp{});
+}
+
+// Setting one hint must neither affect the presence of others, nor
+// depend on them.
+template<class Hint>
+void check_single_hint(const Hint& hint) {
+  rt::execution_hints h;
+  BOOST_CHECK(!h.has_hint<Hint>());
+  BOOST_CHECK(!h.get_hint<Hint>());
+
+  h.set_hint(hint);
+  BOOST_CHECK(h.has_hint<Hint>());
+  BOOST_CHECK(h.get_hint<Hint>());
+  BOOST_CHECK_EQUAL(count_hints(h), 1);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(execution_hints)
+
+BOOST_AUTO_TEST_CASE(empty) {
+  rt::execution_hints h;
+  BOOST_CHECK_EQUAL(count_hints(h), 0);
+  BOOST_CHECK(!h.get_hint<hints::bind_to_device>());
+  BOOST_CHECK(!h.get_hint<hints::instant_execution>());
+}
+
+BOOST_AUTO_TEST_CASE(set_each_hint) {
+  check_single_hint(hints::bind_to_device{make_device(1)});
+  check_single_hint(hints::bind_to_device_group{{make_device(1)}});
+  check_single_hint(hints::prefer_execution_lane{1});
+  check_single_hint(hints::node_group{1});
+  check_single_hint(hints::coarse_grained_synchronization{});
+  check_single_hint(hints::prefer_executor{make_executor(1)});
+  check_single_hint(hints::instant_execution{});
+  check_single_hint(hints::request_instrumentation_submission_timestamp{});
+  check_single_hint(hints::request_instrumentation_start_timestamp{});
+  check_single_hint(hints::request_instrumentation_finish_timestamp{});
+
+  rt::execution_hints h;
+  set_all_hints(h, 3);
+  BOOST_CHECK_EQUAL(count_hints(h), hints::all_hints::size);
+  check_all_hints(h, 3);
+}
+
+BOOST_AUTO_TEST_CASE(overwrite) {
+  rt::execution_hints h;
+  set_all_hints(h, 3);
+  set_all_hints(h, 7);
+  BOOST_CHECK_EQUAL(count_hints(h), hints::all_hints::size);
+  check_all_hints(h, 7);
+
+  // Hints passed as lvalues
+  hints::node_group group{11};
+  h.set_hint(group);
+  BOOST_CHECK_EQUAL(h.get_hint<hints::node_group>()->get_id(), 11);
+  const hints::bind_to_device binding{make_device(12)};
+  h.set_hint(binding);
+  BOOST_CHECK(h.get_hint<hints::bind_to_device>()->get_device_id() ==
+              make_device(12));
+}
+
+BOOST_AUTO_TEST_CASE(copy) {
+  rt::execution_hints original;
+  set_all_hints(original, 3);
+
+  rt::execution_hints copy = original;
+  check_all_hints(copy, 3);
+  BOOST_CHECK_EQUAL(count_hints(copy), hints::all_hints::size);
+
+  // Copies are independent of each other
+  set_all_hints(copy, 5);
+  check_all_hints(copy, 5);
+  check_all_hints(original, 3);
+
+  rt::execution_hints assigned;
+  assigned.set_hint(hints::node_group{1});
+  assigned = original;
+  check_all_hints(assigned, 3);
+
+  // Copying a partially filled set must not make other hints present
+  rt::execution_hints partial;
+  partial.set_hint(hints::prefer_execution_lane{2});
+  partial.set_hint(hints::instant_execution{});
+  rt::execution_hints partial_copy = partial;
+  BOOST_CHECK_EQUAL(count_hints(partial_copy), 2);
+  BOOST_CHECK(partial_copy.has_hint<hints::instant_execution>());
+  BOOST_CHECK_EQUAL(
+      partial_copy.get_hint<hints::prefer_execution_lane>()->get_lane_id(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
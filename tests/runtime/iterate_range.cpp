@@ -0,0 +1,132 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <hipSYCL/glue/generic/host/iterate_range.hpp>
+
+using namespace hipsycl;
+using hipsycl::glue::host::tile_order;
+
+namespace {
+
+#ifdef _OPENMP
+constexpr int num_threads = 4;
+#else
+constexpr int num_threads = 1;
+#endif
+
+template <int Dim> std::size_t linear_id(sycl::id<Dim> idx, sycl::range<Dim> r) {
+  std::size_t result = 0;
+  for (int i = 0; i < Dim; ++i)
+    result = result * r[i] + idx[i];
+  return result;
+}
+
+// Iterates the range in tiles, and checks that every item is visited
+// exactly once. Returns the number of items processed by each thread.
+template <int Dim>
+std::vector<std::size_t> check_tiled_iteration(sycl::id<Dim> offset,
+                                               sycl::range<Dim> r,
+                                               sycl::range<Dim> tile_size,
+                                               tile_order order) {
+  std::vector<std::atomic<int>> visits(r.size());
+  for (auto &v : visits)
+    v.store(0);
+  std::atomic<std::size_t> num_out_of_range = 0;
+  std::vector<std::size_t> items_per_thread(num_threads, 0);
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    std::size_t num_items = 0;
+    glue::host::iterate_range_tiled_omp_for(
+        offset, r, tile_size, order, [&](sycl::id<Dim> idx) {
+          ++num_items;
+          for (int i = 0; i < Dim; ++i) {
+            if (idx[i] < offset[i] || idx[i] >= offset[i] + r[i]) {
+              ++num_out_of_range;
+              return;
+            }
+          }
+          ++visits[linear_id(idx - offset, r)];
+        });
+#ifdef _OPENMP
+    items_per_thread[omp_get_thread_num()] = num_items;
+#else
+    items_per_thread[0] = num_items;
+#endif
+  }
+
+  BOOST_CHECK_EQUAL(num_out_of_range.load(), 0);
+  std::size_t num_wrong_visits = 0;
+  for (const auto &v : visits)
+    if (v.load() != 1)
+      ++num_wrong_visits;
+  BOOST_CHECK_EQUAL(num_wrong_visits, 0);
+  return items_per_thread;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(iterate_range)
+
+BOOST_AUTO_TEST_CASE(tiled_2d_visits_all_items_once) {
+  for (auto order : {tile_order::row_major, tile_order::morton}) {
+    for (auto offset : {sycl::id<2>{0, 0}, sycl::id<2>{3, 17}}) {
+      check_tiled_iteration(offset, sycl::range<2>{100, 37},
+                            sycl::range<2>{8, 16}, order);
+      check_tiled_iteration(offset, sycl::range<2>{1, 1000},
+                            sycl::range<2>{1, 128}, order);
+      check_tiled_iteration(offset, sycl::range<2>{64, 64},
+                            sycl::range<2>{64, 64}, order);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(tiled_3d_visits_all_items_once) {
+  for (auto order : {tile_order::row_major, tile_order::morton}) {
+    for (auto offset : {sycl::id<3>{0, 0, 0}, sycl::id<3>{1, 5, 9}}) {
+      check_tiled_iteration(offset, sycl::range<3>{20, 19, 33},
+                            sycl::range<3>{4, 3, 8}, order);
+      check_tiled_iteration(offset, sycl::range<3>{9, 1, 70},
+                            sycl::range<3>{2, 1, 64}, order);
+    }
+  }
+}
+
+// Tiles in Morton order are grouped into blocks that may extend beyond
+// the range; threads must still receive similar numbers of tiles.
+BOOST_AUTO_TEST_CASE(tiled_morton_is_balanced) {
+  const sycl::range<3> tile_size{2, 2, 2};
+  auto items_per_thread =
+      check_tiled_iteration(sycl::id<3>{}, sycl::range<3>{10, 10, 10},
+                            tile_size, tile_order::morton);
+  auto [min, max] =
+      std::minmax_element(items_per_thread.begin(), items_per_thread.end());
+  BOOST_CHECK_LE(*max - *min, tile_size.size());
+
+  const sycl::range<2> tile_size_2d{4, 4};
+  items_per_thread =
+      check_tiled_iteration(sycl::id<2>{}, sycl::range<2>{36, 36},
+                            tile_size_2d, tile_order::morton);
+  auto [min_2d, max_2d] =
+      std::minmax_element(items_per_thread.begin(), items_per_thread.end());
+  BOOST_CHECK_LE(*max_2d - *min_2d, tile_size_2d.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,217 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <hipSYCL/runtime/kernel_cache_archive.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+using binary_id = rt::kernel_cache_archive::binary_id;
+
+// Provides a fresh archive path in the temporary directory, and removes
+// all files belonging to the archive afterwards.
+struct archive_fixture {
+  archive_fixture() {
+    path = (std::filesystem::temp_directory_path() /
+            ("acpp-kernel-archive-test-" + std::to_string(std::random_device{}())))
+               .string();
+  }
+
+  ~archive_fixture() {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(path + ".lock", ec);
+  }
+
+  std::string path;
+};
+
+binary_id make_id(uint64_t i) { return binary_id{i, ~i}; }
+
+std::string make_binary(uint64_t i, std::size_t size) {
+  std::string result(size, '\0');
+  for (std::size_t j = 0; j < size; ++j)
+    result[j] = static_cast<char>('a' + (i + j) % 26);
+  return result;
+}
+
+bool is_stored(rt::kernel_cache_archive &archive, uint64_t i,
+               std::size_t size) {
+  std::string data;
+  return archive.lookup(make_id(i), data) && data == make_binary(i, size);
+}
+
+std::vector<char> read_file(const std::string &path) {
+  std::ifstream file{path, std::ios::in | std::ios::binary};
+  return std::vector<char>{std::istreambuf_iterator<char>{file},
+                           std::istreambuf_iterator<char>{}};
+}
+
+void write_file(const std::string &path, const std::vector<char> &contents) {
+  std::ofstream file{path, std::ios::out | std::ios::binary | std::ios::trunc};
+  file.write(contents.data(), contents.size());
+}
+
+// Archive header, followed by record headers of 5 words
+constexpr std::size_t archive_header_size = 8;
+constexpr std::size_t record_header_size = 5 * sizeof(uint64_t);
+
+std::size_t get_record_size(std::size_t payload_size) {
+  return record_header_size + ((payload_size + 1 + 7) & ~std::size_t{7});
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(kernel_cache_archive, archive_fixture)
+
+BOOST_AUTO_TEST_CASE(store_and_lookup_across_reopen) {
+  {
+    rt::kernel_cache_archive archive{path, 0, {}};
+    for (uint64_t i = 0; i < 16; ++i)
+      BOOST_CHECK(archive.store(make_id(i), make_binary(i, 100 + i)));
+    BOOST_CHECK(archive.contains(make_id(3)));
+    BOOST_CHECK(!archive.contains(make_id(100)));
+    BOOST_CHECK(is_stored(archive, 3, 103));
+    // Storing an existing binary again does not append it
+    auto size = std::filesystem::file_size(path);
+    BOOST_CHECK(archive.store(make_id(3), make_binary(3, 103)));
+    BOOST_CHECK_EQUAL(std::filesystem::file_size(path), size);
+  }
+  rt::kernel_cache_archive archive{path, 0, {}};
+  for (uint64_t i = 0; i < 16; ++i)
+    BOOST_CHECK(is_stored(archive, i, 100 + i));
+  std::string data;
+  BOOST_CHECK(!archive.lookup(make_id(16), data));
+}
+
+// Sharing archives between instances and compaction require mmap and flock
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(concurrent_instances) {
+  rt::kernel_cache_archive first{path, 0, {}};
+  rt::kernel_cache_archive second{path, 0, {}};
+  BOOST_CHECK(first.store(make_id(1), make_binary(1, 10)));
+  BOOST_CHECK(second.store(make_id(2), make_binary(2, 20)));
+  // Both see records appended by the other one
+  BOOST_CHECK(is_stored(first, 2, 20));
+  BOOST_CHECK(is_stored(second, 1, 10));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(torn_record_is_truncated) {
+  {
+    rt::kernel_cache_archive archive{path, 0, {}};
+    BOOST_CHECK(archive.store(make_id(1), make_binary(1, 50)));
+  }
+  // Simulate a process that was interrupted while appending a record
+  auto contents = read_file(path);
+  const std::size_t complete_size = contents.size();
+  contents.insert(contents.end(), record_header_size / 2, 'x');
+  write_file(path, contents);
+
+  {
+    rt::kernel_cache_archive archive{path, 0, {}};
+    BOOST_CHECK(is_stored(archive, 1, 50));
+    BOOST_CHECK(archive.store(make_id(2), make_binary(2, 60)));
+  }
+  // The torn record is replaced by the new one
+  BOOST_CHECK_EQUAL(std::filesystem::file_size(path),
+                    complete_size + get_record_size(60));
+  rt::kernel_cache_archive archive{path, 0, {}};
+  BOOST_CHECK(is_stored(archive, 1, 50));
+  BOOST_CHECK(is_stored(archive, 2, 60));
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_record_is_rejected) {
+  {
+    rt::kernel_cache_archive archive{path, 0, {}};
+    for (uint64_t i = 0; i < 3; ++i)
+      BOOST_CHECK(archive.store(make_id(i), make_binary(i, 30)));
+  }
+  // Modify the payload size of the second record, which no longer
+  // matches its header hash.
+  auto contents = read_file(path);
+  std::size_t second_record = archive_header_size + get_record_size(30);
+  contents[second_record + 3 * sizeof(uint64_t)] ^= 0x10;
+  write_file(path, contents);
+
+  rt::kernel_cache_archive archive{path, 0, {}};
+  BOOST_CHECK(is_stored(archive, 0, 30));
+  // Records from the corrupted one onwards are unreachable
+  BOOST_CHECK(!archive.contains(make_id(1)));
+  BOOST_CHECK(!archive.contains(make_id(2)));
+}
+
+BOOST_AUTO_TEST_CASE(bad_magic_resets_archive) {
+  write_file(path, std::vector<char>(64, 'x'));
+  {
+    rt::kernel_cache_archive archive{path, 0, {}};
+    BOOST_CHECK(!archive.contains(make_id(0)));
+    BOOST_CHECK(archive.store(make_id(0), make_binary(0, 10)));
+  }
+  rt::kernel_cache_archive archive{path, 0, {}};
+  BOOST_CHECK(is_stored(archive, 0, 10));
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(compaction_keeps_recent_binaries) {
+  constexpr std::size_t binary_size = 1000;
+  constexpr uint64_t num_binaries = 20;
+  // Higher ids have been used more recently
+  auto recency = [](const binary_id &id) { return id[0]; };
+
+  {
+    rt::kernel_cache_archive archive{path, 0, recency};
+    for (uint64_t i = 0; i < num_binaries; ++i)
+      BOOST_CHECK(archive.store(make_id(i), make_binary(i, binary_size)));
+
+    const std::size_t num_retained = 5;
+    archive.compact(archive_header_size +
+                    num_retained * get_record_size(binary_size));
+    BOOST_CHECK_EQUAL(std::filesystem::file_size(path),
+                      archive_header_size +
+                          num_retained * get_record_size(binary_size));
+    for (uint64_t i = 0; i < num_binaries; ++i)
+      BOOST_CHECK_EQUAL(archive.contains(make_id(i)),
+                        i >= num_binaries - num_retained);
+    for (uint64_t i = num_binaries - num_retained; i < num_binaries; ++i)
+      BOOST_CHECK(is_stored(archive, i, binary_size));
+  }
+  rt::kernel_cache_archive archive{path, 0, recency};
+  for (uint64_t i = 0; i < num_binaries; ++i)
+    BOOST_CHECK_EQUAL(archive.contains(make_id(i)), i >= num_binaries - 5);
+}
+
+BOOST_AUTO_TEST_CASE(size_limit_triggers_compaction) {
+  constexpr std::size_t binary_size = 1000;
+  const std::size_t max_size = 10 * get_record_size(binary_size);
+  auto recency = [](const binary_id &id) { return id[0]; };
+
+  rt::kernel_cache_archive archive{path, max_size, recency};
+  for (uint64_t i = 0; i < 40; ++i) {
+    BOOST_CHECK(archive.store(make_id(i), make_binary(i, binary_size)));
+    BOOST_CHECK_LE(std::filesystem::file_size(path), max_size);
+  }
+  // The most recent binary always survives
+  BOOST_CHECK(is_stored(archive, 39, binary_size));
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
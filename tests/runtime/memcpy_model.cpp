@@ -0,0 +1,92 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <vector>
+
+#include <hipSYCL/runtime/application.hpp>
+#include <hipSYCL/runtime/hw_model/memcpy.hpp>
+#include <hipSYCL/runtime/settings.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+rt::device_id make_device(rt::hardware_platform hw, rt::api_platform api,
+                          int id) {
+  return rt::device_id{rt::backend_descriptor{hw, api}, id};
+}
+
+// Checks that the parts cover the extent exactly once along the
+// outermost dimension larger than one.
+void check_parts_cover_region(
+    const std::vector<rt::memcpy_model::transfer_part> &parts,
+    std::size_t num_sources, rt::id<3> offset, rt::range<3> extent) {
+  BOOST_TEST_REQUIRE(!parts.empty());
+  std::size_t next = offset[0];
+  for (const auto &part : parts) {
+    BOOST_CHECK_LT(part.source_index, num_sources);
+    BOOST_CHECK_EQUAL(part.offset[0], next);
+    BOOST_CHECK_EQUAL(part.offset[1], offset[1]);
+    BOOST_CHECK_EQUAL(part.offset[2], offset[2]);
+    BOOST_CHECK_EQUAL(part.extent[1], extent[1]);
+    BOOST_CHECK_EQUAL(part.extent[2], extent[2]);
+    BOOST_CHECK_GT(part.extent[0], 0);
+    next += part.extent[0];
+  }
+  BOOST_CHECK_EQUAL(next, offset[0] + extent[0]);
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(memcpy_model, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(calibration_is_disabled_by_default) {
+  BOOST_CHECK(!rt::application::get_settings()
+                   .get<rt::setting::memcpy_calibration>());
+}
+
+// Without calibration, splitting transfers must not submit anything, and
+// can therefore run without runtime and backends.
+BOOST_AUTO_TEST_CASE(split_transfer_uses_estimates) {
+  if (rt::application::get_settings().get<rt::setting::memcpy_calibration>())
+    return;
+
+  rt::memcpy_model model{nullptr};
+
+  auto host = make_device(rt::hardware_platform::cpu, rt::api_platform::omp, 0);
+  auto gpu0 = make_device(rt::hardware_platform::cuda, rt::api_platform::cuda, 0);
+  auto gpu1 = make_device(rt::hardware_platform::cuda, rt::api_platform::cuda, 1);
+  auto gpu2 = make_device(rt::hardware_platform::rocm, rt::api_platform::hip, 0);
+
+  BOOST_CHECK(!model.requires_host_staging(gpu0, gpu1));
+  BOOST_CHECK(!model.requires_host_staging(host, gpu2));
+  BOOST_CHECK(model.requires_host_staging(gpu0, gpu2));
+
+  rt::id<3> offset{16, 0, 0};
+  rt::range<3> extent{1024, 32, 32};
+
+  auto single = model.split_transfer(nullptr, {gpu0}, gpu1, offset, extent, 4);
+  BOOST_TEST_REQUIRE(single.size() == 1);
+  BOOST_CHECK_EQUAL(single[0].source_index, 0);
+  check_parts_cover_region(single, 1, offset, extent);
+
+  std::vector<rt::device_id> sources{host, gpu0, gpu2};
+  // Repeated estimates must be consistent, e.g. when links that are
+  // unknown to the app db are cached.
+  for (int i = 0; i < 2; ++i) {
+    auto parts = model.split_transfer(nullptr, sources, gpu1, offset, extent, 4);
+    check_parts_cover_region(parts, sources.size(), offset, extent);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
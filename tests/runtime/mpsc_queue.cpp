@@ -0,0 +1,102 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <hipSYCL/runtime/generic/mpsc_queue.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+// Items encode the producer in the upper and a per-producer sequence number
+// in the lower half.
+constexpr uint64_t make_item(uint64_t producer, uint64_t seq) {
+  return (producer << 32) | seq;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(mpsc_queue)
+
+BOOST_AUTO_TEST_CASE(full_and_empty) {
+  rt::bounded_mpsc_queue<uint64_t, 4> queue;
+  uint64_t item = 0;
+  BOOST_CHECK(!queue.try_pop(item));
+
+  for(uint64_t i = 0; i < 4; ++i) {
+    uint64_t v = i;
+    BOOST_CHECK(queue.try_push(std::move(v)));
+  }
+  uint64_t rejected = 42;
+  BOOST_CHECK(!queue.try_push(std::move(rejected)));
+  BOOST_CHECK_EQUAL(rejected, 42);
+
+  // Elements wrap around the ring in order
+  for(uint64_t i = 0; i < 10; ++i) {
+    BOOST_CHECK(queue.try_pop(item));
+    BOOST_CHECK_EQUAL(item, i);
+    uint64_t v = i + 4;
+    BOOST_CHECK(queue.try_push(std::move(v)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_producers) {
+  constexpr uint64_t num_producers = 8;
+  constexpr uint64_t num_items_per_producer = 100000;
+  // Small enough that producers frequently find the queue full
+  rt::bounded_mpsc_queue<uint64_t, 64> queue;
+
+  std::vector<std::thread> producers;
+  for(uint64_t p = 0; p < num_producers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for(uint64_t i = 0; i < num_items_per_producer; ++i) {
+        uint64_t item = make_item(p, i);
+        while(!queue.try_push(std::move(item)))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  // Every item must arrive exactly once, and in the order in which its
+  // producer pushed it.
+  std::vector<uint64_t> num_received(num_producers, 0);
+  std::size_t num_errors = 0;
+  for(uint64_t received = 0; received < num_producers * num_items_per_producer;) {
+    uint64_t item;
+    if(!queue.try_pop(item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    uint64_t producer = item >> 32;
+    uint64_t seq = item & 0xffffffff;
+    if(producer >= num_producers || seq != num_received[producer])
+      ++num_errors;
+    else
+      ++num_received[producer];
+    ++received;
+  }
+
+  for(auto& t : producers)
+    t.join();
+
+  BOOST_CHECK_EQUAL(num_errors, 0);
+  for(uint64_t p = 0; p < num_producers; ++p)
+    BOOST_CHECK_EQUAL(num_received[p], num_items_per_producer);
+  uint64_t item;
+  BOOST_CHECK(!queue.try_pop(item));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
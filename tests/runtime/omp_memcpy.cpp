@@ -0,0 +1,196 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <hipSYCL/runtime/omp/omp_memcpy.hpp>
+#include <hipSYCL/runtime/omp/omp_work_group_pool.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+constexpr std::size_t mib = 1024 * 1024;
+// Regions of at least this size are processed by multiple workers
+constexpr std::size_t parallel_size = 4 * mib;
+constexpr unsigned char sentinel = 0xcd;
+constexpr std::size_t num_workers = 4;
+
+// Like the engine, uses the L3 cache size as threshold for
+// non-temporal stores.
+std::size_t get_nontemporal_threshold() {
+  std::size_t cache_size = 32 * mib;
+#if !defined(_WIN32) && defined(_SC_LEVEL3_CACHE_SIZE)
+  long l3_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if(l3_size > 0)
+    cache_size = static_cast<std::size_t>(l3_size);
+#endif
+  return cache_size;
+}
+
+struct region_shape {
+  std::size_t row_size;
+  std::size_t num_rows;
+  std::size_t num_surfaces;
+  std::size_t src_row_pitch;
+  std::size_t src_surface_pitch;
+  std::size_t dest_row_pitch;
+  std::size_t dest_surface_pitch;
+  // Offset of the region within the destination allocation, to cover
+  // destinations that are not aligned to pages or vectors.
+  std::size_t dest_offset;
+};
+
+std::vector<char> make_source(std::size_t size) {
+  std::vector<char> result(size);
+  for(std::size_t i = 0; i < size; ++i)
+    result[i] = static_cast<char>(i * 31 + (i >> 12));
+  return result;
+}
+
+// Copies the region with the engine, and compares the entire destination
+// allocation against a row by row copy.
+void check_copy(rt::omp_work_group_pool &pool, const region_shape &shape) {
+  std::vector<char> src = make_source(shape.src_surface_pitch * shape.num_surfaces);
+  const std::size_t dest_size =
+      shape.dest_offset + shape.dest_surface_pitch * shape.num_surfaces;
+  std::vector<char> dest(dest_size, static_cast<char>(sentinel));
+  std::vector<char> expected(dest_size, static_cast<char>(sentinel));
+
+  rt::omp_copy_region region;
+  region.src = src.data();
+  region.dest = dest.data() + shape.dest_offset;
+  region.row_size = shape.row_size;
+  region.num_rows = shape.num_rows;
+  region.num_surfaces = shape.num_surfaces;
+  region.src_row_pitch = shape.src_row_pitch;
+  region.src_surface_pitch = shape.src_surface_pitch;
+  region.dest_row_pitch = shape.dest_row_pitch;
+  region.dest_surface_pitch = shape.dest_surface_pitch;
+  rt::omp_memcpy_engine::copy(pool, region, 0);
+
+  for(std::size_t s = 0; s < shape.num_surfaces; ++s)
+    for(std::size_t r = 0; r < shape.num_rows; ++r)
+      std::memcpy(expected.data() + shape.dest_offset +
+                      s * shape.dest_surface_pitch + r * shape.dest_row_pitch,
+                  src.data() + s * shape.src_surface_pitch +
+                      r * shape.src_row_pitch,
+                  shape.row_size);
+
+  BOOST_CHECK(dest == expected);
+}
+
+void check_fill(rt::omp_work_group_pool &pool, std::size_t size,
+                std::size_t offset) {
+  std::vector<unsigned char> data(offset + size + 64, sentinel);
+  rt::omp_memcpy_engine::fill(pool, data.data() + offset, 0x5a, size, 0);
+
+  std::size_t num_wrong = 0;
+  for(std::size_t i = 0; i < data.size(); ++i) {
+    unsigned char expected = (i >= offset && i < offset + size) ? 0x5a : sentinel;
+    if(data[i] != expected)
+      ++num_wrong;
+  }
+  BOOST_CHECK_EQUAL(num_wrong, 0);
+}
+
+region_shape make_contiguous(std::size_t size, std::size_t dest_offset) {
+  return region_shape{size, 1, 1, size, size, size, size, dest_offset};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(omp_memcpy)
+
+// Rows of at least 1 MiB are split into pieces
+BOOST_AUTO_TEST_CASE(large_rows) {
+  rt::omp_work_group_pool pool{num_workers};
+
+  check_copy(pool, make_contiguous(parallel_size + 12345, 0));
+  check_copy(pool, make_contiguous(parallel_size + 12345, 100));
+  // 2D, pitched source and destination
+  const std::size_t row_size = mib + mib / 2 + 17;
+  check_copy(pool, region_shape{row_size, 4, 1,
+                                row_size + 1000, (row_size + 1000) * 4,
+                                row_size + 3, (row_size + 3) * 4, 5});
+  // 3D with rows of exactly one block
+  check_copy(pool, region_shape{mib, 3, 2,
+                                mib + 64, (mib + 64) * 4,
+                                2 * mib, 2 * mib * 3 + 4096, 4096});
+}
+
+// Smaller rows are distributed in groups
+BOOST_AUTO_TEST_CASE(row_groups) {
+  rt::omp_work_group_pool pool{num_workers};
+
+  // 2D
+  check_copy(pool, region_shape{1000, 6000, 1,
+                                1024, 1024 * 6000,
+                                1001, 1001 * 6000, 7});
+  // 3D, with a partial group of rows at the end
+  check_copy(pool, region_shape{333, 100, 151,
+                                400, 400 * 101,
+                                340, 340 * 100, 3});
+}
+
+// Adjacent rows and surfaces are merged into larger rows
+BOOST_AUTO_TEST_CASE(merged_rows) {
+  rt::omp_work_group_pool pool{num_workers};
+
+  // Rows are contiguous, surfaces are not
+  const std::size_t row_size = 4096;
+  check_copy(pool, region_shape{row_size, 64, 20,
+                                row_size, row_size * 64 + 512,
+                                row_size, row_size * 64 + 100, 11});
+  // Everything is contiguous
+  check_copy(pool, region_shape{row_size, 64, 20,
+                                row_size, row_size * 64,
+                                row_size, row_size * 64, 0});
+  // Rows are contiguous only in the source
+  check_copy(pool, region_shape{row_size, 64, 20,
+                                row_size, row_size * 64,
+                                row_size + 8, (row_size + 8) * 64, 0});
+}
+
+BOOST_AUTO_TEST_CASE(fills) {
+  rt::omp_work_group_pool pool{num_workers};
+
+  check_fill(pool, 1000, 3);
+  check_fill(pool, parallel_size + 12345, 0);
+  check_fill(pool, parallel_size + 12345, 77);
+}
+
+// Beyond the size of the L3 cache, destinations are written with
+// non-temporal stores where supported.
+BOOST_AUTO_TEST_CASE(nontemporal_stores) {
+  const std::size_t size = get_nontemporal_threshold() + mib + 123;
+  if(size > 512 * mib)
+    return;
+
+  rt::omp_work_group_pool pool{num_workers};
+  check_fill(pool, size, 9);
+  check_copy(pool, make_contiguous(size, 9));
+  const std::size_t row_size = mib / 4 + 3;
+  const std::size_t num_rows = size / row_size + 1;
+  check_copy(pool, region_shape{row_size, num_rows, 1,
+                                row_size + 5, (row_size + 5) * num_rows,
+                                row_size + 1, (row_size + 1) * num_rows, 1});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
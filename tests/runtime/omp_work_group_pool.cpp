@@ -0,0 +1,117 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <hipSYCL/runtime/omp/omp_work_group_pool.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+void busy_wait(std::chrono::microseconds duration) {
+  auto end = std::chrono::steady_clock::now() + duration;
+  while(std::chrono::steady_clock::now() < end)
+    ;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(omp_work_group_pool)
+
+BOOST_AUTO_TEST_CASE(all_work_groups_are_processed) {
+  rt::omp_work_group_pool pool;
+
+  for(std::size_t num_groups : {std::size_t{1}, std::size_t{7}, std::size_t{100000}}) {
+    std::vector<std::atomic<int>> visits(num_groups);
+    for(auto& v : visits)
+      v.store(0);
+
+    pool.run(num_groups, [&](std::size_t begin, std::size_t end) {
+      for(std::size_t i = begin; i < end; ++i)
+        ++visits[i];
+    });
+
+    for(std::size_t i = 0; i < num_groups; ++i)
+      BOOST_CHECK_EQUAL(visits[i].load(), 1);
+  }
+}
+
+// A launch of high priority must not share the workers with a
+// long-running launch of lower priority, regardless of how long the
+// latter has already been running.
+BOOST_AUTO_TEST_CASE(high_priority_preempts_long_launch) {
+  using namespace std::chrono_literals;
+  rt::omp_work_group_pool pool;
+  const std::size_t num_workers = pool.get_num_workers();
+  // Timing would be dominated by the scheduling of the operating system
+  if(num_workers < 2 || std::thread::hardware_concurrency() < num_workers)
+    return;
+
+  // Each worker processes its share of the low-priority launch in chunks
+  // of 1/16, here roughly 20ms. That is the latency after which all
+  // workers have moved to the high-priority launch.
+  const std::size_t low_groups_per_worker = 16 * 80;
+  const auto low_group_duration = 250us;
+  // Below the time after which the starved low-priority launch catches
+  // up with the highest priority.
+  const std::size_t high_groups_per_worker = 48;
+  const auto high_group_duration = 1ms;
+  const std::size_t num_high_groups = num_workers * high_groups_per_worker;
+
+  std::atomic<std::size_t> num_started_high_groups = 0;
+  std::atomic<std::size_t> num_low_ranges_during_high = 0;
+
+  std::thread low_priority_submitter{[&]() {
+    pool.run(
+        num_workers * low_groups_per_worker,
+        [&](std::size_t begin, std::size_t end) {
+          std::size_t started = num_started_high_groups.load();
+          if(started > 0 && started < num_high_groups)
+            ++num_low_ranges_during_high;
+          for(std::size_t i = begin; i < end; ++i)
+            busy_wait(low_group_duration);
+        },
+        rt::omp_work_group_pool::lowest_priority);
+  }};
+
+  // Beyond the time after which the low-priority launch would have caught
+  // up with the highest priority, if launches aged while being processed.
+  std::this_thread::sleep_for(
+      -rt::omp_work_group_pool::highest_priority *
+          rt::omp_work_group_pool::aging_interval + 50ms);
+
+  pool.run(
+      num_high_groups,
+      [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+          ++num_started_high_groups;
+          busy_wait(high_group_duration);
+        }
+      },
+      rt::omp_work_group_pool::highest_priority);
+
+  low_priority_submitter.join();
+
+  BOOST_CHECK_EQUAL(num_started_high_groups.load(), num_high_groups);
+  // While the high-priority launch has work left, workers must not start
+  // new chunks of the low-priority launch. Workers only check for launches
+  // of higher priority in between chunks, so one chunk might start while
+  // the high-priority launch is starting up.
+  BOOST_CHECK_LE(num_low_ranges_during_high.load(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,221 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <hipSYCL/std/stdpar/detail/allocation_map.hpp>
+
+using hipsycl::stdpar::slab_allocator;
+
+namespace {
+
+// Hands out slabs from a fixed buffer, and counts them.
+struct test_slab_provider {
+  static constexpr std::size_t num_slabs = 512;
+
+  static void* claim(void* user_data) {
+    auto* self = static_cast<test_slab_provider*>(user_data);
+    std::size_t slab = self->num_claimed_slabs.fetch_add(1);
+    if(slab >= num_slabs)
+      return nullptr;
+    return self->buffer.data() + slab * slab_allocator::slab_size;
+  }
+
+  std::size_t get_slab_index(void* ptr) const {
+    return (static_cast<const char*>(ptr) - buffer.data()) /
+           slab_allocator::slab_size;
+  }
+
+  bool is_in_buffer(void* ptr, std::size_t size) const {
+    const char* p = static_cast<const char*>(ptr);
+    return p >= buffer.data() && p + size <= buffer.data() + buffer.size();
+  }
+
+  std::vector<char> buffer =
+      std::vector<char>(num_slabs * slab_allocator::slab_size);
+  std::atomic<std::size_t> num_claimed_slabs = 0;
+};
+
+// Thread caches are shared by all slab_allocator instances, so all
+// tests need to use the same one.
+struct slab_allocator_fixture {
+  static test_slab_provider& get_provider() {
+    static test_slab_provider provider;
+    return provider;
+  }
+
+  static slab_allocator& get_allocator() {
+    static slab_allocator allocator{&test_slab_provider::claim,
+                                    &get_provider()};
+    return allocator;
+  }
+
+  slab_allocator& allocator = get_allocator();
+  test_slab_provider& provider = get_provider();
+};
+
+// Returns the distance between the closest two of the given objects
+std::size_t get_min_distance(std::vector<void*> objects) {
+  std::sort(objects.begin(), objects.end());
+  std::size_t min_distance = std::numeric_limits<std::size_t>::max();
+  for(std::size_t i = 1; i < objects.size(); ++i)
+    min_distance = std::min(
+        min_distance, static_cast<std::size_t>(static_cast<char*>(objects[i]) -
+                                               static_cast<char*>(objects[i - 1])));
+  return min_distance;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(slab_allocator_tests, slab_allocator_fixture)
+
+BOOST_AUTO_TEST_CASE(size_class_boundaries) {
+  BOOST_CHECK(slab_allocator::is_small(128));
+  BOOST_CHECK(slab_allocator::is_small(129));
+  BOOST_CHECK(slab_allocator::is_small(2048));
+  BOOST_CHECK(!slab_allocator::is_small(2049));
+
+  // Objects of a size class are carved from slabs back to back, so the
+  // closest ones are exactly one object size apart.
+  const std::vector<std::pair<std::size_t, std::size_t>> object_sizes{
+      {1, 16}, {16, 16}, {17, 32}, {128, 128}, {129, 160}, {2047, 2048}, {2048, 2048}};
+  for(auto [size, object_size] : object_sizes) {
+    std::vector<void*> objects;
+    for(int i = 0; i < 64; ++i) {
+      void* ptr = allocator.allocate(size);
+      BOOST_TEST_REQUIRE(ptr);
+      BOOST_CHECK(provider.is_in_buffer(ptr, size));
+      std::memset(ptr, i, size);
+      objects.push_back(ptr);
+    }
+    BOOST_CHECK_EQUAL(get_min_distance(objects), object_size);
+
+    // Objects must not overlap
+    for(int i = 0; i < 64; ++i)
+      for(std::size_t j = 0; j < size; ++j)
+        BOOST_REQUIRE_EQUAL(static_cast<unsigned char *>(objects[i])[j], i);
+
+    for(void* ptr : objects)
+      allocator.deallocate(ptr, size);
+  }
+
+  // 128 and 129 bytes are in different classes, and hence different slabs.
+  void* a = allocator.allocate(128);
+  void* b = allocator.allocate(129);
+  BOOST_CHECK_NE(provider.get_slab_index(a), provider.get_slab_index(b));
+  allocator.deallocate(a, 128);
+  allocator.deallocate(b, 129);
+}
+
+BOOST_AUTO_TEST_CASE(cross_thread_free) {
+  constexpr std::size_t size = 96;
+  constexpr std::size_t num_objects = 4096;
+
+  std::vector<void*> objects(num_objects);
+  std::thread producer{[&]() {
+    for(auto& ptr : objects)
+      ptr = allocator.allocate(size);
+  }};
+  producer.join();
+  for(void* ptr : objects)
+    BOOST_TEST_REQUIRE(ptr);
+  BOOST_CHECK_EQUAL(std::set<void*>(objects.begin(), objects.end()).size(),
+                    num_objects);
+
+  std::thread consumer{[&]() {
+    for(void* ptr : objects)
+      allocator.deallocate(ptr, size);
+  }};
+  consumer.join();
+
+  // All objects have been returned by now, so they can be reused
+  // without new slabs.
+  std::size_t num_claimed_slabs = provider.num_claimed_slabs.load();
+  std::set<void*> reallocated;
+  for(std::size_t i = 0; i < num_objects; ++i)
+    reallocated.insert(allocator.allocate(size));
+  BOOST_CHECK_EQUAL(provider.num_claimed_slabs.load(), num_claimed_slabs);
+  BOOST_CHECK(reallocated == std::set<void*>(objects.begin(), objects.end()));
+
+  for(void* ptr : reallocated)
+    allocator.deallocate(ptr, size);
+}
+
+BOOST_AUTO_TEST_CASE(thread_exit_flushes_cache) {
+  constexpr std::size_t size = 48;
+
+  // Few enough that they all remain in the thread cache until it exits
+  std::vector<void*> objects(4);
+  std::thread worker{[&]() {
+    for(auto& ptr : objects)
+      ptr = allocator.allocate(size);
+    for(void* ptr : objects)
+      allocator.deallocate(ptr, size);
+  }};
+  worker.join();
+
+  // Only reachable if the exiting thread has returned its cache, since
+  // the remainder of the slab is handed out in address order.
+  std::set<void*> reallocated;
+  for(std::size_t i = 0; i < slab_allocator::slab_size / 64; ++i)
+    reallocated.insert(allocator.allocate(size));
+  for(void* ptr : objects)
+    BOOST_CHECK(reallocated.count(ptr) == 1);
+
+  for(void* ptr : reallocated)
+    allocator.deallocate(ptr, size);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_allocation) {
+  constexpr std::size_t num_threads = 8;
+  constexpr std::size_t num_iterations = 1000;
+
+  std::vector<std::thread> threads;
+  std::atomic<std::size_t> num_errors = 0;
+  for(std::size_t t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<std::pair<unsigned char *, std::size_t>> live;
+      for(std::size_t i = 0; i < num_iterations; ++i) {
+        std::size_t size = 1 + (i * 37 + t * 101) % slab_allocator::max_object_size;
+        auto* ptr = static_cast<unsigned char*>(allocator.allocate(size));
+        if(!ptr) {
+          ++num_errors;
+          continue;
+        }
+        std::memset(ptr, static_cast<int>(t), size);
+        live.emplace_back(ptr, size);
+        if(i % 3 == 0) {
+          auto [p, s] = live[live.size() / 2];
+          live.erase(live.begin() + live.size() / 2);
+          for(std::size_t j = 0; j < s; ++j)
+            if(p[j] != t)
+              ++num_errors;
+          allocator.deallocate(p, s);
+        }
+      }
+      for(auto [p, s] : live)
+        allocator.deallocate(p, s);
+    });
+  }
+  for(auto& t : threads)
+    t.join();
+  BOOST_CHECK_EQUAL(num_errors.load(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,7 @@
 
 #include "sycl_test_suite.hpp"
 #include <boost/test/tools/old/interface.hpp>
+#include <thread>
 #ifdef LIB_NUMA_AVAILABLE
 #include <numa.h>
 #endif
@@ -1325,6 +1326,95 @@ BOOST_AUTO_TEST_CASE(target_numa_node_property) {
   sycl::free(ptr_numa_99, q);
 #endif
 
+}
+#endif
+#ifdef ACPP_EXT_RECORDED_GRAPHS
+BOOST_AUTO_TEST_CASE(recorded_graphs) {
+  sycl::queue out_of_order_q;
+  sycl::queue in_order_q{sycl::property::queue::in_order{}};
+
+  auto test = [](sycl::queue& q){
+    constexpr std::size_t size = 1024;
+    int* data = sycl::malloc_shared<int>(size, q);
+    int* sum = sycl::malloc_shared<int>(1, q);
+    for(std::size_t i = 0; i < size; ++i)
+      data[i] = 0;
+
+    q.AdaptiveCpp_begin_recording();
+    auto e1 = q.parallel_for(sycl::range{size}, [=](sycl::id<1> idx){
+      data[idx] += 1;
+    });
+    auto e2 = q.parallel_for(sycl::range{size}, e1, [=](sycl::id<1> idx){
+      data[idx] *= 2;
+    });
+    q.single_task(e2, [=](){
+      int s = 0;
+      for(std::size_t i = 0; i < size; ++i)
+        s += data[i];
+      *sum = s;
+    });
+    sycl::AdaptiveCpp_recorded_graph graph = q.AdaptiveCpp_end_recording();
+    q.wait();
+
+    BOOST_CHECK(graph.size() == 3);
+    BOOST_CHECK(*sum == 2 * size);
+
+    // data[i] = 2 after recording; each replay computes (data[i] + 1) * 2
+    int expected = 2;
+    sycl::event evt;
+    for(int i = 0; i < 5; ++i) {
+      evt = q.AdaptiveCpp_replay(graph, {evt});
+      expected = (expected + 1) * 2;
+    }
+    evt.wait();
+    BOOST_CHECK(*sum == expected * static_cast<int>(size));
+
+    // Replace the first kernel to change its arguments
+    int increment = 3;
+    q.AdaptiveCpp_update_recorded_operation(graph, 0, [&](sycl::handler &cgh) {
+      cgh.parallel_for(sycl::range{size}, [=](sycl::id<1> idx) {
+        data[idx] += increment;
+      });
+    });
+    q.AdaptiveCpp_replay(graph).wait();
+    expected = (expected + increment) * 2;
+    BOOST_CHECK(*sum == expected * static_cast<int>(size));
+
+    sycl::free(data, q);
+    sycl::free(sum, q);
+  };
+
+  test(out_of_order_q);
+  test(in_order_q);
+}
+
+BOOST_AUTO_TEST_CASE(recorded_graph_update_during_replay) {
+  sycl::queue q{sycl::property::queue::in_order{}};
+  int* value = sycl::malloc_shared<int>(1, q);
+  *value = 0;
+
+  q.AdaptiveCpp_begin_recording();
+  q.single_task([=](){ *value += 1; });
+  sycl::AdaptiveCpp_recorded_graph graph = q.AdaptiveCpp_end_recording();
+  q.wait();
+
+  // Every version of the operation increments by one, so the result
+  // does not depend on which version each replay has picked up.
+  constexpr int num_replays = 100;
+  std::thread replayer{[&](){
+    for(int i = 0; i < num_replays; ++i)
+      q.AdaptiveCpp_replay(graph);
+  }};
+  for(int i = 0; i < num_replays; ++i) {
+    q.AdaptiveCpp_update_recorded_operation(graph, 0, [&](sycl::handler &cgh) {
+      cgh.single_task([=](){ *value += 1; });
+    });
+  }
+  replayer.join();
+  q.wait();
+  BOOST_CHECK_EQUAL(*value, 1 + num_replays);
+
+  sycl::free(value, q);
 }
 #endif
 #ifdef SYCL_KHR_DEFAULT_CONTEXT
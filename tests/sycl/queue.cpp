@@ -11,6 +11,7 @@
 
 #include <numeric>
 #include <type_traits>
+#include <vector>
 
 #include "sycl_test_suite.hpp"
 
@@ -47,4 +48,34 @@ BOOST_AUTO_TEST_CASE(queue_memcpy_host_to_host) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(queue_does_not_start_unused_backends) {
+  namespace rt = hipsycl::rt;
+  rt::runtime_keep_alive_token requires_runtime;
+  rt::backend_manager &backends = requires_runtime.get()->backends();
+
+  // Backends that cannot provide CPU devices
+  const rt::backend_id gpu_backends[] = {
+      rt::backend_id::cuda, rt::backend_id::hip, rt::backend_id::level_zero,
+      rt::backend_id::metal};
+  // Other tests might have left backends running
+  std::vector<rt::backend_id> not_started;
+  for(rt::backend_id b : gpu_backends)
+    if(!backends.is_created(b))
+      not_started.push_back(b);
+
+  {
+    sycl::queue q{sycl::cpu_selector_v};
+    int *ptr = sycl::malloc_shared<int>(1, q);
+    q.single_task([=]() { *ptr = 42; }).wait();
+    BOOST_CHECK_EQUAL(*ptr, 42);
+    sycl::free(ptr, q);
+
+    BOOST_CHECK(!sycl::device::get_devices(sycl::info::device_type::cpu)
+                     .empty());
+  }
+
+  for(rt::backend_id b : not_started)
+    BOOST_CHECK(!backends.is_created(b));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
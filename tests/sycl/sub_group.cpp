@@ -160,5 +160,101 @@ BOOST_AUTO_TEST_CASE(sub_group) {
 }
 
 
+// Exercises sub-group collectives across the whole sub-group. On the host
+// device, run with ACPP_JITOPT_HOST_SIMD_SUBGROUPS=1 to cover SIMD
+// sub-groups, in which case work items of a sub-group exchange data.
+BOOST_AUTO_TEST_CASE(sub_group_collectives) {
+  namespace s = sycl;
+  s::queue q;
+
+  const size_t global_size = 1024;
+  const size_t local_size = 128;
+
+  auto *sizes = s::malloc_shared<uint32_t>(global_size, q);
+  auto *sums = s::malloc_shared<uint32_t>(global_size, q);
+  auto *shuffled = s::malloc_shared<uint32_t>(global_size, q);
+
+  q.parallel_for(s::nd_range<1>{global_size, local_size},
+                 [=](s::nd_item<1> idx) {
+    s::sub_group sgrp = idx.get_sub_group();
+    const size_t gid = idx.get_global_linear_id();
+    const uint32_t x = static_cast<uint32_t>(gid);
+    const uint32_t sg_size = sgrp.get_local_linear_range();
+
+    sizes[gid] = sg_size;
+    sums[gid] = s::reduce_over_group(sgrp, x, s::plus<uint32_t>{});
+    shuffled[gid] = s::select_from_group(
+        sgrp, x, (sgrp.get_local_linear_id() + 1) % sg_size);
+  }).wait();
+
+  const std::vector<size_t> supported_subgroup_sizes =
+      q.get_device().get_info<s::info::device::sub_group_sizes>();
+
+  for (size_t i = 0; i < global_size; ++i) {
+    BOOST_TEST_INFO("i: " << i);
+    const size_t sg_size = sizes[i];
+    BOOST_TEST_REQUIRE(sg_size >= 1);
+    BOOST_CHECK(std::find(supported_subgroup_sizes.begin(),
+                          supported_subgroup_sizes.end(),
+                          sg_size) != supported_subgroup_sizes.end());
+
+    const size_t sg_begin = i - (i % local_size) % sg_size;
+    uint32_t expected_sum = 0;
+    for (size_t j = sg_begin; j < sg_begin + sg_size; ++j)
+      expected_sum += static_cast<uint32_t>(j);
+
+    BOOST_CHECK_EQUAL(sums[i], expected_sum);
+    BOOST_CHECK_EQUAL(shuffled[i], sg_begin + (i - sg_begin + 1) % sg_size);
+  }
+
+  s::free(sizes, q);
+  s::free(sums, q);
+  s::free(shuffled, q);
+}
+
+// Sub-group collectives that only some sub-groups of the work-group reach.
+// This is valid SYCL, but SIMD sub-groups on the host device synchronize the
+// whole work-group, so such kernels must be rejected there instead of hanging
+// or computing wrong results.
+BOOST_AUTO_TEST_CASE(sub_group_collectives_in_divergent_control_flow) {
+  namespace s = sycl;
+  std::size_t num_errors = 0;
+  s::queue q{[&](s::exception_list errors) {
+    num_errors += errors.size();
+  }};
+
+  const size_t global_size = 1024;
+  const size_t local_size = 128;
+  // A multiple of all sub-group sizes, so that control flow is uniform
+  // within each sub-group.
+  const size_t active_size = 64;
+
+  auto *sizes = s::malloc_shared<uint32_t>(global_size, q);
+  auto *sums = s::malloc_shared<uint32_t>(global_size, q);
+  for (size_t i = 0; i < global_size; ++i)
+    sums[i] = 0;
+
+  q.parallel_for(s::nd_range<1>{global_size, local_size},
+                 [=](s::nd_item<1> idx) {
+    s::sub_group sgrp = idx.get_sub_group();
+    const size_t gid = idx.get_global_linear_id();
+    sizes[gid] = sgrp.get_local_linear_range();
+    if (idx.get_local_linear_id() < active_size)
+      sums[gid] = s::reduce_over_group(sgrp, 1u, s::plus<uint32_t>{});
+  });
+  q.wait_and_throw();
+
+  if (num_errors > 0) {
+    BOOST_CHECK(q.get_device().is_cpu());
+  } else {
+    for (size_t i = 0; i < global_size; ++i) {
+      BOOST_TEST_INFO("i: " << i);
+      BOOST_CHECK_EQUAL(sums[i], i % local_size < active_size ? sizes[i] : 0);
+    }
+  }
+
+  s::free(sizes, q);
+  s::free(sums, q);
+}
 
 BOOST_AUTO_TEST_SUITE_END()